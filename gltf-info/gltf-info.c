@@ -21,30 +21,428 @@
  *
  */
 
+#include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #define LOG_TAG "gltf"
+#include "libcc/cc_list.h"
 #include "libcc/cc_log.h"
+#include "libcc/cc_memory.h"
 #include "libgltf/gltf.h"
+#include "libgltf/gltf_batch.h"
+#include "libgltf/gltf_bvh.h"
+
+static double gltf_info_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return 1000000.0*((double) ts.tv_sec) +
+	       ((double) ts.tv_nsec)/1000.0;
+}
+
+static char* gltf_info_synthesize(uint32_t count, size_t* _size)
+{
+	ASSERT(_size);
+
+	// JSON chunk with count accessors sharing one bufferView
+	size_t json_max = 256 + 96*((size_t) count);
+	char*  json     = (char*) CALLOC(1, json_max);
+	if(json == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	size_t len;
+	len = snprintf(json, json_max, "%s",
+	               "{\"asset\":{\"version\":\"2.0\"},"
+	               "\"buffers\":[{\"byteLength\":12}],"
+	               "\"bufferViews\":[{\"buffer\":0,"
+	               "\"byteLength\":12}],"
+	               "\"accessors\":[");
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		len += snprintf(&json[len], json_max - len,
+		                "%s{\"bufferView\":0,\"componentType\":5126,"
+		                "\"count\":1,\"type\":\"VEC3\"}",
+		                i ? "," : "");
+	}
+	len += snprintf(&json[len], json_max - len, "]}");
+
+	// pad JSON chunk to 4 bytes with spaces
+	while(len%4)
+	{
+		json[len++] = ' ';
+	}
+
+	uint32_t bin_len = 12;
+	size_t   size    = 12 + 8 + len + 8 + bin_len;
+	char*    data    = (char*) CALLOC(1, size);
+	if(data == NULL)
+	{
+		LOGE("CALLOC failed");
+		FREE(json);
+		return NULL;
+	}
+
+	uint32_t header[3] = { 0x46546C67, 2, (uint32_t) size };
+	uint32_t chunk0[2] = { (uint32_t) len, 0x4E4F534A };
+	uint32_t chunk1[2] = { bin_len, 0x004E4942 };
+	memcpy(data, header, 12);
+	memcpy(&data[12], chunk0, 8);
+	memcpy(&data[20], json, len);
+	memcpy(&data[20 + len], chunk1, 8);
+	FREE(json);
+
+	*_size = size;
+	return data;
+}
+
+static void gltf_info_discard(cc_list_t* list)
+{
+	ASSERT(list);
+
+	cc_listIter_t* iter = cc_list_head(list);
+	while(iter)
+	{
+		cc_list_remove(list, &iter);
+	}
+}
+
+static int gltf_info_benchLookup(uint32_t count)
+{
+	size_t size = 0;
+	char*  data = gltf_info_synthesize(count, &size);
+	if(data == NULL)
+	{
+		return EXIT_FAILURE;
+	}
+
+	gltf_file_t* file;
+	file = gltf_file_openb(data, size, GLTF_FILEMODE_OWNED);
+	if(file == NULL)
+	{
+		FREE(data);
+		return EXIT_FAILURE;
+	}
+
+	// emulate the previous cc_list storage for comparison
+	cc_list_t* list = cc_list_new();
+	if(list == NULL)
+	{
+		goto fail_list;
+	}
+
+	uint32_t i;
+	for(i = 0; i < file->accessor_count; ++i)
+	{
+		if(cc_list_append(list, NULL,
+		                  gltf_file_getAccessor(file, i)) == NULL)
+		{
+			goto fail_append;
+		}
+	}
+
+	// the list lookup is quadratic so sample a subset of
+	// indices spread across the full range
+	uint32_t samples = 1000;
+	if(samples > count)
+	{
+		samples = count;
+	}
+
+	uint32_t sum = 0;
+	double   t0  = gltf_info_usec();
+	for(i = 0; i < samples; ++i)
+	{
+		uint32_t       idx  = (uint32_t) (((uint64_t) i)*count/samples);
+		cc_listIter_t* iter = cc_list_get(list, (int) idx);
+		gltf_accessor_t* accessor;
+		accessor = (gltf_accessor_t*) cc_list_peekIter(iter);
+		sum += accessor->count;
+	}
+	double t1 = gltf_info_usec();
+	for(i = 0; i < count; ++i)
+	{
+		gltf_accessor_t* accessor;
+		accessor = gltf_file_getAccessor(file, i);
+		sum += accessor->count;
+	}
+	double t2 = gltf_info_usec();
+
+	double list_ns  = 1000.0*(t1 - t0)/((double) samples);
+	double array_ns = 1000.0*(t2 - t1)/((double) count);
+	LOGI("accessors=%u, sum=%u", count, sum);
+	LOGI("list:  %0.1f ns/lookup (%u samples)", list_ns, samples);
+	LOGI("array: %0.1f ns/lookup", array_ns);
+	if(array_ns > 0.0)
+	{
+		LOGI("speedup: %0.1fx", list_ns/array_ns);
+	}
+
+	gltf_info_discard(list);
+	cc_list_delete(&list);
+	gltf_file_close(&file);
+
+	// success
+	return EXIT_SUCCESS;
+
+	// failure
+	fail_append:
+		gltf_info_discard(list);
+		cc_list_delete(&list);
+	fail_list:
+		gltf_file_close(&file);
+	return EXIT_FAILURE;
+}
+
+typedef struct
+{
+	pthread_mutex_t mutex;
+	uint32_t        failures;
+	uint64_t        bytes;
+} gltf_info_batch_t;
+
+static void
+gltf_info_batchFn(void* priv, uint32_t idx,
+                  const char* fname, gltf_batchStatus_e status,
+                  gltf_file_t* file)
+{
+	ASSERT(priv);
+	ASSERT(fname);
+
+	gltf_info_batch_t* batch = (gltf_info_batch_t*) priv;
+
+	pthread_mutex_lock(&batch->mutex);
+	if(file)
+	{
+		batch->bytes += (uint64_t) file->length;
+	}
+	else
+	{
+		LOGE("FAILURE idx=%u, fname=%s, status=%u",
+		     idx, fname, (uint32_t) status);
+		++batch->failures;
+	}
+	pthread_mutex_unlock(&batch->mutex);
+
+	gltf_file_close(&file);
+}
+
+static void
+gltf_info_throughput(const char* name, uint32_t count,
+                     uint64_t bytes, double t0, double t1)
+{
+	double sec = (t1 - t0)/1000000.0;
+	if(sec <= 0.0)
+	{
+		return;
+	}
+
+	LOGI("%s: files=%u, %0.1f files/sec, %0.1f MB/sec",
+	     name, count, ((double) count)/sec,
+	     ((double) bytes)/(1024.0*1024.0*sec));
+}
+
+static int
+gltf_info_benchBatch(uint32_t threads, size_t max_mb,
+                     uint32_t count, const char** fnames)
+{
+	ASSERT(fnames);
+
+	// sequential baseline
+	uint64_t bytes = 0;
+	double   t0    = gltf_info_usec();
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		gltf_file_t* file = gltf_file_open(fnames[i]);
+		if(file)
+		{
+			bytes += (uint64_t) file->length;
+			gltf_file_close(&file);
+		}
+	}
+	double t1 = gltf_info_usec();
+	gltf_info_throughput("sequential", count, bytes, t0, t1);
+
+	gltf_batch_t* pool;
+	pool = gltf_batch_new(threads, max_mb*1024*1024);
+	if(pool == NULL)
+	{
+		return EXIT_FAILURE;
+	}
+
+	gltf_info_batch_t batch =
+	{
+		.failures = 0,
+		.bytes    = 0,
+	};
+	pthread_mutex_init(&batch.mutex, NULL);
+
+	double t2 = gltf_info_usec();
+	gltf_batch_load(pool, count, fnames, &batch,
+	                gltf_info_batchFn);
+	double t3 = gltf_info_usec();
+	LOGI("threads=%u, max_mb=%u, failures=%u",
+	     pool->thread_count, (uint32_t) max_mb, batch.failures);
+	gltf_info_throughput("batch", count, batch.bytes, t2, t3);
+
+	pthread_mutex_destroy(&batch.mutex);
+	gltf_batch_delete(&pool);
+
+	return batch.failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+typedef struct
+{
+	float origin[3];
+	float dir[3];
+	int   hit;
+} gltf_info_ray_t;
+
+static int gltf_info_checkRays(void)
+{
+	// axis aligned rays have an infinite reciprocal direction
+	// so rays along the faces and edges of the box must not
+	// be lost to 0*inf in the slab test
+	gltf_info_ray_t rays[] =
+	{
+		{ { 0.0f,  0.5f, -1.0f }, { 0.0f,  0.0f,  1.0f }, 1 },
+		{ { 1.0f,  0.5f,  2.0f }, { 0.0f,  0.0f, -1.0f }, 1 },
+		{ { 0.5f,  1.0f, -1.0f }, { 0.0f,  0.0f,  1.0f }, 1 },
+		{ { 0.5f, -1.0f,  0.0f }, { 0.0f,  1.0f,  0.0f }, 1 },
+		{ { -1.0f, 0.0f,  1.0f }, { 1.0f,  0.0f,  0.0f }, 1 },
+		{ { 0.0f,  0.0f, -1.0f }, { 0.0f,  0.0f,  1.0f }, 1 },
+		{ { 0.5f,  0.5f,  0.5f }, { 1.0f,  0.0f,  0.0f }, 1 },
+		{ { -0.1f, 0.5f, -1.0f }, { 0.0f,  0.0f,  1.0f }, 0 },
+		{ { 0.5f,  1.1f, -1.0f }, { 0.0f,  0.0f,  1.0f }, 0 },
+		{ { 0.0f,  0.5f,  2.0f }, { 0.0f,  0.0f,  1.0f }, 0 },
+	};
+
+	gltf_bvhBox_t box =
+	{
+		.min = { .x = 0.0f, .y = 0.0f, .z = 0.0f },
+		.max = { .x = 1.0f, .y = 1.0f, .z = 1.0f },
+	};
+
+	uint32_t count    = sizeof(rays)/sizeof(gltf_info_ray_t);
+	uint32_t failures = 0;
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		gltf_info_ray_t* ray = &rays[i];
+
+		float inv[3] =
+		{
+			1.0f/ray->dir[0],
+			1.0f/ray->dir[1],
+			1.0f/ray->dir[2],
+		};
+
+		float t;
+		int   hit;
+		hit = gltf_bvhBox_intersectRay(&box, ray->origin, inv,
+		                               10.0f, &t);
+		if(hit != ray->hit)
+		{
+			LOGE("FAILURE ray=%u, hit=%i", i, hit);
+			++failures;
+		}
+	}
+
+	LOGI("rays=%u, failures=%u", count, failures);
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
 
 int main(int argc, char** argv)
 {
-	if(argc != 2)
+	if((argc == 3) && (strcmp(argv[1], "-bench-lookup") == 0))
+	{
+		return gltf_info_benchLookup((uint32_t)
+		                             strtol(argv[2], NULL, 0));
+	}
+	else if((argc == 2) && (strcmp(argv[1], "-check-rays") == 0))
+	{
+		return gltf_info_checkRays();
+	}
+	else if((argc >= 5) && (strcmp(argv[1], "-bench-batch") == 0))
+	{
+		uint32_t threads = (uint32_t) strtol(argv[2], NULL, 0);
+		size_t   max_mb  = (size_t) strtol(argv[3], NULL, 0);
+		return gltf_info_benchBatch(threads, max_mb,
+		                            (uint32_t) (argc - 4),
+		                            (const char**) &argv[4]);
+	}
+
+	int         lazy    = 0;
+	uint32_t    threads = 1;
+	const char* fname   = argv[1];
+	if((argc == 3) && (strcmp(argv[1], "-lazy") == 0))
+	{
+		lazy  = 1;
+		fname = argv[2];
+	}
+	else if((argc == 4) && (strcmp(argv[1], "-threads") == 0))
+	{
+		threads = (uint32_t) strtol(argv[2], NULL, 0);
+		fname   = argv[3];
+	}
+	else if(argc != 2)
 	{
 		LOGE("usage: %s [fname]", argv[0]);
+		LOGE("usage: %s -lazy [fname]", argv[0]);
+		LOGE("usage: %s -threads [count] [fname]", argv[0]);
+		LOGE("usage: %s -bench-lookup [count]", argv[0]);
+		LOGE("usage: %s -check-rays", argv[0]);
+		LOGE("usage: %s -bench-batch [threads] [max_mb] [fnames...]",
+		     argv[0]);
 		return EXIT_FAILURE;
 	}
 
+	double t0 = gltf_info_usec();
+
 	gltf_file_t* file;
-	file = gltf_file_open(argv[1]);
+	if(lazy)
+	{
+		file = gltf_file_openLazy(fname);
+	}
+	else if(threads != 1)
+	{
+		file = gltf_file_openParallel(fname, threads);
+	}
+	else
+	{
+		file = gltf_file_open(fname);
+	}
+
 	if(file == NULL)
 	{
 		LOGE("FAILURE");
 		return EXIT_FAILURE;
 	}
 
+	double t1 = gltf_info_usec();
+
+	gltf_arena_t* arena = file->arena;
+	LOGI("nodes=%u, meshes=%u, accessors=%u",
+	     file->node_count, file->mesh_count,
+	     file->accessor_count);
+	LOGI("arena: allocs=%u, blocks=%u, size=%" PRIu64,
+	     arena->alloc_count, arena->block_count,
+	     (uint64_t) arena->alloc_size);
+
 	gltf_file_close(&file);
 
+	double t2 = gltf_info_usec();
+	LOGI("open=%0.3f ms, close=%0.3f ms",
+	     (t1 - t0)/1000.0, (t2 - t1)/1000.0);
+
 	LOGI("SUCCESS");
 	return EXIT_SUCCESS;
 }
@@ -1,3 +1,2 @@
-ln -s ../../jsmn
 ln -s ../../libcc
 ln -s ../../libgltf
@@ -21,9 +21,15 @@
  *
  */
 
+#include <ctype.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #ifdef GLTF_DEBUG
 	#define LOG_DEBUG
@@ -31,8 +37,8 @@
 #define LOG_TAG "gltf"
 #include "../libcc/cc_log.h"
 #include "../libcc/cc_memory.h"
-#include "../libcc/jsmn/cc_jsmnWrapper.h"
 #include "gltf.h"
+#include "gltf_base64.h"
 
 typedef struct
 {
@@ -53,2533 +59,5900 @@ typedef struct
 	uint32_t chunkType;
 } gltf_chunk_t;
 
+// arena block size limits for parsed objects
+#define GLTF_FILE_ARENA_BLOCK_MIN (64*1024)
+#define GLTF_FILE_ARENA_BLOCK_MAX (4*1024*1024)
+
 /***********************************************************
-* private - objects                                        *
+* private - tokenizer                                      *
 ***********************************************************/
 
-static uint32_t gltf_val_uint32(cc_jsmnVal_t* val)
+// maximum nesting depth of JSON objects/arrays
+#define GLTF_TOKENIZER_DEPTH 64
+
+typedef enum
 {
-	ASSERT(val);
+	GLTF_TOKEN_TYPE_OBJECT,
+	GLTF_TOKEN_TYPE_ARRAY,
+	GLTF_TOKEN_TYPE_STRING,
+	GLTF_TOKEN_TYPE_PRIMITIVE,
+} gltf_tokenType_e;
+
+// tokens follow the jsmn conventions where the size of an
+// object is the number of keys, the size of an array is
+// the number of elements and the size of a key is one
+typedef struct
+{
+	gltf_tokenType_e type;
+	uint32_t         start;
+	uint32_t         end;
+	uint32_t         size;
+} gltf_token_t;
+
+static gltf_token_t*
+gltf_tokenizer_add(gltf_token_t** _tokens, uint32_t* _count,
+                   uint32_t* _max, gltf_tokenType_e type,
+                   uint32_t start)
+{
+	ASSERT(_tokens);
+	ASSERT(_count);
+	ASSERT(_max);
 
-	uint32_t x = 0;
-	if((val->type == CC_JSMN_TYPE_STRING) ||
-	   (val->type == CC_JSMN_TYPE_PRIMITIVE))
+	if(*_count >= *_max)
 	{
-		x = (uint32_t) strtol(val->data, NULL, 0);
+		uint32_t      max = 2*(*_max);
+		gltf_token_t* tokens;
+		tokens = (gltf_token_t*)
+		         REALLOC(*_tokens, max*sizeof(gltf_token_t));
+		if(tokens == NULL)
+		{
+			LOGE("REALLOC failed");
+			return NULL;
+		}
+
+		*_tokens = tokens;
+		*_max    = max;
 	}
-	else
+
+	gltf_token_t* tok = &(*_tokens)[*_count];
+	tok->type  = type;
+	tok->start = start;
+	tok->end   = start;
+	tok->size  = 0;
+	++(*_count);
+
+	return tok;
+}
+
+static gltf_token_t*
+gltf_tokenizer_run(const char* json, size_t length,
+                   uint32_t* _count)
+{
+	ASSERT(json);
+	ASSERT(_count);
+
+	// tokenize the JSON in a single linear pass which
+	// tracks the open objects/arrays with a stack rather
+	// than searching backwards for the parent token
+
+	// estimate the token count from the length
+	uint32_t max = (uint32_t) (length/8) + 16;
+
+	gltf_token_t* tokens;
+	tokens = (gltf_token_t*) MALLOC(max*sizeof(gltf_token_t));
+	if(tokens == NULL)
+	{
+		LOGE("MALLOC failed");
+		return NULL;
+	}
+
+	uint32_t stack[GLTF_TOKENIZER_DEPTH];
+	uint32_t depth = 0;
+	uint32_t count = 0;
+	int64_t  super = -1;
+
+	gltf_token_t* tok;
+	size_t        pos = 0;
+	while(pos < length)
+	{
+		char c = json[pos];
+		if((c == '{') || (c == '['))
+		{
+			if(depth >= GLTF_TOKENIZER_DEPTH)
+			{
+				LOGE("invalid depth=%u", depth);
+				goto fail_parse;
+			}
+
+			if(super >= 0)
+			{
+				++tokens[super].size;
+			}
+
+			tok = gltf_tokenizer_add(&tokens, &count, &max,
+			                         (c == '{') ?
+			                         GLTF_TOKEN_TYPE_OBJECT :
+			                         GLTF_TOKEN_TYPE_ARRAY,
+			                         (uint32_t) pos);
+			if(tok == NULL)
+			{
+				goto fail_parse;
+			}
+
+			stack[depth] = count - 1;
+			super        = count - 1;
+			++depth;
+			++pos;
+		}
+		else if((c == '}') || (c == ']'))
+		{
+			gltf_tokenType_e type;
+			type = (c == '}') ? GLTF_TOKEN_TYPE_OBJECT :
+			                    GLTF_TOKEN_TYPE_ARRAY;
+			if((depth == 0) ||
+			   (tokens[stack[depth - 1]].type != type))
+			{
+				LOGE("invalid pos=%" PRIu64, (uint64_t) pos);
+				goto fail_parse;
+			}
+
+			--depth;
+			tokens[stack[depth]].end = (uint32_t) (pos + 1);
+			super = depth ? (int64_t) stack[depth - 1] : -1;
+			++pos;
+		}
+		else if(c == '"')
+		{
+			// find the closing quote and skip escapes
+			size_t start = pos + 1;
+			pos = start;
+			while((pos < length) && (json[pos] != '"'))
+			{
+				if(json[pos] == '\\')
+				{
+					++pos;
+				}
+				++pos;
+			}
+
+			if(pos >= length)
+			{
+				LOGE("invalid string");
+				goto fail_parse;
+			}
+
+			if(super >= 0)
+			{
+				++tokens[super].size;
+			}
+
+			tok = gltf_tokenizer_add(&tokens, &count, &max,
+			                         GLTF_TOKEN_TYPE_STRING,
+			                         (uint32_t) start);
+			if(tok == NULL)
+			{
+				goto fail_parse;
+			}
+			tok->end = (uint32_t) pos;
+			++pos;
+		}
+		else if(c == ':')
+		{
+			// the key receives the value
+			super = count - 1;
+			++pos;
+		}
+		else if(c == ',')
+		{
+			super = depth ? (int64_t) stack[depth - 1] : -1;
+			++pos;
+		}
+		else if((c == ' ')  || (c == '\t') ||
+		        (c == '\r') || (c == '\n'))
+		{
+			++pos;
+		}
+		else
+		{
+			// numbers, true, false and null
+			size_t start = pos;
+			while(pos < length)
+			{
+				c = json[pos];
+				if((c == ',')  || (c == ']')  || (c == '}')  ||
+				   (c == ':')  || (c == ' ')  || (c == '\t') ||
+				   (c == '\r') || (c == '\n'))
+				{
+					break;
+				}
+				++pos;
+			}
+
+			if(super >= 0)
+			{
+				++tokens[super].size;
+			}
+
+			tok = gltf_tokenizer_add(&tokens, &count, &max,
+			                         GLTF_TOKEN_TYPE_PRIMITIVE,
+			                         (uint32_t) start);
+			if(tok == NULL)
+			{
+				goto fail_parse;
+			}
+			tok->end = (uint32_t) pos;
+		}
+	}
+
+	if((depth != 0) || (count == 0))
 	{
-		LOGE("invalid type=%u", val->type);
+		LOGE("invalid depth=%u, count=%u", depth, count);
+		goto fail_parse;
 	}
 
-	return x;
+	*_count = count;
+
+	// success
+	return tokens;
+
+	// failure
+	fail_parse:
+		FREE(tokens);
+	return NULL;
 }
 
-static float gltf_val_float(cc_jsmnVal_t* val)
+/***********************************************************
+* private - parser                                         *
+***********************************************************/
+
+// the parser consumes the token stream in a single
+// pass where each parse function consumes exactly one
+// value (including all children) from the stream
+typedef struct
+{
+	const char*     json;
+	gltf_token_t*   tokens;
+	uint32_t        count;
+	uint32_t        idx;
+	gltf_strings_t* strings;
+	gltf_arena_t*   arena;
+
+	// shared pools are locked when elements are parsed by
+	// multiple threads (NULL for single threaded parsing)
+	pthread_mutex_t* strings_mutex;
+} gltf_parser_t;
+
+// reference to a string or primitive in the JSON chunk
+// which is not null terminated
+typedef struct
+{
+	const char* str;
+	uint32_t    len;
+} gltf_slice_t;
+
+static int
+gltf_slice_equals(gltf_slice_t* self, const char* str)
 {
-	ASSERT(val);
+	ASSERT(self);
+	ASSERT(str);
 
-	float x = 0;
-	if((val->type == CC_JSMN_TYPE_STRING) ||
-	   (val->type == CC_JSMN_TYPE_PRIMITIVE))
+	size_t len = strlen(str);
+	if((self->len == len) &&
+	   (memcmp(self->str, str, len) == 0))
 	{
-		x = (float) strtod(val->data, NULL);
+		return 1;
 	}
-	else
+
+	return 0;
+}
+
+static void gltf_mutex_lock(pthread_mutex_t* mutex)
+{
+	if(mutex)
 	{
-		LOGE("invalid type=%u", val->type);
+		pthread_mutex_lock(mutex);
 	}
+}
 
-	return x;
+static void gltf_mutex_unlock(pthread_mutex_t* mutex)
+{
+	if(mutex)
+	{
+		pthread_mutex_unlock(mutex);
+	}
 }
 
-static void
-gltf_val_string(cc_jsmnVal_t* val, char* str)
+static const char*
+gltf_parser_intern(gltf_parser_t* self,
+                   const char* str, uint32_t len)
 {
-	ASSERT(val);
+	ASSERT(self);
 	ASSERT(str);
 
-	if(val->type == CC_JSMN_TYPE_STRING)
+	gltf_mutex_lock(self->strings_mutex);
+	const char* s = gltf_strings_intern(self->strings, str, len);
+	gltf_mutex_unlock(self->strings_mutex);
+
+	return s;
+}
+
+static gltf_token_t* gltf_parser_next(gltf_parser_t* self)
+{
+	ASSERT(self);
+
+	if(self->idx >= self->count)
 	{
-		snprintf(str, 256, "%s", val->data);
+		LOGE("invalid idx=%u, count=%u", self->idx, self->count);
+		return NULL;
 	}
-	else
+
+	gltf_token_t* tok = &self->tokens[self->idx];
+	++self->idx;
+
+	return tok;
+}
+
+static void gltf_parser_skip(gltf_parser_t* self)
+{
+	ASSERT(self);
+
+	// object/array sizes count their direct children and
+	// keys have a size of one for their value
+	uint32_t pending = 1;
+	while(pending && (self->idx < self->count))
+	{
+		gltf_token_t* tok = &self->tokens[self->idx];
+		pending += tok->size;
+		--pending;
+		++self->idx;
+	}
+}
+
+static gltf_token_t*
+gltf_parser_begin(gltf_parser_t* self, gltf_tokenType_e type)
+{
+	ASSERT(self);
+
+	gltf_token_t* tok = gltf_parser_next(self);
+	if(tok == NULL)
+	{
+		return NULL;
+	}
+
+	if(tok->type != type)
+	{
+		LOGE("invalid type=%i", tok->type);
+
+		// skip the unexpected value
+		--self->idx;
+		gltf_parser_skip(self);
+		return NULL;
+	}
+
+	return tok;
+}
+
+static gltf_token_t* gltf_parser_beginObject(gltf_parser_t* self)
+{
+	ASSERT(self);
+
+	return gltf_parser_begin(self, GLTF_TOKEN_TYPE_OBJECT);
+}
+
+static gltf_token_t* gltf_parser_beginArray(gltf_parser_t* self)
+{
+	ASSERT(self);
+
+	return gltf_parser_begin(self, GLTF_TOKEN_TYPE_ARRAY);
+}
+
+static int
+gltf_parser_slice(gltf_parser_t* self, gltf_slice_t* slice)
+{
+	ASSERT(self);
+	ASSERT(slice);
+
+	gltf_token_t* tok = gltf_parser_next(self);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if((tok->type != GLTF_TOKEN_TYPE_STRING) &&
+	   (tok->type != GLTF_TOKEN_TYPE_PRIMITIVE))
+	{
+		LOGE("invalid type=%i", tok->type);
+
+		// skip the unexpected value
+		--self->idx;
+		gltf_parser_skip(self);
+		return 0;
+	}
+
+	slice->str = &self->json[tok->start];
+	slice->len = tok->end - tok->start;
+
+	return 1;
+}
+
+static int
+gltf_parser_key(gltf_parser_t* self, gltf_slice_t* key)
+{
+	ASSERT(self);
+	ASSERT(key);
+
+	gltf_token_t* tok = gltf_parser_next(self);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// the tokenizer accepts primitive keys
+	if((tok->type != GLTF_TOKEN_TYPE_STRING) &&
+	   (tok->type != GLTF_TOKEN_TYPE_PRIMITIVE))
+	{
+		LOGE("invalid type=%i", tok->type);
+		return 0;
+	}
+
+	key->str = &self->json[tok->start];
+	key->len = tok->end - tok->start;
+
+	return 1;
+}
+
+static void
+gltf_parser_unsupported(gltf_parser_t* self, gltf_slice_t* key)
+{
+	ASSERT(self);
+	ASSERT(key);
+
+	LOGD("unsupported key=%.*s", (int) key->len, key->str);
+	gltf_parser_skip(self);
+}
+
+static uint32_t gltf_parser_uint32(gltf_parser_t* self)
+{
+	ASSERT(self);
+
+	// numbers are terminated by the JSON syntax so they may
+	// be converted in place
+	gltf_slice_t slice;
+	if(gltf_parser_slice(self, &slice) == 0)
+	{
+		return 0;
+	}
+
+	return (uint32_t) strtol(slice.str, NULL, 0);
+}
+
+static float gltf_parser_float(gltf_parser_t* self)
+{
+	ASSERT(self);
+
+	gltf_slice_t slice;
+	if(gltf_parser_slice(self, &slice) == 0)
+	{
+		return 0.0f;
+	}
+
+	return (float) strtod(slice.str, NULL);
+}
+
+static int
+gltf_parser_string(gltf_parser_t* self, const char** _str)
+{
+	ASSERT(self);
+	ASSERT(_str);
+
+	const char* str = "";
+	uint32_t    len = 0;
+
+	gltf_token_t* tok = gltf_parser_begin(self, GLTF_TOKEN_TYPE_STRING);
+	if(tok)
+	{
+		str = &self->json[tok->start];
+		len = tok->end - tok->start;
+	}
+
+	*_str = gltf_parser_intern(self, str, len);
+	if(*_str == NULL)
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_parser_uri(gltf_parser_t* self, const char** _uri,
+                const char** _embedded,
+                uint32_t* _embedded_length)
+{
+	ASSERT(self);
+	ASSERT(_uri);
+	ASSERT(_embedded);
+	ASSERT(_embedded_length);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(self, &val) == 0)
+	{
+		return 0;
+	}
+
+	// data: URIs reference the JSON rather than being
+	// interned since embedded buffers may be very large
+	if((val.len >= 5) && (strncmp(val.str, "data:", 5) == 0))
 	{
-		LOGE("invalid type=%u", val->type);
-		snprintf(str, 256, "%s", "");
+		*_embedded        = val.str;
+		*_embedded_length = val.len;
+		return 1;
+	}
+
+	*_uri = gltf_parser_intern(self, val.str, val.len);
+	if(*_uri == NULL)
+	{
+		return 0;
 	}
+
+	return 1;
 }
 
 static int
-gltf_val_floats(cc_jsmnVal_t* val, uint32_t count,
-                float* x)
+gltf_parser_floats(gltf_parser_t* self, uint32_t count,
+                   float* x)
 {
-	ASSERT(val);
+	ASSERT(self);
 	ASSERT(count > 0);
 	ASSERT(x);
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	gltf_token_t* tok = gltf_parser_beginArray(self);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
 		return 0;
 	}
 
-	cc_jsmnArray_t* array = val->array;
-	if(cc_list_size(array->list) != count)
+	if(tok->size != count)
+	{
+		LOGE("invalid size=%u", tok->size);
+
+		// skip the array elements
+		--self->idx;
+		gltf_parser_skip(self);
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		x[i] = gltf_parser_float(self);
+	}
+
+	return 1;
+}
+
+static int
+gltf_parser_floatArray(gltf_parser_t* self, uint32_t* _count,
+                       float** _x)
+{
+	ASSERT(self);
+	ASSERT(_count);
+	ASSERT(_x);
+
+	gltf_token_t* tok = gltf_parser_beginArray(self);
+	if(tok == NULL)
 	{
-		LOGE("invalid size=%i", cc_list_size(array->list));
 		return 0;
 	}
 
-	int idx = 0;
-	cc_listIter_t* iter = cc_list_head(array->list);
-	while(iter)
+	if(*_x)
+	{
+		LOGE("invalid array");
+		return 0;
+	}
+
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	float* x = (float*) gltf_arena_alloc(self->arena,
+	                                     count*sizeof(float));
+	if(x == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		x[i] = gltf_parser_float(self);
+	}
+
+	*_count = count;
+	*_x     = x;
+
+	return 1;
+}
+
+static int
+gltf_parser_uint32Array(gltf_parser_t* self, uint32_t* _count,
+                        uint32_t** _x)
+{
+	ASSERT(self);
+	ASSERT(_count);
+	ASSERT(_x);
+
+	gltf_token_t* tok = gltf_parser_beginArray(self);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if(*_x)
+	{
+		LOGE("invalid array");
+		return 0;
+	}
+
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	uint32_t* x = (uint32_t*)
+	              gltf_arena_alloc(self->arena,
+	                               count*sizeof(uint32_t));
+	if(x == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		x[i] = gltf_parser_uint32(self);
+	}
+
+	*_count = count;
+	*_x     = x;
+
+	return 1;
+}
+
+/***********************************************************
+* private - keys                                           *
+***********************************************************/
+
+// vocabulary of object member keys which are recognized by
+// the parser
+typedef enum
+{
+	GLTF_KEY_UNKNOWN = 0,
+	GLTF_KEY_ACCESSORS,
+	GLTF_KEY_ALPHA_MODE,
+	GLTF_KEY_ANIMATIONS,
+	GLTF_KEY_ASPECT_RATIO,
+	GLTF_KEY_ATTRIBUTES,
+	GLTF_KEY_BASE_COLOR_FACTOR,
+	GLTF_KEY_BASE_COLOR_TEXTURE,
+	GLTF_KEY_BUFFER,
+	GLTF_KEY_BUFFER_VIEW,
+	GLTF_KEY_BUFFER_VIEWS,
+	GLTF_KEY_BUFFERS,
+	GLTF_KEY_BYTE_LENGTH,
+	GLTF_KEY_BYTE_OFFSET,
+	GLTF_KEY_BYTE_STRIDE,
+	GLTF_KEY_CAMERA,
+	GLTF_KEY_CAMERAS,
+	GLTF_KEY_CHANNELS,
+	GLTF_KEY_CHILDREN,
+	GLTF_KEY_COMPONENT_TYPE,
+	GLTF_KEY_COUNT,
+	GLTF_KEY_DOUBLE_SIDED,
+	GLTF_KEY_EMISSIVE_FACTOR,
+	GLTF_KEY_EMISSIVE_TEXTURE,
+	GLTF_KEY_IMAGES,
+	GLTF_KEY_INDEX,
+	GLTF_KEY_INDICES,
+	GLTF_KEY_INPUT,
+	GLTF_KEY_INTERPOLATION,
+	GLTF_KEY_INVERSE_BIND_MATRICES,
+	GLTF_KEY_JOINTS,
+	GLTF_KEY_MATERIAL,
+	GLTF_KEY_MATERIALS,
+	GLTF_KEY_MATRIX,
+	GLTF_KEY_MAX,
+	GLTF_KEY_MESH,
+	GLTF_KEY_MESHES,
+	GLTF_KEY_METALLIC_FACTOR,
+	GLTF_KEY_METALLIC_ROUGHNESS_TEXTURE,
+	GLTF_KEY_MIME_TYPE,
+	GLTF_KEY_MIN,
+	GLTF_KEY_MODE,
+	GLTF_KEY_NAME,
+	GLTF_KEY_NODE,
+	GLTF_KEY_NODES,
+	GLTF_KEY_NORMAL_TEXTURE,
+	GLTF_KEY_NORMALIZED,
+	GLTF_KEY_OCCLUSION_TEXTURE,
+	GLTF_KEY_ORTHOGRAPHIC,
+	GLTF_KEY_OUTPUT,
+	GLTF_KEY_PATH,
+	GLTF_KEY_PBR_METALLIC_ROUGHNESS,
+	GLTF_KEY_PERSPECTIVE,
+	GLTF_KEY_PRIMITIVES,
+	GLTF_KEY_ROTATION,
+	GLTF_KEY_ROUGHNESS_FACTOR,
+	GLTF_KEY_SAMPLER,
+	GLTF_KEY_SAMPLERS,
+	GLTF_KEY_SCALE,
+	GLTF_KEY_SCENE,
+	GLTF_KEY_SCENES,
+	GLTF_KEY_SKELETON,
+	GLTF_KEY_SKIN,
+	GLTF_KEY_SKINS,
+	GLTF_KEY_SOURCE,
+	GLTF_KEY_SPARSE,
+	GLTF_KEY_STRENGTH,
+	GLTF_KEY_TARGET,
+	GLTF_KEY_TARGETS,
+	GLTF_KEY_TEX_COORD,
+	GLTF_KEY_TEXTURES,
+	GLTF_KEY_TRANSLATION,
+	GLTF_KEY_TYPE,
+	GLTF_KEY_URI,
+	GLTF_KEY_VALUES,
+	GLTF_KEY_WEIGHTS,
+	GLTF_KEY_XMAG,
+	GLTF_KEY_YFOV,
+	GLTF_KEY_YMAG,
+	GLTF_KEY_ZFAR,
+	GLTF_KEY_ZNEAR,
+} gltf_key_e;
+
+static const char* GLTF_KEY_STRING[] =
+{
+	[GLTF_KEY_ACCESSORS]                  = "accessors",
+	[GLTF_KEY_ALPHA_MODE]                 = "alphaMode",
+	[GLTF_KEY_ANIMATIONS]                 = "animations",
+	[GLTF_KEY_ASPECT_RATIO]               = "aspectRatio",
+	[GLTF_KEY_ATTRIBUTES]                 = "attributes",
+	[GLTF_KEY_BASE_COLOR_FACTOR]          = "baseColorFactor",
+	[GLTF_KEY_BASE_COLOR_TEXTURE]         = "baseColorTexture",
+	[GLTF_KEY_BUFFER]                     = "buffer",
+	[GLTF_KEY_BUFFER_VIEW]                = "bufferView",
+	[GLTF_KEY_BUFFER_VIEWS]               = "bufferViews",
+	[GLTF_KEY_BUFFERS]                    = "buffers",
+	[GLTF_KEY_BYTE_LENGTH]                = "byteLength",
+	[GLTF_KEY_BYTE_OFFSET]                = "byteOffset",
+	[GLTF_KEY_BYTE_STRIDE]                = "byteStride",
+	[GLTF_KEY_CAMERA]                     = "camera",
+	[GLTF_KEY_CAMERAS]                    = "cameras",
+	[GLTF_KEY_CHANNELS]                   = "channels",
+	[GLTF_KEY_CHILDREN]                   = "children",
+	[GLTF_KEY_COMPONENT_TYPE]             = "componentType",
+	[GLTF_KEY_COUNT]                      = "count",
+	[GLTF_KEY_DOUBLE_SIDED]               = "doubleSided",
+	[GLTF_KEY_EMISSIVE_FACTOR]            = "emissiveFactor",
+	[GLTF_KEY_EMISSIVE_TEXTURE]           = "emissiveTexture",
+	[GLTF_KEY_IMAGES]                     = "images",
+	[GLTF_KEY_INDEX]                      = "index",
+	[GLTF_KEY_INDICES]                    = "indices",
+	[GLTF_KEY_INPUT]                      = "input",
+	[GLTF_KEY_INTERPOLATION]              = "interpolation",
+	[GLTF_KEY_INVERSE_BIND_MATRICES]      = "inverseBindMatrices",
+	[GLTF_KEY_JOINTS]                     = "joints",
+	[GLTF_KEY_MATERIAL]                   = "material",
+	[GLTF_KEY_MATERIALS]                  = "materials",
+	[GLTF_KEY_MATRIX]                     = "matrix",
+	[GLTF_KEY_MAX]                        = "max",
+	[GLTF_KEY_MESH]                       = "mesh",
+	[GLTF_KEY_MESHES]                     = "meshes",
+	[GLTF_KEY_METALLIC_FACTOR]            = "metallicFactor",
+	[GLTF_KEY_METALLIC_ROUGHNESS_TEXTURE] = "metallicRoughnessTexture",
+	[GLTF_KEY_MIME_TYPE]                  = "mimeType",
+	[GLTF_KEY_MIN]                        = "min",
+	[GLTF_KEY_MODE]                       = "mode",
+	[GLTF_KEY_NAME]                       = "name",
+	[GLTF_KEY_NODE]                       = "node",
+	[GLTF_KEY_NODES]                      = "nodes",
+	[GLTF_KEY_NORMAL_TEXTURE]             = "normalTexture",
+	[GLTF_KEY_NORMALIZED]                 = "normalized",
+	[GLTF_KEY_OCCLUSION_TEXTURE]          = "occlusionTexture",
+	[GLTF_KEY_ORTHOGRAPHIC]               = "orthographic",
+	[GLTF_KEY_OUTPUT]                     = "output",
+	[GLTF_KEY_PATH]                       = "path",
+	[GLTF_KEY_PBR_METALLIC_ROUGHNESS]     = "pbrMetallicRoughness",
+	[GLTF_KEY_PERSPECTIVE]                = "perspective",
+	[GLTF_KEY_PRIMITIVES]                 = "primitives",
+	[GLTF_KEY_ROTATION]                   = "rotation",
+	[GLTF_KEY_ROUGHNESS_FACTOR]           = "roughnessFactor",
+	[GLTF_KEY_SAMPLER]                    = "sampler",
+	[GLTF_KEY_SAMPLERS]                   = "samplers",
+	[GLTF_KEY_SCALE]                      = "scale",
+	[GLTF_KEY_SCENE]                      = "scene",
+	[GLTF_KEY_SCENES]                     = "scenes",
+	[GLTF_KEY_SKELETON]                   = "skeleton",
+	[GLTF_KEY_SKIN]                       = "skin",
+	[GLTF_KEY_SKINS]                      = "skins",
+	[GLTF_KEY_SOURCE]                     = "source",
+	[GLTF_KEY_SPARSE]                     = "sparse",
+	[GLTF_KEY_STRENGTH]                   = "strength",
+	[GLTF_KEY_TARGET]                     = "target",
+	[GLTF_KEY_TARGETS]                    = "targets",
+	[GLTF_KEY_TEX_COORD]                  = "texCoord",
+	[GLTF_KEY_TEXTURES]                   = "textures",
+	[GLTF_KEY_TRANSLATION]                = "translation",
+	[GLTF_KEY_TYPE]                       = "type",
+	[GLTF_KEY_URI]                        = "uri",
+	[GLTF_KEY_VALUES]                     = "values",
+	[GLTF_KEY_WEIGHTS]                    = "weights",
+	[GLTF_KEY_XMAG]                       = "xmag",
+	[GLTF_KEY_YFOV]                       = "yfov",
+	[GLTF_KEY_YMAG]                       = "ymag",
+	[GLTF_KEY_ZFAR]                       = "zfar",
+	[GLTF_KEY_ZNEAR]                      = "znear",
+};
+
+static gltf_key_e
+gltf_key_match(gltf_slice_t* key, gltf_key_e id)
+{
+	ASSERT(key);
+
+	// the caller has already matched the length
+	if(memcmp(key->str, GLTF_KEY_STRING[id], key->len) == 0)
+	{
+		return id;
+	}
+
+	return GLTF_KEY_UNKNOWN;
+}
+
+// keys are dispatched by length and then by first char
+// (and by a distinguishing char for the few collisions) so
+// that any key is resolved with at most one memcmp and
+// unknown keys are rejected without any string compares
+static gltf_key_e gltf_key_lookup(gltf_slice_t* key)
+{
+	ASSERT(key);
+
+	const char* s = key->str;
+	switch(key->len)
+	{
+		case 3:
+			switch(s[0])
+			{
+				case 'm':
+					switch(s[1])
+					{
+						case 'a':
+							return gltf_key_match(key, GLTF_KEY_MAX);
+						case 'i':
+							return gltf_key_match(key, GLTF_KEY_MIN);
+					}
+					break;
+				case 'u':
+					return gltf_key_match(key, GLTF_KEY_URI);
+			}
+			break;
+		case 4:
+			switch(s[0])
+			{
+				case 'm':
+					switch(s[1])
+					{
+						case 'e':
+							return gltf_key_match(key, GLTF_KEY_MESH);
+						case 'o':
+							return gltf_key_match(key, GLTF_KEY_MODE);
+					}
+					break;
+				case 'n':
+					switch(s[1])
+					{
+						case 'a':
+							return gltf_key_match(key, GLTF_KEY_NAME);
+						case 'o':
+							return gltf_key_match(key, GLTF_KEY_NODE);
+					}
+					break;
+				case 'p':
+					return gltf_key_match(key, GLTF_KEY_PATH);
+				case 's':
+					return gltf_key_match(key, GLTF_KEY_SKIN);
+				case 't':
+					return gltf_key_match(key, GLTF_KEY_TYPE);
+				case 'x':
+					return gltf_key_match(key, GLTF_KEY_XMAG);
+				case 'y':
+					switch(s[1])
+					{
+						case 'f':
+							return gltf_key_match(key, GLTF_KEY_YFOV);
+						case 'm':
+							return gltf_key_match(key, GLTF_KEY_YMAG);
+					}
+					break;
+				case 'z':
+					return gltf_key_match(key, GLTF_KEY_ZFAR);
+			}
+			break;
+		case 5:
+			switch(s[0])
+			{
+				case 'c':
+					return gltf_key_match(key, GLTF_KEY_COUNT);
+				case 'i':
+					switch(s[2])
+					{
+						case 'd':
+							return gltf_key_match(key, GLTF_KEY_INDEX);
+						case 'p':
+							return gltf_key_match(key, GLTF_KEY_INPUT);
+					}
+					break;
+				case 'n':
+					return gltf_key_match(key, GLTF_KEY_NODES);
+				case 's':
+					switch(s[2])
+					{
+						case 'a':
+							return gltf_key_match(key, GLTF_KEY_SCALE);
+						case 'e':
+							return gltf_key_match(key, GLTF_KEY_SCENE);
+						case 'i':
+							return gltf_key_match(key, GLTF_KEY_SKINS);
+					}
+					break;
+				case 'z':
+					return gltf_key_match(key, GLTF_KEY_ZNEAR);
+			}
+			break;
+		case 6:
+			switch(s[0])
+			{
+				case 'b':
+					return gltf_key_match(key, GLTF_KEY_BUFFER);
+				case 'c':
+					return gltf_key_match(key, GLTF_KEY_CAMERA);
+				case 'i':
+					return gltf_key_match(key, GLTF_KEY_IMAGES);
+				case 'j':
+					return gltf_key_match(key, GLTF_KEY_JOINTS);
+				case 'm':
+					switch(s[1])
+					{
+						case 'a':
+							return gltf_key_match(key, GLTF_KEY_MATRIX);
+						case 'e':
+							return gltf_key_match(key, GLTF_KEY_MESHES);
+					}
+					break;
+				case 'o':
+					return gltf_key_match(key, GLTF_KEY_OUTPUT);
+				case 's':
+					switch(s[1])
+					{
+						case 'c':
+							return gltf_key_match(key, GLTF_KEY_SCENES);
+						case 'o':
+							return gltf_key_match(key, GLTF_KEY_SOURCE);
+						case 'p':
+							return gltf_key_match(key, GLTF_KEY_SPARSE);
+					}
+					break;
+				case 't':
+					return gltf_key_match(key, GLTF_KEY_TARGET);
+				case 'v':
+					return gltf_key_match(key, GLTF_KEY_VALUES);
+			}
+			break;
+		case 7:
+			switch(s[0])
+			{
+				case 'b':
+					return gltf_key_match(key, GLTF_KEY_BUFFERS);
+				case 'c':
+					return gltf_key_match(key, GLTF_KEY_CAMERAS);
+				case 'i':
+					return gltf_key_match(key, GLTF_KEY_INDICES);
+				case 's':
+					return gltf_key_match(key, GLTF_KEY_SAMPLER);
+				case 't':
+					return gltf_key_match(key, GLTF_KEY_TARGETS);
+				case 'w':
+					return gltf_key_match(key, GLTF_KEY_WEIGHTS);
+			}
+			break;
+		case 8:
+			switch(s[0])
+			{
+				case 'c':
+					switch(s[2])
+					{
+						case 'a':
+							return gltf_key_match(key, GLTF_KEY_CHANNELS);
+						case 'i':
+							return gltf_key_match(key, GLTF_KEY_CHILDREN);
+					}
+					break;
+				case 'm':
+					switch(s[1])
+					{
+						case 'a':
+							return gltf_key_match(key, GLTF_KEY_MATERIAL);
+						case 'i':
+							return gltf_key_match(key, GLTF_KEY_MIME_TYPE);
+					}
+					break;
+				case 'r':
+					return gltf_key_match(key, GLTF_KEY_ROTATION);
+				case 's':
+					switch(s[1])
+					{
+						case 'a':
+							return gltf_key_match(key, GLTF_KEY_SAMPLERS);
+						case 'k':
+							return gltf_key_match(key, GLTF_KEY_SKELETON);
+						case 't':
+							return gltf_key_match(key, GLTF_KEY_STRENGTH);
+					}
+					break;
+				case 't':
+					switch(s[3])
+					{
+						case 'C':
+							return gltf_key_match(key, GLTF_KEY_TEX_COORD);
+						case 't':
+							return gltf_key_match(key, GLTF_KEY_TEXTURES);
+					}
+					break;
+			}
+			break;
+		case 9:
+			switch(s[0])
+			{
+				case 'a':
+					switch(s[1])
+					{
+						case 'c':
+							return gltf_key_match(key, GLTF_KEY_ACCESSORS);
+						case 'l':
+							return gltf_key_match(key, GLTF_KEY_ALPHA_MODE);
+					}
+					break;
+				case 'm':
+					return gltf_key_match(key, GLTF_KEY_MATERIALS);
+			}
+			break;
+		case 10:
+			switch(s[0])
+			{
+				case 'a':
+					switch(s[1])
+					{
+						case 'n':
+							return gltf_key_match(key, GLTF_KEY_ANIMATIONS);
+						case 't':
+							return gltf_key_match(key, GLTF_KEY_ATTRIBUTES);
+					}
+					break;
+				case 'b':
+					switch(s[4])
+					{
+						case 'e':
+							return gltf_key_match(key, GLTF_KEY_BUFFER_VIEW);
+						case 'L':
+							return gltf_key_match(key, GLTF_KEY_BYTE_LENGTH);
+						case 'O':
+							return gltf_key_match(key, GLTF_KEY_BYTE_OFFSET);
+						case 'S':
+							return gltf_key_match(key, GLTF_KEY_BYTE_STRIDE);
+					}
+					break;
+				case 'n':
+					return gltf_key_match(key, GLTF_KEY_NORMALIZED);
+				case 'p':
+					return gltf_key_match(key, GLTF_KEY_PRIMITIVES);
+			}
+			break;
+		case 11:
+			switch(s[0])
+			{
+				case 'a':
+					return gltf_key_match(key, GLTF_KEY_ASPECT_RATIO);
+				case 'b':
+					return gltf_key_match(key, GLTF_KEY_BUFFER_VIEWS);
+				case 'd':
+					return gltf_key_match(key, GLTF_KEY_DOUBLE_SIDED);
+				case 'p':
+					return gltf_key_match(key, GLTF_KEY_PERSPECTIVE);
+				case 't':
+					return gltf_key_match(key, GLTF_KEY_TRANSLATION);
+			}
+			break;
+		case 12:
+			switch(s[0])
+			{
+				case 'o':
+					return gltf_key_match(key, GLTF_KEY_ORTHOGRAPHIC);
+			}
+			break;
+		case 13:
+			switch(s[0])
+			{
+				case 'c':
+					return gltf_key_match(key, GLTF_KEY_COMPONENT_TYPE);
+				case 'i':
+					return gltf_key_match(key, GLTF_KEY_INTERPOLATION);
+				case 'n':
+					return gltf_key_match(key, GLTF_KEY_NORMAL_TEXTURE);
+			}
+			break;
+		case 14:
+			switch(s[0])
+			{
+				case 'e':
+					return gltf_key_match(key, GLTF_KEY_EMISSIVE_FACTOR);
+				case 'm':
+					return gltf_key_match(key, GLTF_KEY_METALLIC_FACTOR);
+			}
+			break;
+		case 15:
+			switch(s[0])
+			{
+				case 'b':
+					return gltf_key_match(key, GLTF_KEY_BASE_COLOR_FACTOR);
+				case 'e':
+					return gltf_key_match(key, GLTF_KEY_EMISSIVE_TEXTURE);
+				case 'r':
+					return gltf_key_match(key, GLTF_KEY_ROUGHNESS_FACTOR);
+			}
+			break;
+		case 16:
+			switch(s[0])
+			{
+				case 'b':
+					return gltf_key_match(key, GLTF_KEY_BASE_COLOR_TEXTURE);
+				case 'o':
+					return gltf_key_match(key, GLTF_KEY_OCCLUSION_TEXTURE);
+			}
+			break;
+		case 19:
+			switch(s[0])
+			{
+				case 'i':
+					return gltf_key_match(key, GLTF_KEY_INVERSE_BIND_MATRICES);
+			}
+			break;
+		case 20:
+			switch(s[0])
+			{
+				case 'p':
+					return gltf_key_match(key, GLTF_KEY_PBR_METALLIC_ROUGHNESS);
+			}
+			break;
+		case 24:
+			switch(s[0])
+			{
+				case 'm':
+					return gltf_key_match(key, GLTF_KEY_METALLIC_ROUGHNESS_TEXTURE);
+			}
+			break;
+	}
+
+	return GLTF_KEY_UNKNOWN;
+}
+
+
+/***********************************************************
+* private - objects                                        *
+***********************************************************/
+
+static int
+gltf_node_parse(gltf_node_t* self, gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	self->name = gltf_parser_intern(parser, "", 0);
+
+	cc_vec3f_load(&self->translation, 0.0f, 0.0f, 0.0f);
+	cc_vec4f_load(&self->rotation, 0.0f, 0.0f, 0.0f, 1.0f);
+	cc_vec3f_load(&self->scale, 1.0f, 1.0f, 1.0f);
+	cc_mat4f_identity(&self->matrix);
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_MESH)
+		{
+			self->mesh     = gltf_parser_uint32(parser);
+			self->has_mesh = 1;
+		}
+		else if(id == GLTF_KEY_NAME)
+		{
+			if(gltf_parser_string(parser, &self->name) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_CAMERA)
+		{
+			self->camera     = gltf_parser_uint32(parser);
+			self->has_camera = 1;
+		}
+		else if(id == GLTF_KEY_SKIN)
+		{
+			self->skin     = gltf_parser_uint32(parser);
+			self->has_skin = 1;
+		}
+		else if(id == GLTF_KEY_MATRIX)
+		{
+			gltf_parser_floats(parser, 16, (float*) &self->matrix);
+			self->has_matrix = 1;
+		}
+		else if(id == GLTF_KEY_TRANSLATION)
+		{
+			gltf_parser_floats(parser, 3,
+			                   (float*) &self->translation);
+		}
+		else if(id == GLTF_KEY_ROTATION)
+		{
+			gltf_parser_floats(parser, 4,
+			                   (float*) &self->rotation);
+		}
+		else if(id == GLTF_KEY_SCALE)
+		{
+			gltf_parser_floats(parser, 3, (float*) &self->scale);
+		}
+		else if(id == GLTF_KEY_CHILDREN)
+		{
+			if(gltf_parser_uint32Array(parser, &self->child_count,
+			                           &self->children) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_WEIGHTS)
+		{
+			if(gltf_parser_floatArray(parser, &self->weight_count,
+			                          &self->weights) == 0)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	// the TRS must not be specified alongside the matrix
+	if(self->has_matrix)
+	{
+		cc_vec3f_load(&self->translation, 0.0f, 0.0f, 0.0f);
+		cc_vec4f_load(&self->rotation, 0.0f, 0.0f, 0.0f, 1.0f);
+		cc_vec3f_load(&self->scale, 1.0f, 1.0f, 1.0f);
+	}
+	else
+	{
+		gltf_mat4f_composeTRS(&self->matrix, &self->translation,
+		                      &self->rotation, &self->scale);
+	}
+
+	return 1;
+}
+
+static void
+gltf_camera_parseType(gltf_camera_t* self,
+                      gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return;
+	}
+
+	if(gltf_slice_equals(&val, "perspective"))
+	{
+		self->type = GLTF_CAMERA_TYPE_PERSPECTIVE;
+	}
+	else if(gltf_slice_equals(&val, "orthographic"))
+	{
+		self->type = GLTF_CAMERA_TYPE_ORTHOGRAPHIC;
+	}
+	else
+	{
+		LOGE("invalid data=%.*s", (int) val.len, val.str);
+	}
+}
+
+static void
+gltf_camera_parsePerspective(gltf_camera_t* self,
+                             gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return;
+	}
+
+	gltf_cameraPerspective_t* cp = &self->cameraPerspective;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_ASPECT_RATIO)
+		{
+			cp->aspectRatio = gltf_parser_float(parser);
+		}
+		else if(id == GLTF_KEY_YFOV)
+		{
+			cp->yfov = gltf_parser_float(parser);
+		}
+		else if(id == GLTF_KEY_ZFAR)
+		{
+			cp->zfar = gltf_parser_float(parser);
+		}
+		else if(id == GLTF_KEY_ZNEAR)
+		{
+			cp->znear = gltf_parser_float(parser);
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+}
+
+static void
+gltf_camera_parseOrthographic(gltf_camera_t* self,
+                              gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return;
+	}
+
+	gltf_cameraOrthographic_t* co = &self->cameraOrthographic;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_XMAG)
+		{
+			co->xmag = gltf_parser_float(parser);
+		}
+		else if(id == GLTF_KEY_YMAG)
+		{
+			co->ymag = gltf_parser_float(parser);
+		}
+		else if(id == GLTF_KEY_ZFAR)
+		{
+			co->zfar = gltf_parser_float(parser);
+		}
+		else if(id == GLTF_KEY_ZNEAR)
+		{
+			co->znear = gltf_parser_float(parser);
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+}
+
+static int
+gltf_camera_parse(gltf_camera_t* self, gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_perspective  = 0;
+	int has_orthographic = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_TYPE)
+		{
+			gltf_camera_parseType(self, parser);
+		}
+		else if(id == GLTF_KEY_PERSPECTIVE)
+		{
+			gltf_camera_parsePerspective(self, parser);
+			has_perspective = 1;
+		}
+		else if(id == GLTF_KEY_ORTHOGRAPHIC)
+		{
+			gltf_camera_parseOrthographic(self, parser);
+			has_orthographic = 1;
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	// check for required members
+	if((self->type == GLTF_CAMERA_TYPE_PERSPECTIVE) &&
+	   (has_perspective  && (has_orthographic == 0)))
+	{
+		return 1;
+	}
+	else if((self->type == GLTF_CAMERA_TYPE_ORTHOGRAPHIC) &&
+	        (has_orthographic && (has_perspective == 0)))
+	{
+		return 1;
+	}
+
+	LOGE("invalid type=%u, has_perspective=%i, has_orthographic=%i",
+	     self->type, has_perspective, has_orthographic);
+	return 0;
+}
+
+static void
+gltf_attribute_parseType(gltf_attribute_t* self,
+                         gltf_slice_t* key)
+{
+	ASSERT(self);
+	ASSERT(key);
+
+	if(gltf_slice_equals(key, "POSITION"))
+	{
+		self->type = GLTF_ATTRIBUTE_TYPE_POSITION;
+		return;
+	}
+	else if(gltf_slice_equals(key, "NORMAL"))
+	{
+		self->type = GLTF_ATTRIBUTE_TYPE_NORMAL;
+		return;
+	}
+	else if(gltf_slice_equals(key, "TANGENT"))
+	{
+		self->type = GLTF_ATTRIBUTE_TYPE_TANGENT;
+		return;
+	}
+
+	// indexed semantics have the form TEXCOORD_n
+	uint32_t sep = 0;
+	while((sep < key->len) && (key->str[sep] != '_'))
+	{
+		++sep;
+	}
+
+	if((sep == 0) || (sep + 1 >= key->len))
+	{
+		return;
+	}
+
+	uint32_t set = 0;
+	uint32_t i;
+	for(i = sep + 1; i < key->len; ++i)
+	{
+		char c = key->str[i];
+		if((c < '0') || (c > '9'))
+		{
+			return;
+		}
+		set = 10*set + (uint32_t) (c - '0');
+	}
+
+	gltf_slice_t prefix =
+	{
+		.str = key->str,
+		.len = sep,
+	};
+
+	if(gltf_slice_equals(&prefix, "TEXCOORD"))
+	{
+		self->type = GLTF_ATTRIBUTE_TYPE_TEXCOORD;
+	}
+	else if(gltf_slice_equals(&prefix, "COLOR"))
+	{
+		self->type = GLTF_ATTRIBUTE_TYPE_COLOR;
+	}
+	else if(gltf_slice_equals(&prefix, "JOINTS"))
+	{
+		self->type = GLTF_ATTRIBUTE_TYPE_JOINTS;
+	}
+	else if(gltf_slice_equals(&prefix, "WEIGHTS"))
+	{
+		self->type = GLTF_ATTRIBUTE_TYPE_WEIGHTS;
+	}
+	else
+	{
+		return;
+	}
+
+	self->set = set;
+}
+
+static int
+gltf_attribute_parse(gltf_attribute_t* self,
+                     gltf_slice_t* key,
+                     gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(key);
+	ASSERT(parser);
+
+	self->name = gltf_parser_intern(parser, key->str, key->len);
+	if(self->name == NULL)
+	{
+		return 0;
+	}
+
+	gltf_attribute_parseType(self, key);
+	self->accessor = gltf_parser_uint32(parser);
+
+	return 1;
+}
+
+// parse an object of attribute semantics to accessors which
+// are the attributes of a primitive or morph target
+static int
+gltf_attribute_parseObject(uint32_t* _count,
+                           gltf_attribute_t** _attributes,
+                           gltf_arena_t* arena,
+                           gltf_parser_t* parser)
+{
+	ASSERT(_count);
+	ASSERT(_attributes);
+	ASSERT(arena);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if(*_attributes)
+	{
+		LOGE("invalid attributes");
+		return 0;
+	}
+
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	gltf_attribute_t* attributes;
+	attributes = (gltf_attribute_t*)
+	             gltf_arena_alloc(arena, count*
+	                              sizeof(gltf_attribute_t));
+	if(attributes == NULL)
+	{
+		return 0;
+	}
+	*_attributes = attributes;
+	*_count      = count;
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		if(gltf_attribute_parse(&attributes[i], &key,
+		                        parser) == 0)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static int
+gltf_primitive_parseTargets(gltf_primitive_t* self,
+                            gltf_arena_t* arena,
+                            gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(arena);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if(self->targets)
+	{
+		LOGE("invalid targets");
+		return 0;
+	}
+
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	self->targets = (gltf_morphTarget_t*)
+	                gltf_arena_alloc(arena, count*
+	                                 sizeof(gltf_morphTarget_t));
+	if(self->targets == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		gltf_morphTarget_t* target = &self->targets[i];
+		if(gltf_attribute_parseObject(&target->attribute_count,
+		                              &target->attributes,
+		                              arena, parser) == 0)
+		{
+			return 0;
+		}
+		++self->target_count;
+	}
+
+	return 1;
+}
+
+static int
+gltf_primitive_parse(gltf_primitive_t* self,
+                     gltf_arena_t* arena,
+                     gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(arena);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// defaults
+	self->mode = GLTF_PRIMITIVE_MODE_TRIANGLES;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_MODE)
+		{
+			self->mode = (gltf_primitiveMode_e)
+			             gltf_parser_uint32(parser);
+		}
+		else if(id == GLTF_KEY_INDICES)
+		{
+			self->indices     = gltf_parser_uint32(parser);
+			self->has_indices = 1;
+		}
+		else if(id == GLTF_KEY_MATERIAL)
+		{
+			self->material     = gltf_parser_uint32(parser);
+			self->has_material = 1;
+		}
+		else if(id == GLTF_KEY_ATTRIBUTES)
+		{
+			if(gltf_attribute_parseObject(&self->attribute_count,
+			                              &self->attributes,
+			                              arena, parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_TARGETS)
+		{
+			if(gltf_primitive_parseTargets(self, arena,
+			                               parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	return 1;
+}
+
+static int
+gltf_mesh_parsePrimitives(gltf_mesh_t* self,
+                          gltf_arena_t* arena,
+                          gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(arena);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if(self->primitives)
+	{
+		LOGE("invalid primitives");
+		return 0;
+	}
+
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	self->primitives = (gltf_primitive_t*)
+	                   gltf_arena_alloc(arena, count*
+	                                    sizeof(gltf_primitive_t));
+	if(self->primitives == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		if(gltf_primitive_parse(&self->primitives[i],
+		                        arena, parser) == 0)
+		{
+			return 0;
+		}
+		++self->primitive_count;
+	}
+
+	return 1;
+}
+
+static int
+gltf_mesh_parse(gltf_mesh_t* self, gltf_arena_t* arena,
+                gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(arena);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_PRIMITIVES)
+		{
+			if(gltf_mesh_parsePrimitives(self, arena,
+			                             parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_WEIGHTS)
+		{
+			if(gltf_parser_floatArray(parser, &self->weight_count,
+			                          &self->weights) == 0)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	return 1;
+}
+
+static int
+gltf_materialTexture_parse(gltf_materialTexture_t* self,
+                           gltf_parser_t* parser,
+                           gltf_key_e fkey, float* fval)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	// fkey/fval are an optional float member which extends
+	// the textureInfo (e.g. normalTexture scale)
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_index    = 0;
+	int has_texCoord = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_INDEX)
+		{
+			self->index = gltf_parser_uint32(parser);
+			has_index   = 1;
+		}
+		else if(id == GLTF_KEY_TEX_COORD)
+		{
+			self->texCoord = gltf_parser_uint32(parser);
+			has_texCoord   = 1;
+		}
+		else if((fkey != GLTF_KEY_UNKNOWN) && (id == fkey))
+		{
+			*fval = gltf_parser_float(parser);
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	// check for required members
+	if(has_index == 0)
+	{
+		LOGE("invalid has_index=%i, has_texCoord=%i",
+		     has_index, has_texCoord);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_material_parsePbrMetallicRoughness(gltf_material_t* self,
+                                        gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	gltf_materialPbrMetallicRoughness_t* pbr;
+	pbr = &self->pbrMetallicRoughness;
+
+	int ret = 1;
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_BASE_COLOR_TEXTURE)
+		{
+			ret &= gltf_materialTexture_parse(&pbr->baseColorTexture,
+			                                  parser, GLTF_KEY_UNKNOWN, NULL);
+			pbr->has_baseColorTexture = 1;
+		}
+		else if(id == GLTF_KEY_BASE_COLOR_FACTOR)
+		{
+			gltf_parser_floats(parser, 4,
+			                   (float*) &pbr->baseColorFactor);
+		}
+		else if(id == GLTF_KEY_METALLIC_ROUGHNESS_TEXTURE)
+		{
+			ret &= gltf_materialTexture_parse(&pbr->metalicRoughnessTexture,
+			                                  parser, GLTF_KEY_UNKNOWN, NULL);
+			pbr->has_metalicRoughnessTexture = 1;
+		}
+		else if(id == GLTF_KEY_METALLIC_FACTOR)
+		{
+			pbr->metallicFactor = gltf_parser_float(parser);
+		}
+		else if(id == GLTF_KEY_ROUGHNESS_FACTOR)
+		{
+			pbr->roughnessFactor = gltf_parser_float(parser);
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	return ret;
+}
+
+static void
+gltf_material_parseDoubleSided(gltf_material_t* self,
+                               gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return;
+	}
+
+	if(gltf_slice_equals(&val, "true"))
+	{
+		self->doubleSided = 1;
+	}
+	else
+	{
+		self->doubleSided = 0;
+	}
+}
+
+static void
+gltf_material_parseAlphaMode(gltf_material_t* self,
+                             gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return;
+	}
+
+	if(gltf_slice_equals(&val, "OPAQUE"))
+	{
+		self->alphaMode = GLTF_MATERIAL_ALPHAMODE_OPAQUE;
+	}
+	else if(gltf_slice_equals(&val, "BLEND"))
+	{
+		self->alphaMode = GLTF_MATERIAL_ALPHAMODE_BLEND;
+	}
+	else
+	{
+		LOGD("unsupported %.*s", (int) val.len, val.str);
+		self->alphaMode = GLTF_MATERIAL_ALPHAMODE_BLEND;
+	}
+}
+
+static int
+gltf_material_parse(gltf_material_t* self,
+                    gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// defaults
+	cc_vec4f_load(&self->pbrMetallicRoughness.baseColorFactor,
+	              1.0f, 1.0f, 1.0f, 1.0f);
+	self->pbrMetallicRoughness.metallicFactor  = 1.0f;
+	self->pbrMetallicRoughness.roughnessFactor = 1.0f;
+	self->normalTexture.scale                  = 1.0f;
+	self->occlusionTexture.strength            = 1.0f;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_PBR_METALLIC_ROUGHNESS)
+		{
+			if(gltf_material_parsePbrMetallicRoughness(self,
+			                                           parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_NORMAL_TEXTURE)
+		{
+			gltf_materialNormalTexture_t* nt;
+			nt = &self->normalTexture;
+			if(gltf_materialTexture_parse(&nt->base, parser,
+			                              GLTF_KEY_SCALE,
+			                              &nt->scale) == 0)
+			{
+				return 0;
+			}
+			self->has_normalTexture = 1;
+		}
+		else if(id == GLTF_KEY_OCCLUSION_TEXTURE)
+		{
+			gltf_materialOcclusionTexture_t* ot;
+			ot = &self->occlusionTexture;
+			if(gltf_materialTexture_parse(&ot->base, parser,
+			                              GLTF_KEY_STRENGTH,
+			                              &ot->strength) == 0)
+			{
+				return 0;
+			}
+			self->has_occlusionTexture = 1;
+		}
+		else if(id == GLTF_KEY_EMISSIVE_TEXTURE)
+		{
+			if(gltf_materialTexture_parse(&self->emissiveTexture,
+			                              parser, GLTF_KEY_UNKNOWN, NULL) == 0)
+			{
+				return 0;
+			}
+			self->has_emissiveTexture = 1;
+		}
+		else if(id == GLTF_KEY_EMISSIVE_FACTOR)
+		{
+			gltf_parser_floats(parser, 3,
+			                   (float*) &self->emissiveFactor);
+		}
+		else if(id == GLTF_KEY_DOUBLE_SIDED)
+		{
+			gltf_material_parseDoubleSided(self, parser);
+		}
+		else if(id == GLTF_KEY_ALPHA_MODE)
+		{
+			gltf_material_parseAlphaMode(self, parser);
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	return 1;
+}
+
+static int
+gltf_accessor_parseType(gltf_accessor_t* self,
+                        gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return 0;
+	}
+
+	if(gltf_slice_equals(&val, "SCALAR"))
+	{
+		self->type = GLTF_ACCESSOR_TYPE_SCALAR;
+	}
+	else if(gltf_slice_equals(&val, "VEC2"))
+	{
+		self->type = GLTF_ACCESSOR_TYPE_VEC2;
+	}
+	else if(gltf_slice_equals(&val, "VEC3"))
+	{
+		self->type = GLTF_ACCESSOR_TYPE_VEC3;
+	}
+	else if(gltf_slice_equals(&val, "VEC4"))
+	{
+		self->type = GLTF_ACCESSOR_TYPE_VEC4;
+	}
+	else if(gltf_slice_equals(&val, "MAT2"))
+	{
+		self->type = GLTF_ACCESSOR_TYPE_MAT2;
+	}
+	else if(gltf_slice_equals(&val, "MAT3"))
+	{
+		self->type = GLTF_ACCESSOR_TYPE_MAT3;
+	}
+	else if(gltf_slice_equals(&val, "MAT4"))
+	{
+		self->type = GLTF_ACCESSOR_TYPE_MAT4;
+	}
+	else
+	{
+		LOGE("invalid type=%.*s", (int) val.len, val.str);
+		return 0;
+	}
+
+	return 1;
+}
+
+static void
+gltf_accessor_parseNormalized(gltf_accessor_t* self,
+                              gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return;
+	}
+
+	if(gltf_slice_equals(&val, "true"))
+	{
+		self->normalized = 1;
+	}
+	else
+	{
+		self->normalized = 0;
+	}
+}
+
+static int
+gltf_accessor_parseSparseIndices(gltf_accessorSparse_t* self,
+                                 gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_bufferView    = 0;
+	int has_componentType = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_BUFFER_VIEW)
+		{
+			self->indices_bufferView = gltf_parser_uint32(parser);
+			has_bufferView           = 1;
+		}
+		else if(id == GLTF_KEY_BYTE_OFFSET)
+		{
+			self->indices_byteOffset = gltf_parser_uint32(parser);
+		}
+		else if(id == GLTF_KEY_COMPONENT_TYPE)
+		{
+			self->indices_componentType = (gltf_componentType_e)
+			                              gltf_parser_uint32(parser);
+			has_componentType           = 1;
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	if((has_bufferView == 0) || (has_componentType == 0))
+	{
+		LOGE("invalid has_bufferView=%i, has_componentType=%i",
+		     has_bufferView, has_componentType);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_accessor_parseSparseValues(gltf_accessorSparse_t* self,
+                                gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_bufferView = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_BUFFER_VIEW)
+		{
+			self->values_bufferView = gltf_parser_uint32(parser);
+			has_bufferView          = 1;
+		}
+		else if(id == GLTF_KEY_BYTE_OFFSET)
+		{
+			self->values_byteOffset = gltf_parser_uint32(parser);
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	if(has_bufferView == 0)
+	{
+		LOGE("invalid has_bufferView=%i", has_bufferView);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_accessor_parseSparse(gltf_accessor_t* self,
+                          gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_count   = 0;
+	int has_indices = 0;
+	int has_values  = 0;
+
+	gltf_accessorSparse_t* sparse = &self->sparse;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_COUNT)
+		{
+			sparse->count = gltf_parser_uint32(parser);
+			has_count     = 1;
+		}
+		else if(id == GLTF_KEY_INDICES)
+		{
+			if(gltf_accessor_parseSparseIndices(sparse,
+			                                    parser) == 0)
+			{
+				return 0;
+			}
+			has_indices = 1;
+		}
+		else if(id == GLTF_KEY_VALUES)
+		{
+			if(gltf_accessor_parseSparseValues(sparse,
+			                                   parser) == 0)
+			{
+				return 0;
+			}
+			has_values = 1;
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	if((has_count == 0) || (has_indices == 0) ||
+	   (has_values == 0))
+	{
+		LOGE("invalid has_count=%i, has_indices=%i, has_values=%i",
+		     has_count, has_indices, has_values);
+		return 0;
+	}
+	self->has_sparse = 1;
+
+	return 1;
+}
+
+static int
+gltf_accessor_parseMinMax(gltf_parser_t* parser,
+                          float* x, uint32_t* _count)
+{
+	ASSERT(parser);
+	ASSERT(x);
+	ASSERT(_count);
+
+	// min/max may appear before the type so the values are
+	// stored and validated once the type is known
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if((tok->size == 0) || (tok->size > 4))
+	{
+		// MAT types are not supported
+		--parser->idx;
+		gltf_parser_skip(parser);
+		return 0;
+	}
+
+	uint32_t count = tok->size;
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		x[i] = gltf_parser_float(parser);
+	}
+	*_count = count;
+
+	return 1;
+}
+
+static int
+gltf_accessor_parse(gltf_accessor_t* self,
+                    gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	int has_componentType = 0;
+	int has_count         = 0;
+	int has_min           = 0;
+	int has_max           = 0;
+
+	uint32_t min_count = 0;
+	uint32_t max_count = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_BUFFER_VIEW)
+		{
+			self->bufferView     = gltf_parser_uint32(parser);
+			self->has_bufferView = 1;
+		}
+		else if(id == GLTF_KEY_BYTE_OFFSET)
+		{
+			self->byteOffset = gltf_parser_uint32(parser);
+		}
+		else if(id == GLTF_KEY_TYPE)
+		{
+			if(gltf_accessor_parseType(self, parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_COMPONENT_TYPE)
+		{
+			self->componentType = (gltf_componentType_e)
+			                      gltf_parser_uint32(parser);
+			has_componentType   = 1;
+		}
+		else if(id == GLTF_KEY_COUNT)
+		{
+			self->count = gltf_parser_uint32(parser);
+			has_count   = 1;
+		}
+		else if(id == GLTF_KEY_NORMALIZED)
+		{
+			gltf_accessor_parseNormalized(self, parser);
+		}
+		else if(id == GLTF_KEY_SPARSE)
+		{
+			if(gltf_accessor_parseSparse(self, parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_MIN)
+		{
+			has_min = gltf_accessor_parseMinMax(parser,
+			                                    self->min,
+			                                    &min_count);
+		}
+		else if(id == GLTF_KEY_MAX)
+		{
+			has_max = gltf_accessor_parseMinMax(parser,
+			                                    self->max,
+			                                    &max_count);
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	// check for required members
+	if((self->type == GLTF_ACCESSOR_TYPE_UNKNOWN) ||
+	   (has_componentType == 0) || (has_count == 0))
+	{
+		LOGE("invalid type=%u, has_componentType=%i, has_count=%i",
+		     (uint32_t) self->type, has_componentType, has_count);
+		return 0;
+	}
+
+	// combine min/max flag
+	uint32_t elem = 0;
+	if(self->type == GLTF_ACCESSOR_TYPE_SCALAR)
+	{
+		elem = 1;
+	}
+	else if(self->type == GLTF_ACCESSOR_TYPE_VEC2)
+	{
+		elem = 2;
+	}
+	else if(self->type == GLTF_ACCESSOR_TYPE_VEC3)
+	{
+		elem = 3;
+	}
+	else if(self->type == GLTF_ACCESSOR_TYPE_VEC4)
+	{
+		elem = 4;
+	}
+
+	if(has_min && has_max && elem &&
+	   (min_count == elem) && (max_count == elem) &&
+	   (self->componentType == GLTF_COMPONENT_TYPE_FLOAT))
+	{
+		self->has_minMax = 1;
+	}
+
+	return 1;
+}
+
+static int
+gltf_texture_parse(gltf_texture_t* self, gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_SOURCE)
+		{
+			self->source     = gltf_parser_uint32(parser);
+			self->has_source = 1;
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	return 1;
+}
+
+static int
+gltf_bufferView_parse(gltf_bufferView_t* self,
+                      gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_buffer     = 0;
+	int has_byteLength = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_BUFFER)
+		{
+			self->buffer = gltf_parser_uint32(parser);
+			has_buffer   = 1;
+		}
+		else if(id == GLTF_KEY_BYTE_OFFSET)
+		{
+			self->byteOffset = gltf_parser_uint32(parser);
+		}
+		else if(id == GLTF_KEY_BYTE_LENGTH)
+		{
+			self->byteLength = gltf_parser_uint32(parser);
+			has_byteLength   = 1;
+		}
+		else if(id == GLTF_KEY_BYTE_STRIDE)
+		{
+			self->byteStride     = gltf_parser_uint32(parser);
+			self->has_byteStride = 1;
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	// check for required members
+	if((has_buffer == 0) || (has_byteLength == 0))
+	{
+		LOGE("invalid has_buffer=%i, has_byteLength=%i",
+		     has_buffer, has_byteLength);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int gltf_image_parseMimeType(gltf_parser_t* parser)
+{
+	ASSERT(parser);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return GLTF_IMAGE_TYPE_UNKNOWN;
+	}
+
+	if(gltf_slice_equals(&val, "image/png"))
+	{
+		return GLTF_IMAGE_TYPE_PNG;
+	}
+	else if(gltf_slice_equals(&val, "image/jpeg"))
+	{
+		return GLTF_IMAGE_TYPE_JPG;
+	}
+
+	return GLTF_IMAGE_TYPE_UNKNOWN;
+}
+
+static int
+gltf_image_parse(gltf_image_t* self, gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_BUFFER_VIEW)
+		{
+			self->bufferView     = gltf_parser_uint32(parser);
+			self->has_bufferView = 1;
+		}
+		else if(id == GLTF_KEY_URI)
+		{
+			if(gltf_parser_uri(parser, &self->uri,
+			                   &self->embedded,
+			                   &self->embedded_length) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_MIME_TYPE)
+		{
+			self->type = (gltf_imageType_e)
+			             gltf_image_parseMimeType(parser);
+			if(self->type == GLTF_IMAGE_TYPE_UNKNOWN)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	// the mimeType is optional for data: URIs
+	if((self->type == GLTF_IMAGE_TYPE_UNKNOWN) && self->embedded)
+	{
+		const char* uri = self->embedded;
+		uint32_t    len = self->embedded_length;
+		if((len >= 15) && (strncmp(uri, "data:image/png;", 15) == 0))
+		{
+			self->type = GLTF_IMAGE_TYPE_PNG;
+		}
+		else if((len >= 16) &&
+		        (strncmp(uri, "data:image/jpeg;", 16) == 0))
+		{
+			self->type = GLTF_IMAGE_TYPE_JPG;
+		}
+	}
+
+	return 1;
+}
+
+static int
+gltf_buffer_parse(gltf_buffer_t* self, gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_byteLength = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_BYTE_LENGTH)
+		{
+			self->byteLength = gltf_parser_uint32(parser);
+			has_byteLength   = 1;
+		}
+		else if(id == GLTF_KEY_URI)
+		{
+			if(gltf_parser_uri(parser, &self->uri,
+			                   &self->embedded,
+			                   &self->embedded_length) == 0)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	// check for required members
+	if(has_byteLength == 0)
+	{
+		LOGE("invalid has_byteLength=%i", has_byteLength);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_scene_parse(gltf_scene_t* self, gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	self->name = gltf_parser_intern(parser, "", 0);
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_NAME)
+		{
+			if(gltf_parser_string(parser, &self->name) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_NODES)
+		{
+			if(gltf_parser_uint32Array(parser, &self->node_count,
+			                           &self->nodes) == 0)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	return 1;
+}
+
+static int
+gltf_animationChannel_parsePath(gltf_animationChannel_t* self,
+                                gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return 0;
+	}
+
+	if(gltf_slice_equals(&val, "translation"))
+	{
+		self->path = GLTF_ANIMATION_PATH_TRANSLATION;
+	}
+	else if(gltf_slice_equals(&val, "rotation"))
+	{
+		self->path = GLTF_ANIMATION_PATH_ROTATION;
+	}
+	else if(gltf_slice_equals(&val, "scale"))
+	{
+		self->path = GLTF_ANIMATION_PATH_SCALE;
+	}
+	else if(gltf_slice_equals(&val, "weights"))
+	{
+		self->path = GLTF_ANIMATION_PATH_WEIGHTS;
+	}
+	else
+	{
+		// extension paths (e.g. KHR_animation_pointer) are
+		// retained as unknown and ignored by the evaluation
+		LOGD("unsupported path=%.*s", (int) val.len, val.str);
+		self->path = GLTF_ANIMATION_PATH_UNKNOWN;
+	}
+
+	return 1;
+}
+
+static int
+gltf_animationChannel_parseTarget(gltf_animationChannel_t* self,
+                                  gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_path = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_NODE)
+		{
+			self->node     = gltf_parser_uint32(parser);
+			self->has_node = 1;
+		}
+		else if(id == GLTF_KEY_PATH)
+		{
+			if(gltf_animationChannel_parsePath(self,
+			                                   parser) == 0)
+			{
+				return 0;
+			}
+			has_path = 1;
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	if(has_path == 0)
+	{
+		LOGE("invalid has_path=%i", has_path);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_animationChannel_parse(gltf_animationChannel_t* self,
+                            gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_sampler = 0;
+	int has_target  = 0;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_SAMPLER)
+		{
+			self->sampler = gltf_parser_uint32(parser);
+			has_sampler   = 1;
+		}
+		else if(id == GLTF_KEY_TARGET)
+		{
+			if(gltf_animationChannel_parseTarget(self,
+			                                     parser) == 0)
+			{
+				return 0;
+			}
+			has_target = 1;
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	if((has_sampler == 0) || (has_target == 0))
+	{
+		LOGE("invalid has_sampler=%i, has_target=%i",
+		     has_sampler, has_target);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_animationSampler_parseInterpolation(gltf_animationSampler_t* self,
+                                         gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return 0;
+	}
+
+	if(gltf_slice_equals(&val, "LINEAR"))
+	{
+		self->interpolation = GLTF_ANIMATION_INTERPOLATION_LINEAR;
+	}
+	else if(gltf_slice_equals(&val, "STEP"))
+	{
+		self->interpolation = GLTF_ANIMATION_INTERPOLATION_STEP;
+	}
+	else if(gltf_slice_equals(&val, "CUBICSPLINE"))
+	{
+		self->interpolation = GLTF_ANIMATION_INTERPOLATION_CUBICSPLINE;
+	}
+	else
+	{
+		LOGE("invalid interpolation=%.*s", (int) val.len, val.str);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_animationSampler_parse(gltf_animationSampler_t* self,
+                            gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	// required members
+	int has_input  = 0;
+	int has_output = 0;
+
+	// interpolation defaults to LINEAR
+	self->interpolation = GLTF_ANIMATION_INTERPOLATION_LINEAR;
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_INPUT)
+		{
+			self->input = gltf_parser_uint32(parser);
+			has_input   = 1;
+		}
+		else if(id == GLTF_KEY_OUTPUT)
+		{
+			self->output = gltf_parser_uint32(parser);
+			has_output   = 1;
+		}
+		else if(id == GLTF_KEY_INTERPOLATION)
+		{
+			if(gltf_animationSampler_parseInterpolation(self,
+			                                            parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	if((has_input == 0) || (has_output == 0))
+	{
+		LOGE("invalid has_input=%i, has_output=%i",
+		     has_input, has_output);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int
+gltf_animation_parseChannels(gltf_animation_t* self,
+                             gltf_arena_t* arena,
+                             gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(arena);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if(self->channels)
+	{
+		LOGE("invalid channels");
+		return 0;
+	}
+
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	self->channels = (gltf_animationChannel_t*)
+	                 gltf_arena_alloc(arena, count*
+	                                  sizeof(gltf_animationChannel_t));
+	if(self->channels == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		if(gltf_animationChannel_parse(&self->channels[i],
+		                               parser) == 0)
+		{
+			return 0;
+		}
+		++self->channel_count;
+	}
+
+	return 1;
+}
+
+static int
+gltf_animation_parseSamplers(gltf_animation_t* self,
+                             gltf_arena_t* arena,
+                             gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(arena);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if(self->samplers)
+	{
+		LOGE("invalid samplers");
+		return 0;
+	}
+
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	self->samplers = (gltf_animationSampler_t*)
+	                 gltf_arena_alloc(arena, count*
+	                                  sizeof(gltf_animationSampler_t));
+	if(self->samplers == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		if(gltf_animationSampler_parse(&self->samplers[i],
+		                               parser) == 0)
+		{
+			return 0;
+		}
+		++self->sampler_count;
+	}
+
+	return 1;
+}
+
+static int
+gltf_animation_parse(gltf_animation_t* self,
+                     gltf_arena_t* arena,
+                     gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(arena);
+	ASSERT(parser);
+
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	self->name = gltf_parser_intern(parser, "", 0);
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
+	{
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
+		{
+			return 0;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_NAME)
+		{
+			if(gltf_parser_string(parser, &self->name) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_CHANNELS)
+		{
+			if(gltf_animation_parseChannels(self, arena,
+			                                parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_SAMPLERS)
+		{
+			if(gltf_animation_parseSamplers(self, arena,
+			                                parser) == 0)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			gltf_parser_unsupported(parser, &key);
+		}
+	}
+
+	// the samplers may follow the channels
+	for(i = 0; i < self->channel_count; ++i)
 	{
-		cc_jsmnVal_t* item;
-		item   = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		x[idx] = gltf_val_float(item);
-		++idx;
-
-		iter = cc_list_next(iter);
+		if(self->channels[i].sampler >= self->sampler_count)
+		{
+			LOGE("invalid sampler=%u, sampler_count=%u",
+			     self->channels[i].sampler, self->sampler_count);
+			return 0;
+		}
 	}
 
 	return 1;
 }
 
 static int
-gltf_node_parseChildren(gltf_node_t* self,
-                        cc_jsmnVal_t* val)
+gltf_skin_parse(gltf_skin_t* self, gltf_parser_t* parser)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	gltf_token_t* tok = gltf_parser_beginObject(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%i", val->type);
 		return 0;
 	}
 
-	cc_jsmnVal_t*  item;
-	uint32_t*      nd;
-	cc_listIter_t* iter = cc_list_head(val->array->list);
-	while(iter)
+	self->name = gltf_parser_intern(parser, "", 0);
+
+	uint32_t i;
+	for(i = 0; i < tok->size; ++i)
 	{
-		item = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		nd   = (uint32_t*) CALLOC(1, sizeof(uint32_t));
-		if(nd == NULL)
+		gltf_slice_t key;
+		if(gltf_parser_key(parser, &key) == 0)
 		{
 			return 0;
 		}
-		*nd = gltf_val_uint32(item);
 
-		if(cc_list_append(self->children, NULL,
-		                  (const void*) nd) == NULL)
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_NAME)
+		{
+			if(gltf_parser_string(parser, &self->name) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_JOINTS)
+		{
+			if(gltf_parser_uint32Array(parser, &self->joint_count,
+			                           &self->joints) == 0)
+			{
+				return 0;
+			}
+		}
+		else if(id == GLTF_KEY_INVERSE_BIND_MATRICES)
+		{
+			self->inverseBindMatrices     = gltf_parser_uint32(parser);
+			self->has_inverseBindMatrices = 1;
+		}
+		else if(id == GLTF_KEY_SKELETON)
+		{
+			self->skeleton     = gltf_parser_uint32(parser);
+			self->has_skeleton = 1;
+		}
+		else
 		{
-			goto fail_append;
+			gltf_parser_unsupported(parser, &key);
 		}
+	}
 
-		iter = cc_list_next(iter);
+	// check for required members
+	if(self->joint_count == 0)
+	{
+		LOGE("invalid joint_count=%u", self->joint_count);
+		return 0;
 	}
 
-	// success
 	return 1;
-
-	// failure
-	fail_append:
-		FREE(nd);
-	return 0;
 }
 
-static gltf_node_t* gltf_node_new(cc_jsmnVal_t* val)
+/***********************************************************
+* private - lazy                                           *
+***********************************************************/
+
+// top-level arrays which may be parsed on demand
+typedef enum
+{
+	GLTF_SECTION_SCENES,
+	GLTF_SECTION_NODES,
+	GLTF_SECTION_CAMERAS,
+	GLTF_SECTION_MESHES,
+	GLTF_SECTION_MATERIALS,
+	GLTF_SECTION_ACCESSORS,
+	GLTF_SECTION_TEXTURES,
+	GLTF_SECTION_BUFFER_VIEWS,
+	GLTF_SECTION_IMAGES,
+	GLTF_SECTION_ANIMATIONS,
+	GLTF_SECTION_SKINS,
+	GLTF_SECTION_BUFFERS,
+	GLTF_SECTION_COUNT,
+} gltf_section_e;
+
+// parse state of each element
+#define GLTF_LAZY_UNPARSED 0
+#define GLTF_LAZY_PARSED   1
+#define GLTF_LAZY_FAILED   2
+
+// byte ranges of the elements of a top-level array
+typedef struct
+{
+	int       indexed;
+	uint32_t  count;
+	uint32_t  max;
+	uint32_t* ranges;
+	uint8_t*  state;
+} gltf_lazySection_t;
+
+typedef struct gltf_lazy_s
+{
+	const char*        json;
+	gltf_lazySection_t sections[GLTF_SECTION_COUNT];
+} gltf_lazy_t;
+
+static int
+gltf_section_fromKey(gltf_key_e id, gltf_section_e* _section)
 {
-	ASSERT(val);
+	ASSERT(_section);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_section_e section;
+	if(id == GLTF_KEY_SCENES)
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		section = GLTF_SECTION_SCENES;
 	}
-
-	gltf_node_t* self;
-	self = (gltf_node_t*) CALLOC(1, sizeof(gltf_node_t));
-	if(self == NULL)
+	else if(id == GLTF_KEY_NODES)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		section = GLTF_SECTION_NODES;
 	}
-
-	self->children = cc_list_new();
-	if(self->children == NULL)
+	else if(id == GLTF_KEY_CAMERAS)
 	{
-		goto fail_list;
+		section = GLTF_SECTION_CAMERAS;
 	}
-
-	cc_mat4f_t translate;
-	cc_mat4f_t rotate;
-	cc_mat4f_t scale;
-	cc_mat4f_t matrix;
-	cc_mat4f_identity(&translate);
-	cc_mat4f_identity(&rotate);
-	cc_mat4f_identity(&scale);
-	cc_mat4f_identity(&matrix);
-
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	else if(id == GLTF_KEY_MESHES)
+	{
+		section = GLTF_SECTION_MESHES;
+	}
+	else if(id == GLTF_KEY_MATERIALS)
+	{
+		section = GLTF_SECTION_MATERIALS;
+	}
+	else if(id == GLTF_KEY_ACCESSORS)
+	{
+		section = GLTF_SECTION_ACCESSORS;
+	}
+	else if(id == GLTF_KEY_TEXTURES)
+	{
+		section = GLTF_SECTION_TEXTURES;
+	}
+	else if(id == GLTF_KEY_BUFFER_VIEWS)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
+		section = GLTF_SECTION_BUFFER_VIEWS;
+	}
+	else if(id == GLTF_KEY_IMAGES)
+	{
+		section = GLTF_SECTION_IMAGES;
+	}
+	else if(id == GLTF_KEY_ANIMATIONS)
+	{
+		section = GLTF_SECTION_ANIMATIONS;
+	}
+	else if(id == GLTF_KEY_SKINS)
+	{
+		section = GLTF_SECTION_SKINS;
+	}
+	else if(id == GLTF_KEY_BUFFERS)
+	{
+		section = GLTF_SECTION_BUFFERS;
+	}
+	else
+	{
+		return 0;
+	}
 
-		if(strcmp(kv->key, "mesh") == 0)
-		{
-			self->mesh     = gltf_val_uint32(kv->val);
-			self->has_mesh = 1;
-		}
-		else if(strcmp(kv->key, "name") == 0)
-		{
-			gltf_val_string(kv->val, self->name);
-		}
-		else if(strcmp(kv->key, "camera") == 0)
-		{
-			self->camera     = gltf_val_uint32(kv->val);
-			self->has_camera = 1;
-		}
-		else if(strcmp(kv->key, "matrix") == 0)
-		{
-			gltf_val_floats(kv->val, 16, (float*) &matrix);
-		}
-		else if(strcmp(kv->key, "translation") == 0)
-		{
-			float t[3] = { 0.0f, 0.0f, 0.0f };
-			gltf_val_floats(kv->val, 3, t);
-			cc_mat4f_translate(&translate, 1, t[0], t[1], t[2]);
-		}
-		else if(strcmp(kv->key, "rotation") == 0)
-		{
-			float r[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-			gltf_val_floats(kv->val, 4, r);
-			cc_mat4f_rotate(&rotate, 1, r[0], r[1], r[2], r[3]);
-		}
-		else if(strcmp(kv->key, "scale") == 0)
-		{
-			float s[3] = { 1.0f, 1.0f, 1.0f };
-			gltf_val_floats(kv->val, 3, s);
-			cc_mat4f_scale(&scale, 1, s[0], s[1], s[2]);
-		}
-		else if(strcmp(kv->key, "children") == 0)
-		{
-			if(gltf_node_parseChildren(self, kv->val) == 0)
-			{
-				goto fail_children;
-			}
-		}
-		else
-		{
-			LOGD("unsupported key=%s", kv->key);
-		}
+	*_section = section;
+	return 1;
+}
 
-		iter = cc_list_next(iter);
+static gltf_lazy_t* gltf_lazy_new(void)
+{
+	gltf_lazy_t* self;
+	self = (gltf_lazy_t*) CALLOC(1, sizeof(gltf_lazy_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
 	}
 
-	cc_mat4f_copy(&self->matrix, &matrix);
-	cc_mat4f_mulm(&self->matrix, &translate);
-	cc_mat4f_mulm(&self->matrix, &rotate);
-	cc_mat4f_mulm(&self->matrix, &scale);
-
-	// success
 	return self;
+}
 
-	// failure
-	fail_children:
+static void gltf_lazy_delete(gltf_lazy_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_lazy_t* self = *_self;
+	if(self)
 	{
-		cc_listIter_t* iter = cc_list_head(self->children);
-		while(iter)
+		int i;
+		for(i = 0; i < GLTF_SECTION_COUNT; ++i)
 		{
-			uint32_t* nd;
-			nd = (uint32_t*)
-			     cc_list_remove(self->children, &iter);
-			FREE(nd);
+			FREE(self->sections[i].ranges);
 		}
-		cc_list_delete(&self->children);
-	}
-	fail_list:
 		FREE(self);
-	return NULL;
+		*_self = NULL;
+	}
 }
 
-static void gltf_node_delete(gltf_node_t** _self)
+static int
+gltf_lazySection_add(gltf_lazySection_t* self,
+                     uint32_t start, uint32_t end)
 {
-	ASSERT(_self);
+	ASSERT(self);
 
-	gltf_node_t* self = *_self;
-	if(self)
+	if(self->count >= self->max)
 	{
-		cc_listIter_t* iter = cc_list_head(self->children);
-		while(iter)
+		uint32_t  max = self->max ? 2*self->max : 64;
+		uint32_t* ranges;
+		ranges = (uint32_t*)
+		         REALLOC(self->ranges, 2*max*sizeof(uint32_t));
+		if(ranges == NULL)
 		{
-			uint32_t* nd;
-			nd = (uint32_t*)
-			     cc_list_remove(self->children, &iter);
-			FREE(nd);
+			LOGE("REALLOC failed");
+			return 0;
 		}
 
-		cc_list_delete(&self->children);
-		FREE(self);
-		*_self = NULL;
+		self->ranges = ranges;
+		self->max    = max;
 	}
+
+	self->ranges[2*self->count]     = start;
+	self->ranges[2*self->count + 1] = end;
+	++self->count;
+
+	return 1;
 }
 
-static void
-gltf_camera_parseType(gltf_camera_t* self,
-                      cc_jsmnVal_t* val)
+/***********************************************************
+* private - scanner                                        *
+***********************************************************/
+
+// the scanner finds the byte range of JSON values without
+// producing tokens and is only used to index the top-level
+// arrays in lazy mode since each element is tokenized
+// (and fully validated) when it is parsed on demand
+
+static int
+gltf_scanner_ws(const char* json, uint32_t length,
+                uint32_t* _pos)
 {
-	ASSERT(self);
-	ASSERT(val);
+	ASSERT(json);
+	ASSERT(_pos);
 
-	if(val->type != CC_JSMN_TYPE_STRING)
+	uint32_t pos = *_pos;
+	while(pos < length)
 	{
-		LOGE("invalid type=%u", val->type);
-		return;
+		char c = json[pos];
+		if((c != ' ')  && (c != '\t') &&
+		   (c != '\r') && (c != '\n'))
+		{
+			break;
+		}
+		++pos;
 	}
+	*_pos = pos;
 
-	if(strcmp(val->data, "perspective") == 0)
+	if(pos >= length)
 	{
-		self->type = GLTF_CAMERA_TYPE_PERSPECTIVE;
+		LOGE("invalid pos=%u", pos);
+		return 0;
 	}
-	else if(strcmp(val->data, "orthographic") == 0)
+
+	return 1;
+}
+
+static int
+gltf_scanner_string(const char* json, uint32_t length,
+                    uint32_t* _pos)
+{
+	ASSERT(json);
+	ASSERT(_pos);
+
+	// skip the opening quote and escapes
+	uint32_t pos = *_pos + 1;
+	while((pos < length) && (json[pos] != '"'))
 	{
-		self->type = GLTF_CAMERA_TYPE_ORTHOGRAPHIC;
+		if(json[pos] == '\\')
+		{
+			++pos;
+		}
+		++pos;
 	}
-	else
+
+	if(pos >= length)
 	{
-		LOGE("invalid data=%s", val->data);
+		LOGE("invalid string");
+		return 0;
 	}
+
+	// skip the closing quote
+	*_pos = pos + 1;
+
+	return 1;
 }
 
-static void
-gltf_camera_parsePerspective(gltf_camera_t* self,
-                             cc_jsmnVal_t* val)
+static int
+gltf_scanner_skip(const char* json, uint32_t length,
+                  uint32_t* _pos)
 {
-	ASSERT(self);
-	ASSERT(val);
+	ASSERT(json);
+	ASSERT(_pos);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	uint32_t pos = *_pos;
+	if(pos >= length)
 	{
-		LOGE("invalid type=%u", val->type);
-		return;
+		LOGE("invalid pos=%u", pos);
+		return 0;
 	}
 
-	gltf_cameraPerspective_t* cp = &self->cameraPerspective;
-
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	char c = json[pos];
+	if(c == '"')
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-
-		if(strcmp(kv->key, "aspectRatio") == 0)
-		{
-			cp->aspectRatio = gltf_val_float(kv->val);
-		}
-		else if(strcmp(kv->key, "yfov") == 0)
-		{
-			cp->yfov = gltf_val_float(kv->val);
-		}
-		else if(strcmp(kv->key, "zfar") == 0)
-		{
-			cp->zfar = gltf_val_float(kv->val);
-		}
-		else if(strcmp(kv->key, "znear") == 0)
+		return gltf_scanner_string(json, length, _pos);
+	}
+	else if((c == '{') || (c == '['))
+	{
+		// match brackets while skipping strings
+		uint32_t depth = 0;
+		while(pos < length)
 		{
-			cp->znear = gltf_val_float(kv->val);
+			c = json[pos];
+			if(c == '"')
+			{
+				if(gltf_scanner_string(json, length,
+				                       &pos) == 0)
+				{
+					return 0;
+				}
+				continue;
+			}
+			else if((c == '{') || (c == '['))
+			{
+				++depth;
+			}
+			else if((c == '}') || (c == ']'))
+			{
+				--depth;
+				if(depth == 0)
+				{
+					*_pos = pos + 1;
+					return 1;
+				}
+			}
+			++pos;
 		}
-		else
+
+		LOGE("invalid depth=%u", depth);
+		return 0;
+	}
+
+	// numbers, true, false and null
+	uint32_t start = pos;
+	while(pos < length)
+	{
+		c = json[pos];
+		if((c == ',')  || (c == ']')  || (c == '}')  ||
+		   (c == ':')  || (c == ' ')  || (c == '\t') ||
+		   (c == '\r') || (c == '\n'))
 		{
-			LOGD("unsupported key=%s", kv->key);
+			break;
 		}
+		++pos;
+	}
 
-		iter = cc_list_next(iter);
+	if(pos == start)
+	{
+		LOGE("invalid pos=%u", pos);
+		return 0;
 	}
+	*_pos = pos;
+
+	return 1;
 }
 
-static void
-gltf_camera_parseOrthographic(gltf_camera_t* self,
-                              cc_jsmnVal_t* val)
+/***********************************************************
+* private - file                                           *
+***********************************************************/
+
+static int
+gltf_file_parseHeader(gltf_file_t* self)
 {
 	ASSERT(self);
-	ASSERT(val);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_header_t* header = (gltf_header_t*) self->data;
+	if((header->magic   != 0x46546C67) ||
+	   (header->version != 2)          ||
+	   (header->length  != self->length))
 	{
-		LOGE("invalid type=%u", val->type);
-		return;
+		LOGE("magic=0x%X, version=%u, length=%u",
+		      header->magic, header->version, header->length);
+		return 0;
 	}
 
-	gltf_cameraOrthographic_t* co = &self->cameraOrthographic;
-
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
-	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
+	return 1;
+}
 
-		if(strcmp(kv->key, "xmag") == 0)
-		{
-			co->xmag = gltf_val_float(kv->val);
-		}
-		else if(strcmp(kv->key, "ymag") == 0)
-		{
-			co->ymag = gltf_val_float(kv->val);
-		}
-		else if(strcmp(kv->key, "zfar") == 0)
-		{
-			co->zfar = gltf_val_float(kv->val);
-		}
-		else if(strcmp(kv->key, "znear") == 0)
-		{
-			co->znear = gltf_val_float(kv->val);
-		}
-		else
-		{
-			LOGD("unsupported key=%s", kv->key);
-		}
+static int
+gltf_file_parseDefaultScene(gltf_file_t* self,
+                            gltf_parser_t* parser)
+{
+	ASSERT(self);
+	ASSERT(parser);
 
-		iter = cc_list_next(iter);
+	gltf_slice_t val;
+	if(gltf_parser_slice(parser, &val) == 0)
+	{
+		return 0;
 	}
+
+	self->scene = (uint32_t) strtol(val.str, NULL, 0);
+	return 1;
 }
 
-static gltf_camera_t*
-gltf_camera_new(cc_jsmnVal_t* val)
+static int
+gltf_file_parseScenes(gltf_file_t* self,
+                      gltf_parser_t* parser)
 {
-	ASSERT(val);
+	ASSERT(self);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		return 0;
 	}
 
-	gltf_camera_t* self;
-	self = (gltf_camera_t*) CALLOC(1, sizeof(gltf_camera_t));
-	if(self == NULL)
+	if(self->scenes)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		LOGE("invalid scenes");
+		return 0;
 	}
 
-	// required members
-	int has_perspective  = 0;
-	int has_orthographic = 0;
-
-	cc_jsmnObject_t* obj = val->obj;
-	cc_listIter_t* iter = cc_list_head(obj->list);
-	while(iter)
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-		if(strcmp(kv->key, "type") == 0)
-		{
-			gltf_camera_parseType(self, kv->val);
-		}
-		else if(strcmp(kv->key, "perspective") == 0)
-		{
-			gltf_camera_parsePerspective(self, kv->val);
-			has_perspective = 1;
-		}
-		else if(strcmp(kv->key, "orthographic") == 0)
-		{
-			gltf_camera_parseOrthographic(self, kv->val);
-			has_orthographic = 1;
-		}
-		else
-		{
-			LOGD("unsupported key=%s", kv->key);
-		}
-
-		iter = cc_list_next(iter);
+		return 1;
 	}
 
-	// check for required members
-	if((self->type == GLTF_CAMERA_TYPE_PERSPECTIVE) &&
-	   (has_perspective  && (has_orthographic == 0)))
+	self->scenes = (gltf_scene_t*)
+	               gltf_arena_alloc(self->arena, count*
+	                                sizeof(gltf_scene_t));
+	if(self->scenes == NULL)
 	{
-		return self;
+		return 0;
 	}
-	else if((self->type == GLTF_CAMERA_TYPE_ORTHOGRAPHIC) &&
-	        (has_orthographic && (has_perspective == 0)))
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
 	{
-		return self;
+		if(gltf_scene_parse(&self->scenes[i], parser) == 0)
+		{
+			return 0;
+		}
+		++self->scene_count;
 	}
 
-	LOGE("invalid type=%u, has_perspective=%i, has_orthographic=%i",
-	     self->type, has_perspective, has_orthographic);
-	FREE(self);
-	return NULL;
+	return 1;
 }
 
-static void gltf_camera_delete(gltf_camera_t** _self)
+static int
+gltf_file_parseNodes(gltf_file_t* self,
+                     gltf_parser_t* parser)
 {
-	ASSERT(_self);
+	ASSERT(self);
+	ASSERT(parser);
 
-	gltf_camera_t* self = *_self;
-	if(self)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		FREE(self);
-		*_self = NULL;
+		return 0;
 	}
-}
 
-static gltf_attribute_t*
-gltf_attribute_new(cc_jsmnKeyval_t* kv)
-{
-	ASSERT(kv);
-
-	gltf_attribute_t* self;
-	self = (gltf_attribute_t*)
-	       CALLOC(1, sizeof(gltf_attribute_t));
-	if(self == NULL)
+	if(self->nodes)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		LOGE("invalid nodes");
+		return 0;
 	}
 
-	snprintf(self->name, 256, "%s", kv->key);
-	self->accessor = gltf_val_uint32(kv->val);
-
-	return self;
-}
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
 
-static void
-gltf_attribute_delete(gltf_attribute_t** _self)
-{
-	ASSERT(_self);
+	self->nodes = (gltf_node_t*)
+	              gltf_arena_alloc(self->arena, count*
+	                               sizeof(gltf_node_t));
+	if(self->nodes == NULL)
+	{
+		return 0;
+	}
 
-	gltf_attribute_t* self = *_self;
-	if(self)
+	uint32_t i;
+	for(i = 0; i < count; ++i)
 	{
-		FREE(self);
-		*_self = NULL;
+		if(gltf_node_parse(&self->nodes[i], parser) == 0)
+		{
+			return 0;
+		}
+		++self->node_count;
 	}
+
+	return 1;
 }
 
 static int
-gltf_primitive_parseAttributes(gltf_primitive_t* self,
-                               cc_jsmnVal_t* val)
+gltf_file_parseCameras(gltf_file_t* self,
+                       gltf_parser_t* parser)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
 		return 0;
 	}
 
-	cc_jsmnObject_t*  obj  = val->obj;
-	cc_listIter_t*    iter = cc_list_head(obj->list);
-	gltf_attribute_t* attr;
-	while(iter)
+	if(self->cameras)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
+		LOGE("invalid cameras");
+		return 0;
+	}
 
-		attr = gltf_attribute_new(kv);
-		if(attr == NULL)
-		{
-			return 0;
-		}
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	self->cameras = (gltf_camera_t*)
+	                gltf_arena_alloc(self->arena, count*
+	                                 sizeof(gltf_camera_t));
+	if(self->cameras == NULL)
+	{
+		return 0;
+	}
 
-		if(cc_list_append(self->attributes, NULL, attr) == NULL)
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		if(gltf_camera_parse(&self->cameras[i], parser) == 0)
 		{
-			goto fail_append;
+			return 0;
 		}
-
-		iter = cc_list_next(iter);
+		++self->camera_count;
 	}
 
-	// success
 	return 1;
-
-	// failure
-	fail_append:
-		gltf_attribute_delete(&attr);
-	return 0;
 }
 
-static gltf_primitive_t*
-gltf_primitive_new(cc_jsmnVal_t* val)
+static int
+gltf_file_parseMeshes(gltf_file_t* self,
+                      gltf_parser_t* parser)
 {
-	ASSERT(val);
+	ASSERT(self);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		return 0;
 	}
 
-	gltf_primitive_t* self;
-	self = (gltf_primitive_t*)
-	       CALLOC(1, sizeof(gltf_primitive_t));
-	if(self == NULL)
+	if(self->meshes)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		LOGE("invalid meshes");
+		return 0;
 	}
 
-	// defaults
-	self->mode = GLTF_PRIMITIVE_MODE_TRIANGLES;
-
-	self->attributes = cc_list_new();
-	if(self->attributes == NULL)
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
 	{
-		goto fail_list;
+		return 1;
 	}
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	self->meshes = (gltf_mesh_t*)
+	               gltf_arena_alloc(self->arena, count*
+	                                sizeof(gltf_mesh_t));
+	if(self->meshes == NULL)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-		if(strcmp(kv->key, "mode") == 0)
-		{
-			self->mode = (gltf_primitiveMode_e)
-			             gltf_val_uint32(kv->val);
-		}
-		else if(strcmp(kv->key, "indices") == 0)
-		{
-			self->indices     = gltf_val_uint32(kv->val);
-			self->has_indices = 1;
-		}
-		else if(strcmp(kv->key, "material") == 0)
-		{
-			self->material     = gltf_val_uint32(kv->val);
-			self->has_material = 1;
-		}
-		else if(strcmp(kv->key, "attributes") == 0)
-		{
-			if(gltf_primitive_parseAttributes(self, kv->val) == 0)
-			{
-				goto fail_attributes;
-			}
-		}
-		else
-		{
-			LOGD("unsupported key=%s", kv->key);
-		}
-
-		iter = cc_list_next(iter);
+		return 0;
 	}
 
-	// success
-	return self;
-
-	// failure
-	fail_attributes:
+	uint32_t i;
+	for(i = 0; i < count; ++i)
 	{
-		iter = cc_list_head(self->attributes);
-		while(iter)
+		if(gltf_mesh_parse(&self->meshes[i], self->arena,
+		                   parser) == 0)
 		{
-			gltf_attribute_t* attr;
-			attr = (gltf_attribute_t*)
-			       cc_list_remove(self->attributes, &iter);
-			gltf_attribute_delete(&attr);
+			return 0;
 		}
-		cc_list_delete(&self->attributes);
+		++self->mesh_count;
 	}
-	fail_list:
-		FREE(self);
-	return NULL;
+
+	return 1;
 }
 
-static void
-gltf_primitive_delete(gltf_primitive_t** _self)
+static int
+gltf_file_parseMaterials(gltf_file_t* self,
+                         gltf_parser_t* parser)
 {
-	ASSERT(_self);
+	ASSERT(self);
+	ASSERT(parser);
 
-	gltf_primitive_t* self = *_self;
-	if(self)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		cc_listIter_t* iter = cc_list_head(self->attributes);
-		while(iter)
-		{
-			gltf_attribute_t* attr;
-			attr = (gltf_attribute_t*)
-			       cc_list_remove(self->attributes, &iter);
-			gltf_attribute_delete(&attr);
-		}
+		return 0;
+	}
 
-		cc_list_delete(&self->attributes);
-		FREE(self);
-		*_self = NULL;
+	if(self->materials)
+	{
+		LOGE("invalid materials");
+		return 0;
 	}
-}
 
-static int
-gltf_mesh_parsePrimitives(gltf_mesh_t* self,
-                          cc_jsmnVal_t* val)
-{
-	ASSERT(self);
-	ASSERT(val);
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	self->materials = (gltf_material_t*)
+	                  gltf_arena_alloc(self->arena, count*
+	                                   sizeof(gltf_material_t));
+	if(self->materials == NULL)
 	{
-		LOGE("invalid type=%i", val->type);
 		return 0;
 	}
 
-	cc_jsmnVal_t*     item;
-	gltf_primitive_t* prim;
-	cc_listIter_t*    iter = cc_list_head(val->array->list);
-	while(iter)
+	uint32_t i;
+	for(i = 0; i < count; ++i)
 	{
-		item = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		prim = gltf_primitive_new(item);
-		if(prim == NULL)
+		if(gltf_material_parse(&self->materials[i], parser) == 0)
 		{
 			return 0;
 		}
-
-		if(cc_list_append(self->primitives, NULL,
-		                  (const void*) prim) == NULL)
-		{
-			goto fail_append;
-		}
-
-		iter = cc_list_next(iter);
+		++self->material_count;
 	}
 
-	// success
 	return 1;
-
-	// failure
-	fail_append:
-		gltf_primitive_delete(&prim);
-	return 0;
 }
 
-static gltf_mesh_t* gltf_mesh_new(cc_jsmnVal_t* val)
+static int
+gltf_file_parseAccessors(gltf_file_t* self,
+                         gltf_parser_t* parser)
 {
-	ASSERT(val);
+	ASSERT(self);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		return 0;
 	}
 
-	gltf_mesh_t* self;
-	self = (gltf_mesh_t*) CALLOC(1, sizeof(gltf_mesh_t));
-	if(self == NULL)
+	if(self->accessors)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		LOGE("invalid accessors");
+		return 0;
 	}
 
-	self->primitives = cc_list_new();
-	if(self->primitives == NULL)
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
 	{
-		goto fail_list;
+		return 1;
 	}
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t* iter = cc_list_head(obj->list);
-	while(iter)
+	self->accessors = (gltf_accessor_t*)
+	                  gltf_arena_alloc(self->arena, count*
+	                                   sizeof(gltf_accessor_t));
+	if(self->accessors == NULL)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-		if(strcmp(kv->key, "primitives") == 0)
-		{
-			if(gltf_mesh_parsePrimitives(self, kv->val) == 0)
-			{
-				goto fail_primitives;
-			}
-		}
-		else
-		{
-			LOGD("unsupported key=%s", kv->key);
-		}
-
-		iter = cc_list_next(iter);
+		return 0;
 	}
 
-	// success
-	return self;
-
-	// failure
-	fail_primitives:
+	uint32_t i;
+	for(i = 0; i < count; ++i)
 	{
-		cc_listIter_t* iter = cc_list_head(self->primitives);
-		while(iter)
+		if(gltf_accessor_parse(&self->accessors[i], parser) == 0)
 		{
-			gltf_primitive_t* prim;
-			prim = (gltf_primitive_t*)
-			       cc_list_remove(self->primitives, &iter);
-			gltf_primitive_delete(&prim);
+			return 0;
 		}
-		cc_list_delete(&self->primitives);
+		++self->accessor_count;
 	}
-	fail_list:
-		FREE(self);
-	return NULL;
+
+	return 1;
 }
 
-static void gltf_mesh_delete(gltf_mesh_t** _self)
+static int
+gltf_file_parseTextures(gltf_file_t* self,
+                        gltf_parser_t* parser)
 {
-	ASSERT(_self);
+	ASSERT(self);
+	ASSERT(parser);
 
-	gltf_mesh_t* self = *_self;
-	if(self)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
+	{
+		return 0;
+	}
+
+	if(self->textures)
+	{
+		LOGE("invalid textures");
+		return 0;
+	}
+
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	self->textures = (gltf_texture_t*)
+	                 gltf_arena_alloc(self->arena, count*
+	                                  sizeof(gltf_texture_t));
+	if(self->textures == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
 	{
-		cc_listIter_t* iter = cc_list_head(self->primitives);
-		while(iter)
+		if(gltf_texture_parse(&self->textures[i], parser) == 0)
 		{
-			gltf_primitive_t* prim;
-			prim = (gltf_primitive_t*)
-			       cc_list_remove(self->primitives, &iter);
-			gltf_primitive_delete(&prim);
+			return 0;
 		}
-
-		cc_list_delete(&self->primitives);
-		FREE(self);
-		*_self = NULL;
+		++self->texture_count;
 	}
+
+	return 1;
 }
 
 static int
-gltf_materialTexture_parse(gltf_materialTexture_t* self,
-                           cc_jsmnVal_t* val)
+gltf_file_parseBufferViews(gltf_file_t* self,
+                           gltf_parser_t* parser)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
 		return 0;
 	}
 
-	// required members
-	int has_index    = 0;
-	int has_texCoord = 0;
-
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	if(self->bufferViews)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-
-		if(strcmp(kv->key, "index") == 0)
-		{
-			self->index = gltf_val_uint32(kv->val);
-			has_index   = 1;
-		}
-		else if(strcmp(kv->key, "texCoord") == 0)
-		{
-			self->texCoord = gltf_val_uint32(kv->val);
-			has_texCoord   = 1;
-		}
-		else
-		{
-			LOGD("unsupported key=%s", kv->key);
-		}
+		LOGE("invalid bufferViews");
+		return 0;
+	}
 
-		iter = cc_list_next(iter);
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
 	}
 
-	// check for required members
-	if(has_index == 0)
+	self->bufferViews = (gltf_bufferView_t*)
+	                    gltf_arena_alloc(self->arena, count*
+	                                     sizeof(gltf_bufferView_t));
+	if(self->bufferViews == NULL)
 	{
-		LOGE("invalid has_index=%i, has_texCoord=%i",
-		     has_index, has_texCoord);
 		return 0;
 	}
 
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		if(gltf_bufferView_parse(&self->bufferViews[i], parser) == 0)
+		{
+			return 0;
+		}
+		++self->bufferView_count;
+	}
+
 	return 1;
 }
 
 static int
-gltf_material_parsePbrMetallicRoughness(gltf_material_t* self,
-                                        cc_jsmnVal_t* val)
+gltf_file_parseImages(gltf_file_t* self,
+                      gltf_parser_t* parser)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
 		return 0;
 	}
 
-	gltf_materialPbrMetallicRoughness_t* pbr;
-	pbr = &self->pbrMetallicRoughness;
-
-	int              ret  = 1;
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	if(self->images)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
+		LOGE("invalid images");
+		return 0;
+	}
 
-		if(strcmp(kv->key, "baseColorTexture") == 0)
-		{
-			ret &= gltf_materialTexture_parse(&pbr->baseColorTexture,
-			                                  kv->val);
-			pbr->has_baseColorTexture = 1;
-		}
-		else if(strcmp(kv->key, "baseColorFactor") == 0)
-		{
-			gltf_val_floats(kv->val, 4,
-			                (float*) &pbr->baseColorFactor);
-		}
-		else if(strcmp(kv->key, "metalicRoughnessTexture") == 0)
-		{
-			ret &= gltf_materialTexture_parse(&pbr->metalicRoughnessTexture,
-			                                  kv->val);
-			pbr->has_metalicRoughnessTexture = 1;
-		}
-		else if(strcmp(kv->key, "metallicFactor") == 0)
-		{
-			pbr->metallicFactor = gltf_val_float(kv->val);
-		}
-		else if(strcmp(kv->key, "roughnessFactor") == 0)
-		{
-			pbr->roughnessFactor = gltf_val_float(kv->val);
-		}
-		else
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	self->images = (gltf_image_t*)
+	               gltf_arena_alloc(self->arena, count*
+	                                sizeof(gltf_image_t));
+	if(self->images == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		if(gltf_image_parse(&self->images[i], parser) == 0)
 		{
-			LOGD("unsupported key=%s", kv->key);
+			return 0;
 		}
-
-		iter = cc_list_next(iter);
+		++self->image_count;
 	}
 
-	return ret;
+	return 1;
 }
 
 static int
-gltf_material_parseNormalTexture(gltf_material_t* self,
-                                 cc_jsmnVal_t* val)
+gltf_file_parseBuffers(gltf_file_t* self,
+                       gltf_parser_t* parser)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
 		return 0;
 	}
 
-	gltf_materialNormalTexture_t* nt = &self->normalTexture;
-	if(gltf_materialTexture_parse(&nt->base, val) == 0)
+	if(self->buffers)
 	{
+		LOGE("invalid buffers");
 		return 0;
 	}
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
+		return 1;
+	}
 
-		if(strcmp(kv->key, "scale") == 0)
-		{
-			nt->scale = gltf_val_float(kv->val);
-		}
-		else
+	self->buffers = (gltf_buffer_t*)
+	                gltf_arena_alloc(self->arena, count*
+	                                 sizeof(gltf_buffer_t));
+	if(self->buffers == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		if(gltf_buffer_parse(&self->buffers[i], parser) == 0)
 		{
-			LOGD("unsupported key=%s", kv->key);
+			return 0;
 		}
-
-		iter = cc_list_next(iter);
+		++self->buffer_count;
 	}
 
 	return 1;
 }
 
 static int
-gltf_material_parseOcclusionTexture(gltf_material_t* self,
-                                    cc_jsmnVal_t* val)
+gltf_file_parseAnimations(gltf_file_t* self,
+                          gltf_parser_t* parser)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
 		return 0;
 	}
 
-	gltf_materialOcclusionTexture_t* ot;
-	ot = &self->occlusionTexture;
-	if(gltf_materialTexture_parse(&ot->base, val) == 0)
+	if(self->animations)
 	{
+		LOGE("invalid animations");
 		return 0;
 	}
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
+		return 1;
+	}
 
-		if(strcmp(kv->key, "strength") == 0)
-		{
-			ot->strength = gltf_val_float(kv->val);
-		}
-		else
+	self->animations = (gltf_animation_t*)
+	                   gltf_arena_alloc(self->arena, count*
+	                                    sizeof(gltf_animation_t));
+	if(self->animations == NULL)
+	{
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		if(gltf_animation_parse(&self->animations[i],
+		                        self->arena, parser) == 0)
 		{
-			LOGD("unsupported key=%s", kv->key);
+			return 0;
 		}
-
-		iter = cc_list_next(iter);
+		++self->animation_count;
 	}
 
 	return 1;
 }
 
-static void
-gltf_material_parseDoubleSided(gltf_material_t* self,
-                               cc_jsmnVal_t* val)
+static int
+gltf_file_parseSkins(gltf_file_t* self,
+                     gltf_parser_t* parser)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(parser);
 
-	if((val->type == CC_JSMN_TYPE_STRING) ||
-	   (val->type == CC_JSMN_TYPE_PRIMITIVE))
-	{
-		if(strcmp(val->data, "true") == 0)
-		{
-			self->doubleSided = 1;
-		}
-		else
-		{
-			self->doubleSided = 0;
-		}
-	}
-	else
+	gltf_token_t* tok = gltf_parser_beginArray(parser);
+	if(tok == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
+		return 0;
 	}
-}
-
-static void
-gltf_material_parseAlphaMode(gltf_material_t* self,
-                             cc_jsmnVal_t* val)
-{
-	ASSERT(self);
-	ASSERT(val);
 
-	if(val->type != CC_JSMN_TYPE_STRING)
+	if(self->skins)
 	{
-		LOGE("invalid type=%u", val->type);
-		return;
+		LOGE("invalid skins");
+		return 0;
 	}
 
-	if(strcmp(val->data, "OPAQUE") == 0)
+	// size the array up front from the token
+	uint32_t count = tok->size;
+	if(count == 0)
 	{
-		self->alphaMode = GLTF_MATERIAL_ALPHAMODE_OPAQUE;
+		return 1;
 	}
-	else if(strcmp(val->data, "BLEND") == 0)
+
+	self->skins = (gltf_skin_t*)
+	              gltf_arena_alloc(self->arena, count*
+	                               sizeof(gltf_skin_t));
+	if(self->skins == NULL)
 	{
-		self->alphaMode = GLTF_MATERIAL_ALPHAMODE_BLEND;
+		return 0;
 	}
-	else
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
 	{
-		LOGD("unsupported %s", val->data);
-		self->alphaMode = GLTF_MATERIAL_ALPHAMODE_BLEND;
+		if(gltf_skin_parse(&self->skins[i], parser) == 0)
+		{
+			return 0;
+		}
+		++self->skin_count;
 	}
+
+	return 1;
 }
 
-static gltf_material_t*
-gltf_material_new(cc_jsmnVal_t* val)
+static int
+gltf_file_parseJson(gltf_file_t* self, const char* data,
+                    uint32_t length)
 {
-	ASSERT(val);
+	ASSERT(self);
+	ASSERT(data);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	uint32_t      count = 0;
+	gltf_token_t* tokens;
+	tokens = gltf_tokenizer_run(data, length, &count);
+	if(tokens == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		return 0;
 	}
 
-	gltf_material_t* self;
-	self = (gltf_material_t*)
-	       CALLOC(1, sizeof(gltf_material_t));
-	if(self == NULL)
+	LOGD("tokens=%u", count);
+
+	gltf_parser_t parser =
 	{
-		LOGE("CALLOC failed");
-		return NULL;
-	}
+		.json    = data,
+		.tokens  = tokens,
+		.count   = count,
+		.strings = self->strings,
+		.arena   = self->arena,
+	};
 
-	// defaults
-	cc_vec4f_load(&self->pbrMetallicRoughness.baseColorFactor,
-	              1.0f, 1.0f, 1.0f, 1.0f);
-	self->pbrMetallicRoughness.metallicFactor  = 1.0f;
-	self->pbrMetallicRoughness.roughnessFactor = 1.0f;
-	self->normalTexture.scale                  = 1.0f;
-	self->occlusionTexture.strength            = 1.0f;
+	gltf_token_t* tok = gltf_parser_beginObject(&parser);
+	if(tok == NULL)
+	{
+		goto fail_tokens;
+	}
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	int result = 1;
+	uint32_t i;
+	for(i = 0; (i < tok->size) && result; ++i)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-		if(strcmp(kv->key, "pbrMetallicRoughness") == 0)
+		gltf_slice_t key;
+		if(gltf_parser_key(&parser, &key) == 0)
 		{
-			if(gltf_material_parsePbrMetallicRoughness(self,
-			                                           kv->val) == 0)
-			{
-				goto fail_parse;
-			}
+			goto fail_tokens;
+		}
+
+		gltf_key_e id = gltf_key_lookup(&key);
+
+		if(id == GLTF_KEY_SCENE)
+		{
+			result &= gltf_file_parseDefaultScene(self, &parser);
 		}
-		else if(strcmp(kv->key, "normalTexture") == 0)
+		else if(id == GLTF_KEY_SCENES)
 		{
-			if(gltf_material_parseNormalTexture(self, kv->val) == 0)
-			{
-				goto fail_parse;
-			}
-			self->has_normalTexture = 1;
+			result &= gltf_file_parseScenes(self, &parser);
 		}
-		else if(strcmp(kv->key, "occlusionTexture") == 0)
+		else if(id == GLTF_KEY_NODES)
 		{
-			if(gltf_material_parseOcclusionTexture(self,
-			                                       kv->val) == 0)
-			{
-				goto fail_parse;
-			}
-			self->has_occlusionTexture = 1;
+			result &= gltf_file_parseNodes(self, &parser);
 		}
-		else if(strcmp(kv->key, "emissiveTexture") == 0)
+		else if(id == GLTF_KEY_CAMERAS)
 		{
-			if(gltf_materialTexture_parse(&self->emissiveTexture,
-			                              kv->val) == 0)
-			{
-				goto fail_parse;
-			}
-			self->has_emissiveTexture = 1;
+			result &= gltf_file_parseCameras(self, &parser);
+		}
+		else if(id == GLTF_KEY_MESHES)
+		{
+			result &= gltf_file_parseMeshes(self, &parser);
+		}
+		else if(id == GLTF_KEY_MATERIALS)
+		{
+			result &= gltf_file_parseMaterials(self, &parser);
+		}
+		else if(id == GLTF_KEY_ACCESSORS)
+		{
+			result &= gltf_file_parseAccessors(self, &parser);
+		}
+		else if(id == GLTF_KEY_TEXTURES)
+		{
+			result &= gltf_file_parseTextures(self, &parser);
+		}
+		else if(id == GLTF_KEY_BUFFER_VIEWS)
+		{
+			result &= gltf_file_parseBufferViews(self, &parser);
+		}
+		else if(id == GLTF_KEY_IMAGES)
+		{
+			result &= gltf_file_parseImages(self, &parser);
 		}
-		else if(strcmp(kv->key, "emissiveFactor") == 0)
+		else if(id == GLTF_KEY_BUFFERS)
 		{
-			gltf_val_floats(kv->val, 3,
-			                (float*) &self->emissiveFactor);
+			result &= gltf_file_parseBuffers(self, &parser);
 		}
-		else if(strcmp(kv->key, "doubleSided") == 0)
+		else if(id == GLTF_KEY_ANIMATIONS)
 		{
-			gltf_material_parseDoubleSided(self, kv->val);
+			result &= gltf_file_parseAnimations(self, &parser);
 		}
-		else if(strcmp(kv->key, "alphaMode") == 0)
+		else if(id == GLTF_KEY_SKINS)
 		{
-			gltf_material_parseAlphaMode(self, kv->val);
+			result &= gltf_file_parseSkins(self, &parser);
 		}
 		else
 		{
-			LOGD("unsupported key=%s", kv->key);
+			gltf_parser_unsupported(&parser, &key);
 		}
-
-		iter = cc_list_next(iter);
 	}
 
-	// success
-	return self;
-
-	// failure
-	fail_parse:
-		FREE(self);
-	return NULL;
-}
+	FREE(tokens);
 
-static void gltf_material_delete(gltf_material_t** _self)
-{
-	ASSERT(_self);
+	return result;
 
-	gltf_material_t* self = *_self;
-	if(self)
-	{
-		FREE(self);
-		*_self = NULL;
-	}
+	// failure
+	fail_tokens:
+		FREE(tokens);
+	return 0;
 }
 
 static int
-gltf_accessor_parseType(gltf_accessor_t* self,
-                        cc_jsmnVal_t* val)
+gltf_file_parseElement(gltf_file_t* self,
+                       gltf_section_e section, uint32_t idx,
+                       gltf_parser_t* parser)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(parser);
 
-	if(val->type != CC_JSMN_TYPE_STRING)
+	if(section == GLTF_SECTION_SCENES)
 	{
-		LOGE("invalid type=%u", val->type);
-		return 0;
+		return gltf_scene_parse(&self->scenes[idx], parser);
 	}
-
-	if(strcmp(val->data, "SCALAR") == 0)
+	else if(section == GLTF_SECTION_NODES)
 	{
-		self->type = GLTF_ACCESSOR_TYPE_SCALAR;
+		return gltf_node_parse(&self->nodes[idx], parser);
 	}
-	else if(strcmp(val->data, "VEC2") == 0)
+	else if(section == GLTF_SECTION_CAMERAS)
 	{
-		self->type = GLTF_ACCESSOR_TYPE_VEC2;
+		return gltf_camera_parse(&self->cameras[idx], parser);
 	}
-	else if(strcmp(val->data, "VEC3") == 0)
+	else if(section == GLTF_SECTION_MESHES)
 	{
-		self->type = GLTF_ACCESSOR_TYPE_VEC3;
+		return gltf_mesh_parse(&self->meshes[idx],
+		                       parser->arena, parser);
 	}
-	else if(strcmp(val->data, "VEC4") == 0)
+	else if(section == GLTF_SECTION_MATERIALS)
 	{
-		self->type = GLTF_ACCESSOR_TYPE_VEC4;
+		return gltf_material_parse(&self->materials[idx],
+		                           parser);
 	}
-	else if(strcmp(val->data, "MAT2") == 0)
+	else if(section == GLTF_SECTION_ACCESSORS)
 	{
-		self->type = GLTF_ACCESSOR_TYPE_MAT2;
+		return gltf_accessor_parse(&self->accessors[idx],
+		                           parser);
 	}
-	else if(strcmp(val->data, "MAT3") == 0)
+	else if(section == GLTF_SECTION_TEXTURES)
 	{
-		self->type = GLTF_ACCESSOR_TYPE_MAT3;
+		return gltf_texture_parse(&self->textures[idx],
+		                          parser);
 	}
-	else if(strcmp(val->data, "MAT4") == 0)
+	else if(section == GLTF_SECTION_BUFFER_VIEWS)
 	{
-		self->type = GLTF_ACCESSOR_TYPE_MAT4;
+		return gltf_bufferView_parse(&self->bufferViews[idx],
+		                             parser);
 	}
-	else
+	else if(section == GLTF_SECTION_IMAGES)
 	{
-		LOGE("invalid type=%s", val->data);
-		return 0;
+		return gltf_image_parse(&self->images[idx], parser);
+	}
+	else if(section == GLTF_SECTION_ANIMATIONS)
+	{
+		return gltf_animation_parse(&self->animations[idx],
+		                            parser->arena, parser);
+	}
+	else if(section == GLTF_SECTION_SKINS)
+	{
+		return gltf_skin_parse(&self->skins[idx], parser);
 	}
 
-	return 1;
+	return gltf_buffer_parse(&self->buffers[idx], parser);
 }
 
-static gltf_accessor_t*
-gltf_accessor_new(cc_jsmnVal_t* val)
+static int
+gltf_file_parseRange(gltf_file_t* self,
+                     gltf_section_e section, uint32_t idx,
+                     const gltf_parser_t* base)
 {
-	ASSERT(val);
+	ASSERT(self);
+	ASSERT(base);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	gltf_lazy_t*        lazy = self->lazy;
+	gltf_lazySection_t* ls   = &lazy->sections[section];
+	if(ls->state[idx] == GLTF_LAZY_PARSED)
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		return 1;
 	}
-
-	gltf_accessor_t* self;
-	self = (gltf_accessor_t*)
-	       CALLOC(1, sizeof(gltf_accessor_t));
-	if(self == NULL)
+	else if(ls->state[idx] == GLTF_LAZY_FAILED)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		return 0;
 	}
 
-	int has_componentType = 0;
-	int has_count         = 0;
-	int has_min           = 0;
-	int has_max           = 0;
-
-	uint32_t         elem  = 0;
-	cc_jsmnObject_t* obj   = val->obj;
-	cc_listIter_t*   iter  = cc_list_head(obj->list);
-	while(iter)
-	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-
-		if(strcmp(kv->key, "bufferView") == 0)
-		{
-			self->bufferView     = gltf_val_uint32(kv->val);
-			self->has_bufferView = 1;
-		}
-		else if(strcmp(kv->key, "byteOffset") == 0)
-		{
-			self->byteOffset = gltf_val_uint32(kv->val);
-		}
-		else if(strcmp(kv->key, "type") == 0)
-		{
-			if(gltf_accessor_parseType(self, kv->val) == 0)
-			{
-				goto fail_type;
-			}
-
-			if(self->type == GLTF_ACCESSOR_TYPE_SCALAR)
-			{
-				elem = 1;
-			}
-			else if(self->type == GLTF_ACCESSOR_TYPE_VEC2)
-			{
-				elem = 2;
-			}
-			else if(self->type == GLTF_ACCESSOR_TYPE_VEC3)
-			{
-				elem = 3;
-			}
-			else if(self->type == GLTF_ACCESSOR_TYPE_VEC4)
-			{
-				elem = 4;
-			}
-		}
-		else if(strcmp(kv->key, "componentType") == 0)
-		{
-			self->componentType = (gltf_componentType_e)
-			                      gltf_val_uint32(kv->val);
-			has_componentType   = 1;
-		}
-		else if(strcmp(kv->key, "count") == 0)
-		{
-			self->count = gltf_val_uint32(kv->val);
-			has_count   = 1;
-		}
-		else if(strcmp(kv->key, "min") == 0)
-		{
-			if(elem &&
-			   (self->componentType == GLTF_COMPONENT_TYPE_FLOAT) &&
-			   gltf_val_floats(kv->val, elem, (float*) &self->min))
-			{
-				has_min = 1;
-			}
-		}
-		else if(strcmp(kv->key, "max") == 0)
-		{
-			if(elem &&
-			   (self->componentType == GLTF_COMPONENT_TYPE_FLOAT) &&
-			   gltf_val_floats(kv->val, elem, (float*) &self->max))
-			{
-				has_max = 1;
-			}
-		}
-		else
-		{
-			LOGD("unsupported key=%s", kv->key);
-		}
+	// elements which fail to parse are not retried since
+	// they may have been partially initialized
+	ls->state[idx] = GLTF_LAZY_FAILED;
 
-		iter = cc_list_next(iter);
-	}
+	uint32_t    start = ls->ranges[2*idx];
+	uint32_t    end   = ls->ranges[2*idx + 1];
+	const char* json  = &lazy->json[start];
 
-	// combine min/max flag
-	if(has_min && has_max)
+	uint32_t      count = 0;
+	gltf_token_t* tokens;
+	tokens = gltf_tokenizer_run(json, end - start, &count);
+	if(tokens == NULL)
 	{
-		self->has_minMax = 1;
+		return 0;
 	}
 
-	// check for required members
-	if((self->type == GLTF_ACCESSOR_TYPE_UNKNOWN) ||
-	   (has_componentType == 0) || (has_count == 0))
+	gltf_parser_t parser = *base;
+	parser.json   = json;
+	parser.tokens = tokens;
+	parser.count  = count;
+	parser.idx    = 0;
+
+	if(gltf_file_parseElement(self, section, idx,
+	                          &parser) == 0)
 	{
-		LOGE("invalid type=%u, has_componentType=%i, has_count=%i",
-		     (uint32_t) self->type, has_componentType, has_count);
-		goto fail_member;
+		LOGE("invalid section=%i, idx=%u", (int) section, idx);
+		FREE(tokens);
+		return 0;
 	}
+	ls->state[idx] = GLTF_LAZY_PARSED;
 
-	// success
-	return self;
-
-	// failure
-	fail_member:
-	fail_type:
-		FREE(self);
-	return NULL;
-}
-
-static void gltf_accessor_delete(gltf_accessor_t** _self)
-{
-	ASSERT(_self);
+	FREE(tokens);
 
-	gltf_accessor_t* self = *_self;
-	if(self)
-	{
-		FREE(self);
-		*_self = NULL;
-	}
+	return 1;
 }
 
-static gltf_texture_t*
-gltf_texture_new(cc_jsmnVal_t* val)
+static int
+gltf_file_parseLazy(gltf_file_t* self,
+                    gltf_section_e section, uint32_t idx)
 {
-	ASSERT(val);
-
-	if(val->type != CC_JSMN_TYPE_OBJECT)
-	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
-	}
+	ASSERT(self);
 
-	gltf_texture_t* self;
-	self = (gltf_texture_t*)
-	       CALLOC(1, sizeof(gltf_texture_t));
-	if(self == NULL)
+	// elements are parsed up front in eager mode
+	if(self->lazy == NULL)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		return 1;
 	}
 
-	cc_jsmnObject_t* obj = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	gltf_parser_t base =
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-		if(strcmp(kv->key, "source") == 0)
-		{
-			self->source     = gltf_val_uint32(kv->val);
-			self->has_source = 1;
-		}
-		else
-		{
-			LOGD("unsupported key=%s", kv->key);
-		}
+		.strings = self->strings,
+		.arena   = self->arena,
+	};
 
-		iter = cc_list_next(iter);
-	}
+	pthread_mutex_lock(&self->mutex);
+	int ret = gltf_file_parseRange(self, section, idx, &base);
+	pthread_mutex_unlock(&self->mutex);
 
-	return self;
+	return ret;
 }
 
-static void gltf_texture_delete(gltf_texture_t** _self)
+static int
+gltf_file_indexArray(gltf_file_t* self,
+                     gltf_section_e section,
+                     uint32_t length, uint32_t* _pos)
 {
-	ASSERT(_self);
+	ASSERT(self);
+	ASSERT(_pos);
 
-	gltf_texture_t* self = *_self;
-	if(self)
+	gltf_lazy_t*        lazy = self->lazy;
+	gltf_lazySection_t* ls   = &lazy->sections[section];
+	const char*         json = lazy->json;
+
+	if(ls->indexed)
 	{
-		FREE(self);
-		*_self = NULL;
+		LOGE("invalid section=%i", (int) section);
+		return 0;
 	}
-}
-
-static gltf_bufferView_t*
-gltf_bufferView_new(cc_jsmnVal_t* val)
-{
-	ASSERT(val);
+	ls->indexed = 1;
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	uint32_t pos = *_pos;
+	if(json[pos] != '[')
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		LOGE("invalid pos=%u", pos);
+		return 0;
 	}
+	++pos;
 
-	gltf_bufferView_t* self;
-	self = (gltf_bufferView_t*)
-	       CALLOC(1, sizeof(gltf_bufferView_t));
-	if(self == NULL)
+	if(gltf_scanner_ws(json, length, &pos) == 0)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		return 0;
 	}
 
-	// required members
-	int has_buffer     = 0;
-	int has_byteLength = 0;
+	if(json[pos] == ']')
+	{
+		*_pos = pos + 1;
+		return 1;
+	}
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	while(1)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-		if(strcmp(kv->key, "buffer") == 0)
+		uint32_t start = pos;
+		if(gltf_scanner_skip(json, length, &pos) == 0)
 		{
-			self->buffer = gltf_val_uint32(kv->val);
-			has_buffer   = 1;
+			return 0;
 		}
-		else if(strcmp(kv->key, "byteOffset") == 0)
+
+		if(gltf_lazySection_add(ls, start, pos) == 0)
 		{
-			self->byteOffset = gltf_val_uint32(kv->val);
+			return 0;
 		}
-		else if(strcmp(kv->key, "byteLength") == 0)
+
+		if(gltf_scanner_ws(json, length, &pos) == 0)
 		{
-			self->byteLength = gltf_val_uint32(kv->val);
-			has_byteLength   = 1;
+			return 0;
 		}
-		else if(strcmp(kv->key, "byteStride") == 0)
+
+		char c = json[pos];
+		++pos;
+		if(c == ']')
 		{
-			self->byteStride     = gltf_val_uint32(kv->val);
-			self->has_byteStride = 1;
+			break;
 		}
-		else
+		else if((c != ',') ||
+		        (gltf_scanner_ws(json, length, &pos) == 0))
 		{
-			LOGD("unsupported key=%s", kv->key);
+			LOGE("invalid pos=%u", pos);
+			return 0;
 		}
-
-		iter = cc_list_next(iter);
 	}
 
-	// check for required members
-	if((has_buffer == 0) || (has_byteLength == 0))
-	{
-		LOGE("invalid has_buffer=%i, has_byteLength=%i",
-		     has_buffer, has_byteLength);
-		FREE(self);
-		return NULL;
-	}
+	*_pos = pos;
 
-	return self;
+	return 1;
 }
 
-static void gltf_bufferView_delete(gltf_bufferView_t** _self)
+static int
+gltf_file_allocSection(gltf_file_t* self,
+                       gltf_section_e section)
 {
-	ASSERT(_self);
+	ASSERT(self);
 
-	gltf_bufferView_t* self = *_self;
-	if(self)
+	gltf_lazySection_t* ls = &self->lazy->sections[section];
+
+	uint32_t count = ls->count;
+	if(count == 0)
 	{
-		FREE(self);
-		*_self = NULL;
+		return 1;
 	}
-}
-
-static int gltf_image_parseMimeType(cc_jsmnVal_t* val)
-{
-	ASSERT(val);
 
-	if(val->type != CC_JSMN_TYPE_STRING)
+	ls->state = (uint8_t*)
+	            gltf_arena_alloc(self->arena, count*
+	                             sizeof(uint8_t));
+	if(ls->state == NULL)
 	{
-		LOGE("invalid type=%u", val->type);
-		return GLTF_IMAGE_TYPE_UNKNOWN;
+		return 0;
 	}
 
-	if(strcmp(val->data, "image/png") == 0)
+	// the elements are zeroed until parsed
+	void* elements;
+	if(section == GLTF_SECTION_SCENES)
 	{
-		return GLTF_IMAGE_TYPE_PNG;
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_scene_t));
+		self->scenes      = (gltf_scene_t*) elements;
+		self->scene_count = count;
 	}
-	else if(strcmp(val->data, "image/jpeg") == 0)
+	else if(section == GLTF_SECTION_NODES)
 	{
-		return GLTF_IMAGE_TYPE_JPG;
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_node_t));
+		self->nodes      = (gltf_node_t*) elements;
+		self->node_count = count;
+	}
+	else if(section == GLTF_SECTION_CAMERAS)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_camera_t));
+		self->cameras      = (gltf_camera_t*) elements;
+		self->camera_count = count;
+	}
+	else if(section == GLTF_SECTION_MESHES)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_mesh_t));
+		self->meshes     = (gltf_mesh_t*) elements;
+		self->mesh_count = count;
+	}
+	else if(section == GLTF_SECTION_MATERIALS)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_material_t));
+		self->materials      = (gltf_material_t*) elements;
+		self->material_count = count;
+	}
+	else if(section == GLTF_SECTION_ACCESSORS)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_accessor_t));
+		self->accessors      = (gltf_accessor_t*) elements;
+		self->accessor_count = count;
+	}
+	else if(section == GLTF_SECTION_TEXTURES)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_texture_t));
+		self->textures      = (gltf_texture_t*) elements;
+		self->texture_count = count;
+	}
+	else if(section == GLTF_SECTION_BUFFER_VIEWS)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_bufferView_t));
+		self->bufferViews      = (gltf_bufferView_t*) elements;
+		self->bufferView_count = count;
+	}
+	else if(section == GLTF_SECTION_IMAGES)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_image_t));
+		self->images      = (gltf_image_t*) elements;
+		self->image_count = count;
+	}
+	else if(section == GLTF_SECTION_ANIMATIONS)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_animation_t));
+		self->animations      = (gltf_animation_t*) elements;
+		self->animation_count = count;
+	}
+	else if(section == GLTF_SECTION_SKINS)
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_skin_t));
+		self->skins      = (gltf_skin_t*) elements;
+		self->skin_count = count;
+	}
+	else
+	{
+		elements = gltf_arena_alloc(self->arena, count*
+		                            sizeof(gltf_buffer_t));
+		self->buffers      = (gltf_buffer_t*) elements;
+		self->buffer_count = count;
 	}
 
-	return GLTF_IMAGE_TYPE_UNKNOWN;
+	if(elements == NULL)
+	{
+		return 0;
+	}
+
+	return 1;
 }
 
-static gltf_image_t* gltf_image_new(cc_jsmnVal_t* val)
+static int
+gltf_file_indexJson(gltf_file_t* self, const char* json,
+                    uint32_t length)
 {
-	ASSERT(val);
+	ASSERT(self);
+	ASSERT(json);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	// index the byte ranges of the top-level array elements
+	// which are parsed on demand by gltf_file_parseLazy
+	self->lazy->json = json;
+
+	uint32_t pos = 0;
+	if((gltf_scanner_ws(json, length, &pos) == 0) ||
+	   (json[pos] != '{'))
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		LOGE("invalid pos=%u", pos);
+		return 0;
 	}
+	++pos;
 
-	gltf_image_t* self;
-	self = (gltf_image_t*)
-	       CALLOC(1, sizeof(gltf_image_t));
-	if(self == NULL)
+	if(gltf_scanner_ws(json, length, &pos) == 0)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		return 0;
 	}
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter)
+	if(json[pos] == '}')
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-
-		if(strcmp(kv->key, "bufferView") == 0)
-		{
-			self->bufferView     = gltf_val_uint32(kv->val);
-			self->has_bufferView = 1;
-		}
-		else if(strcmp(kv->key, "mimeType") == 0)
+		++pos;
+	}
+	else
+	{
+		while(1)
 		{
-			if(gltf_image_parseMimeType(kv->val) == 0)
+			// key
+			if(json[pos] != '"')
+			{
+				LOGE("invalid pos=%u", pos);
+				return 0;
+			}
+
+			gltf_slice_t key;
+			key.str = &json[pos + 1];
+			if(gltf_scanner_string(json, length, &pos) == 0)
+			{
+				return 0;
+			}
+			key.len = (uint32_t) (&json[pos - 1] - key.str);
+
+			if((gltf_scanner_ws(json, length, &pos) == 0) ||
+			   (json[pos] != ':'))
+			{
+				LOGE("invalid pos=%u", pos);
+				return 0;
+			}
+			++pos;
+
+			if(gltf_scanner_ws(json, length, &pos) == 0)
+			{
+				return 0;
+			}
+
+			// value
+			gltf_key_e     id = gltf_key_lookup(&key);
+			gltf_section_e section;
+			if(id == GLTF_KEY_SCENE)
+			{
+				self->scene = (uint32_t)
+				              strtol(&json[pos], NULL, 0);
+				if(gltf_scanner_skip(json, length, &pos) == 0)
+				{
+					return 0;
+				}
+			}
+			else if(gltf_section_fromKey(id, &section))
+			{
+				if(gltf_file_indexArray(self, section, length,
+				                        &pos) == 0)
+				{
+					return 0;
+				}
+			}
+			else
+			{
+				LOGD("unsupported key=%.*s",
+				     (int) key.len, key.str);
+				if(gltf_scanner_skip(json, length, &pos) == 0)
+				{
+					return 0;
+				}
+			}
+
+			if(gltf_scanner_ws(json, length, &pos) == 0)
+			{
+				return 0;
+			}
+
+			char c = json[pos];
+			++pos;
+			if(c == '}')
+			{
+				break;
+			}
+			else if((c != ',') ||
+			        (gltf_scanner_ws(json, length, &pos) == 0))
 			{
-				goto fail_type;
+				LOGE("invalid pos=%u", pos);
+				return 0;
 			}
 		}
-		else
+	}
+
+	int i;
+	for(i = 0; i < GLTF_SECTION_COUNT; ++i)
+	{
+		if(gltf_file_allocSection(self,
+		                          (gltf_section_e) i) == 0)
 		{
-			LOGD("unsupported key=%s", kv->key);
+			return 0;
 		}
-
-		iter = cc_list_next(iter);
 	}
 
-	// success
-	return self;
+	// buffers have no getter so parse them up front
+	uint32_t j;
+	for(j = 0; j < self->buffer_count; ++j)
+	{
+		if(gltf_file_parseLazy(self, GLTF_SECTION_BUFFERS,
+		                       j) == 0)
+		{
+			return 0;
+		}
+	}
 
-	// failure
-	fail_type:
-		FREE(self);
-	return NULL;
+	return 1;
 }
 
-static void gltf_image_delete(gltf_image_t** _self)
+// number of elements claimed by a worker at once
+#define GLTF_PARALLEL_BATCH 64
+
+typedef struct
 {
-	ASSERT(_self);
+	gltf_file_t* file;
 
-	gltf_image_t* self = *_self;
-	if(self)
-	{
-		FREE(self);
-		*_self = NULL;
-	}
-}
+	// claims the next batch of elements
+	pthread_mutex_t mutex;
+	int             section;
+	uint32_t        idx;
+	int             failed;
 
-static gltf_buffer_t* gltf_buffer_new(cc_jsmnVal_t* val)
-{
-	ASSERT(val);
+	pthread_mutex_t strings_mutex;
+} gltf_parallel_t;
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
-	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
-	}
+typedef struct
+{
+	gltf_parallel_t* parallel;
+	gltf_arena_t*    arena;
+	pthread_t        thread;
+	int              started;
+} gltf_worker_t;
 
-	gltf_buffer_t* self;
-	self = (gltf_buffer_t*)
-	       CALLOC(1, sizeof(gltf_buffer_t));
-	if(self == NULL)
-	{
-		LOGE("CALLOC failed");
-		return NULL;
-	}
+static int
+gltf_parallel_claim(gltf_parallel_t* self,
+                    gltf_section_e* _section,
+                    uint32_t* _start, uint32_t* _end)
+{
+	ASSERT(self);
+	ASSERT(_section);
+	ASSERT(_start);
+	ASSERT(_end);
 
-	// required members
-	int has_byteLength = 0;
+	gltf_lazy_t* lazy = self->file->lazy;
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t* iter = cc_list_head(obj->list);
-	while(iter)
+	int claimed = 0;
+	pthread_mutex_lock(&self->mutex);
+	while((self->failed == 0) &&
+	      (self->section < GLTF_SECTION_COUNT))
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-
-		if(strcmp(kv->key, "byteLength") == 0)
+		gltf_lazySection_t* ls;
+		ls = &lazy->sections[self->section];
+		if(self->idx >= ls->count)
 		{
-			self->byteLength = gltf_val_uint32(kv->val);
-			has_byteLength   = 1;
+			++self->section;
+			self->idx = 0;
+			continue;
 		}
-		else
+
+		*_section = (gltf_section_e) self->section;
+		*_start   = self->idx;
+		*_end     = self->idx + GLTF_PARALLEL_BATCH;
+		if(*_end > ls->count)
 		{
-			LOGD("unsupported key=%s", kv->key);
+			*_end = ls->count;
 		}
-
-		iter = cc_list_next(iter);
-	}
-
-	// check for required members
-	if(has_byteLength == 0)
-	{
-		LOGE("invalid has_byteLength=%i", has_byteLength);
-		FREE(self);
-		return NULL;
+		self->idx = *_end;
+		claimed   = 1;
+		break;
 	}
+	pthread_mutex_unlock(&self->mutex);
 
-	return self;
+	return claimed;
 }
 
-static void gltf_buffer_delete(gltf_buffer_t** _self)
+static void* gltf_worker_run(void* arg)
 {
-	ASSERT(_self);
+	ASSERT(arg);
 
-	gltf_buffer_t* self = *_self;
-	if(self)
+	gltf_worker_t*   self     = (gltf_worker_t*) arg;
+	gltf_parallel_t* parallel = self->parallel;
+	gltf_file_t*     file     = parallel->file;
+
+	// each worker allocates from a private arena and locks
+	// the pools which are shared between elements
+	gltf_parser_t base =
 	{
-		FREE(self);
-		*_self = NULL;
+		.strings       = file->strings,
+		.arena         = self->arena,
+		.strings_mutex = &parallel->strings_mutex,
+	};
+
+	gltf_section_e section;
+	uint32_t       start;
+	uint32_t       end;
+	while(gltf_parallel_claim(parallel, &section,
+	                          &start, &end))
+	{
+		uint32_t i;
+		for(i = start; i < end; ++i)
+		{
+			if(gltf_file_parseRange(file, section, i,
+			                        &base) == 0)
+			{
+				pthread_mutex_lock(&parallel->mutex);
+				parallel->failed = 1;
+				pthread_mutex_unlock(&parallel->mutex);
+				return NULL;
+			}
+		}
 	}
+
+	return NULL;
 }
 
 static int
-gltf_scene_parseNodes(gltf_scene_t* self, cc_jsmnVal_t* val)
+gltf_file_parseParallel(gltf_file_t* self,
+                        uint32_t thread_count)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(self->lazy);
+	ASSERT(thread_count > 1);
+
+	// the elements were indexed by gltf_file_indexJson and
+	// are parsed directly into their slots of the arrays
+	// so the results are in index order
+	gltf_parallel_t parallel =
+	{
+		.file = self,
+	};
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	gltf_worker_t* workers;
+	workers = (gltf_worker_t*)
+	          CALLOC(thread_count, sizeof(gltf_worker_t));
+	if(workers == NULL)
 	{
-		LOGE("invalid type=%i", val->type);
+		LOGE("CALLOC failed");
 		return 0;
 	}
 
-	cc_jsmnVal_t*  item;
-	uint32_t*      nd;
-	cc_listIter_t* iter = cc_list_head(val->array->list);
-	while(iter)
+	uint32_t i;
+	for(i = 0; i < thread_count; ++i)
 	{
-		item = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		nd   = (uint32_t*) CALLOC(1, sizeof(uint32_t));
-		if(nd == NULL)
+		workers[i].parallel = &parallel;
+		workers[i].arena    = gltf_arena_new(self->arena->block_size);
+		if(workers[i].arena == NULL)
 		{
-			return 0;
+			goto fail_arena;
+		}
+	}
+
+	pthread_mutex_init(&parallel.mutex, NULL);
+	pthread_mutex_init(&parallel.strings_mutex, NULL);
+
+	// the calling thread runs the first worker and the
+	// remaining work is shared if a thread fails to start
+	for(i = 1; i < thread_count; ++i)
+	{
+		if(pthread_create(&workers[i].thread, NULL,
+		                  gltf_worker_run, &workers[i]) != 0)
+		{
+			LOGW("pthread_create failed");
+			break;
 		}
-		*nd = gltf_val_uint32(item);
+		workers[i].started = 1;
+	}
+	gltf_worker_run(&workers[0]);
 
-		if(cc_list_append(self->nodes, NULL,
-		                  (const void*) nd) == NULL)
+	for(i = 1; i < thread_count; ++i)
+	{
+		if(workers[i].started)
 		{
-			goto fail_append;
+			pthread_join(workers[i].thread, NULL);
 		}
+	}
+
+	pthread_mutex_destroy(&parallel.mutex);
+	pthread_mutex_destroy(&parallel.strings_mutex);
+
+	// the file arena owns the objects of all workers
+	for(i = 0; i < thread_count; ++i)
+	{
+		gltf_arena_merge(self->arena, &workers[i].arena);
+	}
+	FREE(workers);
 
-		iter = cc_list_next(iter);
+	if(parallel.failed)
+	{
+		return 0;
 	}
 
 	// success
 	return 1;
 
 	// failure
-	fail_append:
-		FREE(nd);
+	fail_arena:
+	{
+		for(i = 0; i < thread_count; ++i)
+		{
+			gltf_arena_delete(&workers[i].arena);
+		}
+		FREE(workers);
+	}
 	return 0;
 }
 
-static gltf_scene_t* gltf_scene_new(cc_jsmnVal_t* val)
+static void
+gltf_file_adviseBin(gltf_file_t* self, gltf_chunk_t* chunk,
+                    size_t offset)
 {
-	ASSERT(val);
+	ASSERT(self);
+	ASSERT(chunk);
 
-	if(val->type != CC_JSMN_TYPE_OBJECT)
+	// madvise requires a page aligned address
+	size_t page  = (size_t) sysconf(_SC_PAGESIZE);
+	size_t start = offset + sizeof(gltf_chunk_t);
+	size_t end   = start + chunk->chunkLength;
+	start -= start % page;
+
+	// request readahead for the BIN chunk since buffers are
+	// typically consumed shortly after the file is opened
+	if(madvise((void*) &self->data[start], end - start,
+	           MADV_WILLNEED) == -1)
 	{
-		LOGE("invalid type=%u", val->type);
-		return NULL;
+		LOGW("madvise failed");
 	}
+}
 
-	gltf_scene_t* self;
-	self = (gltf_scene_t*) CALLOC(1, sizeof(gltf_scene_t));
-	if(self == NULL)
+static int
+gltf_file_parseChunk(gltf_file_t* self, size_t* _offset,
+                     gltf_chunkType_e chunkType)
+{
+	ASSERT(self);
+	ASSERT(_offset);
+
+	size_t offset = *_offset;
+
+	gltf_chunk_t* chunk;
+	chunk = (gltf_chunk_t*) &self->data[offset];
+
+	// check for buffer overruns
+	offset += sizeof(gltf_chunk_t) + chunk->chunkLength;
+	if(offset > self->length)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		LOGE("offset=%" PRIu64 ", chunkLength=%" PRIu64,
+		     (uint64_t) offset, (uint64_t) self->length);
+		return 0;
 	}
 
-	self->nodes = cc_list_new();
-	if(self->nodes == NULL)
+	#ifdef GLTF_DEBUG
+	printf("CHUNK: offset=%u, length=%u, type=0x%X\n",
+	     (uint32_t) *_offset, (uint32_t) chunk->chunkLength,
+	     (uint32_t) chunk->chunkType);
+	#endif
+
+	// check expected chunkType
+	if(chunk->chunkType != chunkType)
 	{
-		goto fail_list;
+		LOGE("invalid chunkType=%u", chunk->chunkType);
+		return 0;
 	}
 
-	cc_jsmnObject_t* obj  = val->obj;
-	cc_listIter_t* iter = cc_list_head(obj->list);
-	while(iter)
+	// validate and parse chunk
+	if(chunk->chunkType == GLTF_CHUNK_TYPE_JSON)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-
-		if(strcmp(kv->key, "name") == 0)
-		{
-			gltf_val_string(kv->val, self->name);
-		}
-		else if(strcmp(kv->key, "nodes") == 0)
+		const char* json;
+		json = &self->data[*_offset + sizeof(gltf_chunk_t)];
+		if(self->lazy)
 		{
-			if(gltf_scene_parseNodes(self, kv->val) == 0)
+			if(gltf_file_indexJson(self, json,
+			                       chunk->chunkLength) == 0)
 			{
-				goto fail_nodes;
+				return 0;
 			}
 		}
-		else
+		else if(gltf_file_parseJson(self, json,
+		                            chunk->chunkLength) == 0)
 		{
-			LOGD("unsupported key=%s", kv->key);
+			return 0;
 		}
-
-		iter = cc_list_next(iter);
 	}
-
-	// success
-	return self;
-
-	// failure
-	fail_nodes:
+	else if(chunk->chunkType == GLTF_CHUNK_TYPE_BIN)
 	{
-		cc_listIter_t* iter = cc_list_head(self->nodes);
-		while(iter)
+		if(self->mode == GLTF_FILEMODE_MMAP)
 		{
-			uint32_t* nd;
-			nd = (uint32_t*) cc_list_remove(self->nodes, &iter);
-			FREE(nd);
+			gltf_file_adviseBin(self, chunk, *_offset);
 		}
-
-		cc_list_delete(&self->nodes);
 	}
-	fail_list:
-		FREE(self);
-	return NULL;
-}
-
-static void gltf_scene_delete(gltf_scene_t** _self)
-{
-	ASSERT(_self);
-
-	gltf_scene_t* self = *_self;
-	if(self)
+	else
 	{
-		cc_listIter_t* iter = cc_list_head(self->nodes);
-		while(iter)
-		{
-			uint32_t* nd;
-			nd = (uint32_t*) cc_list_remove(self->nodes, &iter);
-			FREE(nd);
-		}
-
-		cc_list_delete(&self->nodes);
-		FREE(self);
-		*_self = NULL;
+		LOGE("invalid chunkType=%u", chunk->chunkType);
+		return 0;
 	}
-}
 
-/***********************************************************
-* private - file                                           *
-***********************************************************/
+	// update offset
+	*_offset = offset;
+
+	return 1;
+}
 
 static int
-gltf_file_parseHeader(gltf_file_t* self)
+gltf_file_parseText(gltf_file_t* self)
 {
 	ASSERT(self);
 
-	gltf_header_t* header = (gltf_header_t*) self->data;
-	if((header->magic   != 0x46546C67) ||
-	   (header->version != 2)          ||
-	   (header->length  != self->length))
+	if(self->length > 0xFFFFFFFF)
 	{
-		LOGE("magic=0x%X, version=%u, length=%u",
-		      header->magic, header->version, header->length);
+		LOGE("invalid length=%" PRIu64, (uint64_t) self->length);
 		return 0;
 	}
 
-	return 1;
-}
-
-static int
-gltf_file_parseDefaultScene(gltf_file_t* self,
-                            cc_jsmnVal_t* val)
-{
-	ASSERT(self);
-	ASSERT(val);
+	// skip the optional UTF-8 byte order mark
+	const char* json   = self->data;
+	uint32_t    length = (uint32_t) self->length;
+	if((length >= 3) && (strncmp(json, "\xEF\xBB\xBF", 3) == 0))
+	{
+		json   += 3;
+		length -= 3;
+	}
 
-	if((val->type == CC_JSMN_TYPE_STRING) ||
-	   (val->type == CC_JSMN_TYPE_PRIMITIVE))
+	if(self->lazy)
 	{
-		self->scene = (uint32_t) strtol(val->data, NULL, 0);
-		return 1;
+		return gltf_file_indexJson(self, json, length);
 	}
 
-	LOGE("invalid type=%i", val->type);
-	return 0;
+	return gltf_file_parseJson(self, json, length);
 }
 
 static int
-gltf_file_parseScenes(gltf_file_t* self, cc_jsmnVal_t* val)
+gltf_file_parseBinary(gltf_file_t* self, size_t* _bin_offset)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(_bin_offset);
+
+	// check minimum file size
+	if(self->length < sizeof(gltf_header_t))
+	{
+		LOGE("invalid length=%" PRIu64, (uint64_t) self->length);
+		return 0;
+	}
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	// parse header
+	if(gltf_file_parseHeader(self) == 0)
 	{
-		LOGE("invalid type=%i", val->type);
 		return 0;
 	}
 
-	cc_jsmnVal_t*  item;
-	gltf_scene_t*  scene;
-	cc_listIter_t* iter = cc_list_head(val->array->list);
-	while(iter)
+	// parse chunks
+	uint32_t chunk  = 0;
+	size_t   offset = sizeof(gltf_header_t);
+	while(offset < self->length)
 	{
-		item  = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		scene = gltf_scene_new(item);
-		if(scene == NULL)
+		if(chunk == 0)
 		{
-			return 0;
+			if(gltf_file_parseChunk(self, &offset,
+			                        GLTF_CHUNK_TYPE_JSON) == 0)
+			{
+				return 0;
+			}
 		}
-
-		if(cc_list_append(self->scenes, NULL,
-		                  (const void*) scene) == NULL)
+		else if(chunk == 1)
 		{
-			goto fail_append;
+			*_bin_offset = offset;
+			if(gltf_file_parseChunk(self, &offset,
+			                        GLTF_CHUNK_TYPE_BIN) == 0)
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			LOGE("invalid chunk=%u", chunk);
+			return 0;
 		}
 
-		iter = cc_list_next(iter);
+		++chunk;
 	}
 
-	// success
-	return 1;
+	// ensure json chunk exists and the bin chunk is
+	// optional when all buffers are external
+	if(chunk == 0)
+	{
+		LOGE("invalid chunk=%u", chunk);
+		return 0;
+	}
 
-	// failure
-	fail_append:
-		gltf_scene_delete(&scene);
-	return 0;
+	return 1;
 }
 
 static int
-gltf_file_parseNodes(gltf_file_t* self, cc_jsmnVal_t* val)
+gltf_file_decodeHex(const char* str, uint32_t count,
+                    uint32_t* _x)
 {
-	ASSERT(self);
-	ASSERT(val);
-
-	if(val->type != CC_JSMN_TYPE_ARRAY)
-	{
-		LOGE("invalid type=%i", val->type);
-		return 0;
-	}
+	ASSERT(str);
+	ASSERT(_x);
 
-	cc_jsmnVal_t*  item;
-	gltf_node_t*   node;
-	cc_listIter_t* iter = cc_list_head(val->array->list);
-	while(iter)
+	// the scan stops at the null terminator since it is
+	// not a hex digit
+	uint32_t x = 0;
+	uint32_t i;
+	for(i = 0; i < count; ++i)
 	{
-		item  = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		node = gltf_node_new(item);
-		if(node == NULL)
+		unsigned char c = (unsigned char) str[i];
+		if(isxdigit(c) == 0)
 		{
 			return 0;
 		}
 
-		if(cc_list_append(self->nodes, NULL,
-		                  (const void*) node) == NULL)
+		if(isdigit(c))
 		{
-			goto fail_append;
+			x = 16*x + (uint32_t) (c - '0');
+		}
+		else
+		{
+			x = 16*x + (uint32_t) (tolower(c) - 'a' + 10);
 		}
-
-		iter = cc_list_next(iter);
 	}
 
-	// success
+	*_x = x;
 	return 1;
-
-	// failure
-	fail_append:
-		gltf_node_delete(&node);
-	return 0;
 }
 
-static int
-gltf_file_parseCameras(gltf_file_t* self, cc_jsmnVal_t* val)
+static uint32_t
+gltf_file_encodeUtf8(char* dst, uint32_t cp)
 {
-	ASSERT(self);
-	ASSERT(val);
+	ASSERT(dst);
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	if(cp < 0x80)
 	{
-		LOGE("invalid type=%i", val->type);
-		return 0;
+		dst[0] = (char) cp;
+		return 1;
 	}
-
-	cc_jsmnVal_t*  item;
-	gltf_camera_t* camera;
-	cc_listIter_t* iter = cc_list_head(val->array->list);
-	while(iter)
+	else if(cp < 0x800)
 	{
-		item   = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		camera = gltf_camera_new(item);
-		if(camera == NULL)
-		{
-			return 0;
-		}
-
-		if(cc_list_append(self->cameras, NULL,
-		                  (const void*) camera) == NULL)
-		{
-			goto fail_append;
-		}
-
-		iter = cc_list_next(iter);
+		dst[0] = (char) (0xC0 | (cp >> 6));
+		dst[1] = (char) (0x80 | (cp & 0x3F));
+		return 2;
+	}
+	else if(cp < 0x10000)
+	{
+		dst[0] = (char) (0xE0 | (cp >> 12));
+		dst[1] = (char) (0x80 | ((cp >> 6) & 0x3F));
+		dst[2] = (char) (0x80 | (cp & 0x3F));
+		return 3;
 	}
 
-	// success
-	return 1;
-
-	// failure
-	fail_append:
-		gltf_camera_delete(&camera);
-	return 0;
+	dst[0] = (char) (0xF0 | (cp >> 18));
+	dst[1] = (char) (0x80 | ((cp >> 12) & 0x3F));
+	dst[2] = (char) (0x80 | ((cp >> 6) & 0x3F));
+	dst[3] = (char) (0x80 | (cp & 0x3F));
+	return 4;
 }
 
-static int
-gltf_file_parseMeshes(gltf_file_t* self, cc_jsmnVal_t* val)
+// decode a JSON escape sequence (excluding the backslash)
+// and return the number of characters consumed or 0 when
+// the escape is invalid
+static uint32_t
+gltf_file_decodeEscape(const char* esc, char* dst,
+                       uint32_t* _len)
 {
-	ASSERT(self);
-	ASSERT(val);
+	ASSERT(esc);
+	ASSERT(dst);
+	ASSERT(_len);
+
+	*_len = 1;
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	char c = esc[0];
+	if((c == '"') || (c == '\\') || (c == '/'))
+	{
+		*dst = c;
+		return 1;
+	}
+	else if(c == 'b')
+	{
+		*dst = '\b';
+		return 1;
+	}
+	else if(c == 'f')
+	{
+		*dst = '\f';
+		return 1;
+	}
+	else if(c == 'n')
+	{
+		*dst = '\n';
+		return 1;
+	}
+	else if(c == 'r')
+	{
+		*dst = '\r';
+		return 1;
+	}
+	else if(c == 't')
+	{
+		*dst = '\t';
+		return 1;
+	}
+	else if(c != 'u')
 	{
-		LOGE("invalid type=%i", val->type);
 		return 0;
 	}
 
-	cc_jsmnVal_t*  item;
-	gltf_mesh_t*   mesh;
-	cc_listIter_t* iter = cc_list_head(val->array->list);
-	while(iter)
+	uint32_t cp;
+	if(gltf_file_decodeHex(&esc[1], 4, &cp) == 0)
 	{
-		item = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		mesh = gltf_mesh_new(item);
-		if(mesh == NULL)
-		{
-			return 0;
-		}
+		return 0;
+	}
 
-		if(cc_list_append(self->meshes, NULL,
-		                  (const void*) mesh) == NULL)
+	// characters outside the BMP are encoded as a UTF-16
+	// surrogate pair of escapes
+	uint32_t consumed = 5;
+	if((cp >= 0xD800) && (cp <= 0xDBFF))
+	{
+		uint32_t lo;
+		if((esc[5] != '\\') || (esc[6] != 'u') ||
+		   (gltf_file_decodeHex(&esc[7], 4, &lo) == 0) ||
+		   (lo < 0xDC00) || (lo > 0xDFFF))
 		{
-			goto fail_append;
+			return 0;
 		}
 
-		iter = cc_list_next(iter);
+		cp       = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+		consumed = 11;
+	}
+	else if(((cp >= 0xDC00) && (cp <= 0xDFFF)) || (cp == 0))
+	{
+		return 0;
 	}
 
-	// success
-	return 1;
-
-	// failure
-	fail_append:
-		gltf_mesh_delete(&mesh);
-	return 0;
+	*_len = gltf_file_encodeUtf8(dst, cp);
+	return consumed;
 }
 
 static int
-gltf_file_parseMaterials(gltf_file_t* self,
-                         cc_jsmnVal_t* val)
+gltf_file_decodeUri(char* dst, const char* uri)
 {
-	ASSERT(self);
-	ASSERT(val);
-
-	if(val->type != CC_JSMN_TYPE_ARRAY)
-	{
-		LOGE("invalid type=%i", val->type);
-		return 0;
-	}
+	ASSERT(dst);
+	ASSERT(uri);
 
-	cc_jsmnVal_t*    item;
-	gltf_material_t* material;
-	cc_listIter_t*   iter = cc_list_head(val->array->list);
-	while(iter)
+	// decode percent-encoded characters and JSON escapes
+	// which are not replaced by the parser where the
+	// decoded string is never longer than the uri
+	const char* start = uri;
+	while(*uri)
 	{
-		item     = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		material = gltf_material_new(item);
-		if(material == NULL)
+		uint32_t x;
+		if((uri[0] == '%') && gltf_file_decodeHex(&uri[1], 2, &x))
 		{
-			return 0;
+			// null characters would truncate the path
+			if(x == 0)
+			{
+				LOGE("invalid uri=%s", start);
+				return 0;
+			}
+
+			*dst++ = (char) x;
+			uri += 3;
 		}
+		else if(uri[0] == '\\')
+		{
+			uint32_t len;
+			uint32_t consumed;
+			consumed = gltf_file_decodeEscape(&uri[1], dst, &len);
+			if(consumed == 0)
+			{
+				LOGE("invalid uri=%s", start);
+				return 0;
+			}
 
-		if(cc_list_append(self->materials, NULL,
-		                  (const void*) material) == NULL)
+			dst += len;
+			uri += consumed + 1;
+		}
+		else
 		{
-			goto fail_append;
+			*dst++ = *uri++;
 		}
-
-		iter = cc_list_next(iter);
 	}
+	*dst = '\0';
 
-	// success
 	return 1;
-
-	// failure
-	fail_append:
-		gltf_material_delete(&material);
-	return 0;
 }
 
-static int
-gltf_file_parseAccessors(gltf_file_t* self,
-                         cc_jsmnVal_t* val)
+// check that a decoded uri is a relative path which does
+// not reference a parent directory
+static int gltf_file_validPath(const char* path)
 {
-	ASSERT(self);
-	ASSERT(val);
+	ASSERT(path);
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	if(path[0] == '/')
 	{
-		LOGE("invalid type=%i", val->type);
 		return 0;
 	}
 
-	cc_jsmnVal_t*    item;
-	gltf_accessor_t* accessor;
-	cc_listIter_t*   iter = cc_list_head(val->array->list);
-	while(iter)
+	const char* seg = path;
+	while(1)
 	{
-		item     = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		accessor = gltf_accessor_new(item);
-		if(accessor == NULL)
+		const char* end = strchr(seg, '/');
+		size_t      len = end ? (size_t) (end - seg) : strlen(seg);
+		if((len == 2) && (strncmp(seg, "..", 2) == 0))
 		{
 			return 0;
 		}
 
-		if(cc_list_append(self->accessors, NULL,
-		                  (const void*) accessor) == NULL)
+		if(end == NULL)
 		{
-			goto fail_append;
+			break;
 		}
-
-		iter = cc_list_next(iter);
+		seg = end + 1;
 	}
 
-	// success
 	return 1;
-
-	// failure
-	fail_append:
-		gltf_accessor_delete(&accessor);
-	return 0;
 }
 
 static int
-gltf_file_parseTextures(gltf_file_t* self,
-                        cc_jsmnVal_t* val)
+gltf_file_decodeEmbedded(gltf_file_t* self,
+                         const char* uri, uint32_t len,
+                         const char** _data, uint32_t* _size)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(uri);
+	ASSERT(_data);
+	ASSERT(_size);
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	// data:[<mediatype>];base64,<data>
+	const char* comma = (const char*) memchr(uri, ',', len);
+	if(comma == NULL)
 	{
-		LOGE("invalid type=%i", val->type);
+		LOGE("invalid data uri");
 		return 0;
 	}
 
-	cc_jsmnVal_t*   item;
-	gltf_texture_t* texture;
-	cc_listIter_t*  iter = cc_list_head(val->array->list);
-	while(iter)
+	uint32_t header = (uint32_t) (comma - uri);
+	if((header < 7) || (strncmp(comma - 7, ";base64", 7) != 0))
 	{
-		item     = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		texture = gltf_texture_new(item);
-		if(texture == NULL)
-		{
-			return 0;
-		}
+		LOGE("unsupported data uri=%.*s", (int) header, uri);
+		return 0;
+	}
 
-		if(cc_list_append(self->textures, NULL,
-		                  (const void*) texture) == NULL)
-		{
-			goto fail_append;
-		}
+	const char* src = comma + 1;
+	uint32_t    n   = len - header - 1;
+
+	char* data;
+	data = (char*) gltf_arena_alloc(self->arena,
+	                                gltf_base64_size(n));
+	if(data == NULL)
+	{
+		return 0;
+	}
 
-		iter = cc_list_next(iter);
+	if(gltf_base64_decode(src, n, data, _size) == 0)
+	{
+		return 0;
 	}
+	*_data = data;
 
-	// success
 	return 1;
-
-	// failure
-	fail_append:
-		gltf_texture_delete(&texture);
-	return 0;
 }
 
 static int
-gltf_file_parseBufferViews(gltf_file_t* self,
-                           cc_jsmnVal_t* val)
+gltf_file_decodeBuffer(gltf_file_t* self,
+                       gltf_buffer_t* buffer)
 {
 	ASSERT(self);
-	ASSERT(val);
+	ASSERT(buffer);
+	ASSERT(buffer->embedded);
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	const char* data;
+	uint32_t    size;
+	if(gltf_file_decodeEmbedded(self, buffer->embedded,
+	                            buffer->embedded_length,
+	                            &data, &size) == 0)
 	{
-		LOGE("invalid type=%i", val->type);
 		return 0;
 	}
 
-	cc_jsmnVal_t*      item;
-	gltf_bufferView_t* bufferView;
-	cc_listIter_t*     iter = cc_list_head(val->array->list);
-	while(iter)
+	if(size < buffer->byteLength)
 	{
-		item       = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		bufferView = gltf_bufferView_new(item);
-		if(bufferView == NULL)
-		{
-			return 0;
-		}
-
-		if(cc_list_append(self->bufferViews, NULL,
-		                  (const void*) bufferView) == NULL)
-		{
-			goto fail_append;
-		}
-
-		iter = cc_list_next(iter);
+		LOGE("invalid size=%u, byteLength=%u",
+		     size, buffer->byteLength);
+		return 0;
 	}
+	buffer->data = data;
 
-	// success
 	return 1;
-
-	// failure
-	fail_append:
-		gltf_bufferView_delete(&bufferView);
-	return 0;
 }
 
 static int
-gltf_file_parseImages(gltf_file_t* self,
-                      cc_jsmnVal_t* val)
+gltf_file_mapBuffer(gltf_buffer_t* buffer, const char* fname)
 {
-	ASSERT(self);
-	ASSERT(val);
+	ASSERT(buffer);
+	ASSERT(buffer->uri);
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	const char* uri = buffer->uri;
+	if(fname == NULL)
 	{
-		LOGE("invalid type=%i", val->type);
+		LOGE("unsupported uri=%s", uri);
 		return 0;
 	}
 
-	cc_jsmnVal_t*  item;
-	gltf_image_t*  image;
-	cc_listIter_t* iter = cc_list_head(val->array->list);
-	while(iter)
+	// resolve the uri relative to the directory of fname
+	const char* slash   = strrchr(fname, '/');
+	size_t      dir_len = 0;
+	if(slash)
 	{
-		item  = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		image = gltf_image_new(item);
-		if(image == NULL)
-		{
-			return 0;
-		}
-
-		if(cc_list_append(self->images, NULL,
-		                  (const void*) image) == NULL)
-		{
-			goto fail_append;
-		}
+		dir_len = (size_t) (slash - fname) + 1;
+	}
 
-		iter = cc_list_next(iter);
+	char* path = (char*) MALLOC(dir_len + strlen(uri) + 1);
+	if(path == NULL)
+	{
+		LOGE("MALLOC failed");
+		return 0;
+	}
+	memcpy(path, fname, dir_len);
+	if(gltf_file_decodeUri(&path[dir_len], uri) == 0)
+	{
+		goto fail_decode;
 	}
 
-	// success
-	return 1;
+	// external files must be within the directory of fname
+	if(gltf_file_validPath(&path[dir_len]) == 0)
+	{
+		LOGE("invalid uri=%s", uri);
+		goto fail_decode;
+	}
 
-	// failure
-	fail_append:
-		gltf_image_delete(&image);
-	return 0;
-}
+	int fd = open(path, O_RDONLY);
+	if(fd == -1)
+	{
+		LOGE("open %s failed", path);
+		goto fail_open;
+	}
 
-static int
-gltf_file_parseBuffers(gltf_file_t* self,
-                       cc_jsmnVal_t* val)
-{
-	ASSERT(self);
-	ASSERT(val);
+	struct stat st;
+	if(fstat(fd, &st) == -1)
+	{
+		LOGE("fstat path=%s", path);
+		goto fail_fstat;
+	}
 
-	if(val->type != CC_JSMN_TYPE_ARRAY)
+	size_t length = (size_t) st.st_size;
+	if(length < buffer->byteLength)
 	{
-		LOGE("invalid type=%i", val->type);
-		return 0;
+		LOGE("invalid path=%s, length=%" PRIu64 ", byteLength=%u",
+		     path, (uint64_t) length, buffer->byteLength);
+		goto fail_length;
 	}
 
-	cc_jsmnVal_t*  item;
-	gltf_buffer_t* buffer;
-	cc_listIter_t* iter = cc_list_head(val->array->list);
-	while(iter)
+	// empty buffers cannot be mapped
+	if(buffer->byteLength == 0)
+	{
+		buffer->data = "";
+	}
+	else
 	{
-		item   = (cc_jsmnVal_t*) cc_list_peekIter(iter);
-		buffer = gltf_buffer_new(item);
-		if(buffer == NULL)
+		void* data;
+		data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data == MAP_FAILED)
 		{
-			return 0;
+			LOGE("mmap path=%s", path);
+			goto fail_mmap;
 		}
 
-		if(cc_list_append(self->buffers, NULL,
-		                  (const void*) buffer) == NULL)
+		if(madvise(data, length, MADV_WILLNEED) == -1)
 		{
-			goto fail_append;
+			LOGW("madvise failed");
 		}
 
-		iter = cc_list_next(iter);
+		buffer->data       = (const char*) data;
+		buffer->map_length = length;
 	}
 
+	close(fd);
+	FREE(path);
+
 	// success
 	return 1;
 
 	// failure
-	fail_append:
-		gltf_buffer_delete(&buffer);
+	fail_mmap:
+	fail_length:
+	fail_fstat:
+		close(fd);
+	fail_open:
+	fail_decode:
+		FREE(path);
 	return 0;
 }
 
-static int
-gltf_file_parseJson(gltf_file_t* self, gltf_chunk_t* chunk,
-                    size_t offset)
+static void
+gltf_file_unmapBuffers(gltf_file_t* self)
 {
 	ASSERT(self);
-	ASSERT(chunk);
 
-	char* data = &self->data[offset + sizeof(gltf_chunk_t)];
-
-	cc_jsmnVal_t* root;
-	root = cc_jsmnVal_new(data, chunk->chunkLength);
-	if(root == NULL)
+	uint32_t i;
+	for(i = 0; i < self->buffer_count; ++i)
 	{
-		return 0;
+		gltf_buffer_t* buffer = &self->buffers[i];
+		if(buffer->map_length)
+		{
+			munmap((void*) buffer->data, buffer->map_length);
+			buffer->data       = NULL;
+			buffer->map_length = 0;
+		}
 	}
+}
 
-	#ifdef GLTF_DEBUG
-	cc_jsmnVal_print(root);
-	#endif
-
-	int result = 1;
-	if(root->type != CC_JSMN_TYPE_OBJECT)
-	{
-		LOGE("invalid type=%i", root->type);
-		result = 0;
-	}
+static int
+gltf_file_resolveBuffers(gltf_file_t* self,
+                         const char* fname,
+                         size_t bin_offset)
+{
+	ASSERT(self);
 
-	cc_jsmnObject_t* obj  = root->obj;
-	cc_listIter_t*   iter = cc_list_head(obj->list);
-	while(iter && result)
+	// resolve each buffer to a base address once so that
+	// gltf_file_getBuffer is a single add
+	uint32_t i;
+	for(i = 0; i < self->buffer_count; ++i)
 	{
-		cc_jsmnKeyval_t* kv;
-		kv = (cc_jsmnKeyval_t*) cc_list_peekIter(iter);
-		if(strcmp(kv->key, "scene") == 0)
-		{
-			result &= gltf_file_parseDefaultScene(self, kv->val);
-		}
-		else if(strcmp(kv->key, "scenes") == 0)
-		{
-			result &= gltf_file_parseScenes(self, kv->val);
-		}
-		else if(strcmp(kv->key, "nodes") == 0)
-		{
-			result &= gltf_file_parseNodes(self, kv->val);
-		}
-		else if(strcmp(kv->key, "cameras") == 0)
+		gltf_buffer_t* buffer = &self->buffers[i];
+		if(buffer->embedded)
 		{
-			result &= gltf_file_parseCameras(self, kv->val);
-		}
-		else if(strcmp(kv->key, "meshes") == 0)
-		{
-			result &= gltf_file_parseMeshes(self, kv->val);
-		}
-		else if(strcmp(kv->key, "materials") == 0)
-		{
-			result &= gltf_file_parseMaterials(self, kv->val);
-		}
-		else if(strcmp(kv->key, "accessors") == 0)
-		{
-			result &= gltf_file_parseAccessors(self, kv->val);
-		}
-		else if(strcmp(kv->key, "textures") == 0)
-		{
-			result &= gltf_file_parseTextures(self, kv->val);
-		}
-		else if(strcmp(kv->key, "bufferViews") == 0)
-		{
-			result &= gltf_file_parseBufferViews(self, kv->val);
+			// lazy files decode on the first gltf_file_getBuffer
+			if(self->lazy)
+			{
+				continue;
+			}
+
+			if(gltf_file_decodeBuffer(self, buffer) == 0)
+			{
+				return 0;
+			}
+			continue;
 		}
-		else if(strcmp(kv->key, "images") == 0)
+		else if(buffer->uri)
 		{
-			result &= gltf_file_parseImages(self, kv->val);
+			if(gltf_file_mapBuffer(buffer, fname) == 0)
+			{
+				return 0;
+			}
+			continue;
 		}
-		else if(strcmp(kv->key, "buffers") == 0)
+
+		// only the first buffer may refer to the BIN chunk
+		if((i != 0) || (bin_offset == 0))
 		{
-			result &= gltf_file_parseBuffers(self, kv->val);
+			LOGE("invalid buffer=%u, bin_offset=%" PRIu64,
+			     i, (uint64_t) bin_offset);
+			return 0;
 		}
-		else
+
+		gltf_chunk_t* chunk;
+		chunk = (gltf_chunk_t*) &self->data[bin_offset];
+		if(buffer->byteLength > chunk->chunkLength)
 		{
-			LOGD("unsupported key=%s", kv->key);
+			LOGE("invalid byteLength=%u, chunkLength=%u",
+			     buffer->byteLength, chunk->chunkLength);
+			return 0;
 		}
 
-		iter = cc_list_next(iter);
+		buffer->data = &self->data[bin_offset +
+		                           sizeof(gltf_chunk_t)];
 	}
 
-	cc_jsmnVal_delete(&root);
-
-	return result;
+	return 1;
 }
 
-static int
-gltf_file_parseChunk(gltf_file_t* self, size_t* _offset,
-                     gltf_chunkType_e chunkType)
+static gltf_file_t*
+gltf_file_load(char* data, size_t size,
+               gltf_fileMode_e mode, int lazy,
+               uint32_t thread_count, const char* fname)
 {
-	ASSERT(self);
-	ASSERT(_offset);
-
-	size_t offset = *_offset;
-
-	gltf_chunk_t* chunk;
-	chunk = (gltf_chunk_t*) &self->data[offset];
+	ASSERT(data);
 
-	// check for buffer overruns
-	offset += sizeof(gltf_chunk_t) + chunk->chunkLength;
-	if(offset > self->length)
+	if(size == 0)
 	{
-		LOGE("offset=%" PRIu64 ", chunkLength=%" PRIu64,
-		     (uint64_t) offset, (uint64_t) self->length);
-		return 0;
+		LOGE("invalid size=%" PRIu64, (uint64_t) size);
+		return NULL;
 	}
 
-	#ifdef GLTF_DEBUG
-	printf("CHUNK: offset=%u, length=%u, type=0x%X\n",
-	     (uint32_t) *_offset, (uint32_t) chunk->chunkLength,
-	     (uint32_t) chunk->chunkType);
-	#endif
-
-	// check expected chunkType
-	if(chunk->chunkType != chunkType)
+	gltf_file_t* self;
+	self = (gltf_file_t*) CALLOC(1, sizeof(gltf_file_t));
+	if(self == NULL)
 	{
-		LOGE("invalid chunkType=%u", chunk->chunkType);
-		return 0;
+		LOGE("CALLOC failed");
+		return NULL;
 	}
 
-	// validate and parse chunk
-	if(chunk->chunkType == GLTF_CHUNK_TYPE_JSON)
+	self->mode   = mode;
+	self->length = size;
+
+	if(pthread_mutex_init(&self->mutex, NULL) != 0)
 	{
-		if(gltf_file_parseJson(self, chunk, *_offset) == 0)
-		{
-			return 0;
-		}
+		LOGE("pthread_mutex_init failed");
+		goto fail_mutex;
 	}
-	else if(chunk->chunkType == GLTF_CHUNK_TYPE_BIN)
+
+	// size the first arena block relative to the file since
+	// the parsed objects scale with the JSON chunk
+	size_t block_size = size/4;
+	if(block_size < GLTF_FILE_ARENA_BLOCK_MIN)
 	{
-		// accept
+		block_size = GLTF_FILE_ARENA_BLOCK_MIN;
 	}
-	else
+	else if(block_size > GLTF_FILE_ARENA_BLOCK_MAX)
 	{
-		LOGE("invalid chunkType=%u", chunk->chunkType);
-		return 0;
+		block_size = GLTF_FILE_ARENA_BLOCK_MAX;
 	}
 
-	// update offset
-	*_offset = offset;
-
-	return 1;
-}
-
-static void gltf_file_discard(gltf_file_t* self)
-{
-	ASSERT(self);
-
-	cc_listIter_t* iter = cc_list_head(self->scenes);
-	while(iter)
+	self->arena = gltf_arena_new(block_size);
+	if(self->arena == NULL)
 	{
-		gltf_scene_t* scene;
-		scene = (gltf_scene_t*)
-		        cc_list_remove(self->scenes, &iter);
-		gltf_scene_delete(&scene);
+		goto fail_arena;
 	}
 
-	iter = cc_list_head(self->nodes);
-	while(iter)
+	self->strings = gltf_strings_new(self->arena);
+	if(self->strings == NULL)
 	{
-		gltf_node_t* node;
-		node = (gltf_node_t*)
-		       cc_list_remove(self->nodes, &iter);
-		gltf_node_delete(&node);
+		goto fail_strings;
 	}
 
-	iter = cc_list_head(self->cameras);
-	while(iter)
+	// parallel files are indexed like lazy files and then
+	// every element is parsed up front
+	int parallel = (lazy == 0) && (thread_count > 1);
+	if(lazy || parallel)
 	{
-		gltf_camera_t* camera;
-		camera = (gltf_camera_t*)
-		         cc_list_remove(self->cameras, &iter);
-		gltf_camera_delete(&camera);
+		self->lazy = gltf_lazy_new();
+		if(self->lazy == NULL)
+		{
+			goto fail_lazy;
+		}
 	}
 
-	iter = cc_list_head(self->meshes);
-	while(iter)
+	if(mode == GLTF_FILEMODE_COPY)
 	{
-		gltf_mesh_t* mesh;
-		mesh = (gltf_mesh_t*)
-		        cc_list_remove(self->meshes, &iter);
-		gltf_mesh_delete(&mesh);
+		self->data = (char*) CALLOC(1, size);
+		if(self->data == NULL)
+		{
+			goto fail_data;
+		}
+		memcpy(self->data, data, size);
 	}
-
-	iter = cc_list_head(self->materials);
-	while(iter)
+	else
 	{
-		gltf_material_t* material;
-		material = (gltf_material_t*)
-		           cc_list_remove(self->materials, &iter);
-		gltf_material_delete(&material);
+		self->data = data;
 	}
 
-	iter = cc_list_head(self->accessors);
-	while(iter)
+	// GLB files are identified by the magic and any other
+	// file is parsed as a text glTF file
+	size_t bin_offset = 0;
+	if((size >= sizeof(uint32_t)) &&
+	   (strncmp(self->data, "glTF", 4) == 0))
 	{
-		gltf_accessor_t* accessor;
-		accessor = (gltf_accessor_t*)
-		           cc_list_remove(self->accessors, &iter);
-		gltf_accessor_delete(&accessor);
+		if(gltf_file_parseBinary(self, &bin_offset) == 0)
+		{
+			goto fail_parse;
+		}
 	}
-
-	iter = cc_list_head(self->textures);
-	while(iter)
+	else if(gltf_file_parseText(self) == 0)
 	{
-		gltf_texture_t* texture;
-		texture = (gltf_texture_t*)
-		          cc_list_remove(self->textures, &iter);
-		gltf_texture_delete(&texture);
+		goto fail_parse;
 	}
 
-	iter = cc_list_head(self->bufferViews);
-	while(iter)
+	if(parallel)
 	{
-		gltf_bufferView_t* bufferView;
-		bufferView = (gltf_bufferView_t*)
-		             cc_list_remove(self->bufferViews, &iter);
-		gltf_bufferView_delete(&bufferView);
+		if(gltf_file_parseParallel(self, thread_count) == 0)
+		{
+			goto fail_parse;
+		}
+		gltf_lazy_delete(&self->lazy);
 	}
 
-	iter = cc_list_head(self->images);
-	while(iter)
+	if(gltf_file_resolveBuffers(self, fname, bin_offset) == 0)
 	{
-		gltf_image_t* image;
-		image = (gltf_image_t*)
-		        cc_list_remove(self->images, &iter);
-		gltf_image_delete(&image);
+		goto fail_buffers;
 	}
 
-	iter = cc_list_head(self->buffers);
-	while(iter)
+	// success
+	return self;
+
+	// failure
+	fail_buffers:
+		gltf_file_unmapBuffers(self);
+	fail_parse:
 	{
-		gltf_buffer_t* buffer;
-		buffer = (gltf_buffer_t*)
-		         cc_list_remove(self->buffers, &iter);
-		gltf_buffer_delete(&buffer);
+		if(self->mode == GLTF_FILEMODE_COPY)
+		{
+			FREE(self->data);
+		}
 	}
+	fail_data:
+		gltf_lazy_delete(&self->lazy);
+	fail_lazy:
+		gltf_strings_delete(&self->strings);
+	fail_strings:
+		gltf_arena_delete(&self->arena);
+	fail_arena:
+		pthread_mutex_destroy(&self->mutex);
+	fail_mutex:
+		FREE(self);
+	return NULL;
 }
 
-/***********************************************************
-* public                                                   *
-***********************************************************/
-
-gltf_file_t* gltf_file_open(const char* fname)
+static gltf_file_t*
+gltf_file_map(const char* fname, int lazy,
+              uint32_t thread_count)
 {
 	ASSERT(fname);
 
-	FILE* f = fopen(fname, "r");
-	if(f == NULL)
+	int fd = open(fname, O_RDONLY);
+	if(fd == -1)
 	{
-		LOGE("fopen %s failed", fname);
+		LOGE("open %s failed", fname);
 		return NULL;
 	}
 
-	// get file lenth
-	if(fseek(f, (long) 0, SEEK_END) == -1)
+	// get file length
+	struct stat st;
+	if((fstat(fd, &st) == -1) || (st.st_size == 0))
 	{
-		LOGE("fseek_end fname=%s", fname);
-		goto fail_fseek_end;
+		LOGE("fstat fname=%s", fname);
+		goto fail_fstat;
 	}
-	size_t length = ftell(f);
+	size_t length = (size_t) st.st_size;
 
-	// rewind to start
-	if(fseek(f, 0, SEEK_SET) == -1)
+	// map the file read-only since the JSON chunk is parsed
+	// in place and buffers are served from the mapping
+	void* data;
+	data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	if(data == MAP_FAILED)
 	{
-		LOGE("fseek_set fname=%s", fname);
-		goto fail_fseek_set;
+		LOGE("mmap fname=%s", fname);
+		goto fail_mmap;
 	}
 
-	gltf_file_t* self = gltf_file_openf(f, length);
+	gltf_file_t* self;
+	self = gltf_file_load((char*) data, length,
+	                      GLTF_FILEMODE_MMAP, lazy,
+	                      thread_count, fname);
 	if(self == NULL)
 	{
-		goto fail_openf;
+		goto fail_openb;
 	}
 
-	fclose(f);
+	// the mapping remains valid after the fd is closed
+	close(fd);
 
 	// success
 	return self;
 
 	// failure
-	fail_openf:
-	fail_fseek_set:
-	fail_fseek_end:
-		fclose(f);
+	fail_openb:
+		munmap(data, length);
+	fail_mmap:
+	fail_fstat:
+		close(fd);
 	return NULL;
 }
 
-gltf_file_t* gltf_file_openf(FILE* f, size_t length)
+static gltf_file_t*
+gltf_file_read(FILE* f, size_t length, const char* fname)
 {
 	ASSERT(f);
 
@@ -2599,7 +5972,8 @@ gltf_file_t* gltf_file_openf(FILE* f, size_t length)
 	}
 
 	gltf_file_t* self;
-	self = gltf_file_openb(data, length, GLTF_FILEMODE_OWNED);
+	self = gltf_file_load(data, length, GLTF_FILEMODE_OWNED,
+	                      0, 1, fname);
 	if(self == NULL)
 	{
 		goto fail_openb;
@@ -2615,183 +5989,144 @@ gltf_file_t* gltf_file_openf(FILE* f, size_t length)
 	return NULL;
 }
 
-gltf_file_t*
-gltf_file_openb(char* data, size_t size,
-                gltf_fileMode_e mode)
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_file_t* gltf_file_open(const char* fname)
 {
-	ASSERT(data);
+	ASSERT(fname);
 
-	// check minimum file size
-	if(size < sizeof(gltf_header_t))
+	FILE* f = fopen(fname, "r");
+	if(f == NULL)
 	{
-		LOGE("invalid size=%" PRIu64, (uint64_t) size);
+		LOGE("fopen %s failed", fname);
 		return NULL;
 	}
 
-	gltf_file_t* self;
-	self = (gltf_file_t*) CALLOC(1, sizeof(gltf_file_t));
-	if(self == NULL)
+	// get file lenth
+	if(fseek(f, (long) 0, SEEK_END) == -1)
 	{
-		LOGE("CALLOC failed");
-		return NULL;
+		LOGE("fseek_end fname=%s", fname);
+		goto fail_fseek_end;
 	}
+	size_t length = ftell(f);
 
-	self->mode   = mode;
-	self->length = size;
-
-	if(mode == GLTF_FILEMODE_COPY)
-	{
-		self->data = (char*) CALLOC(1, size);
-		if(self->data == NULL)
-		{
-			goto fail_data;
-		}
-		memcpy(self->data, data, size);
-	}
-	else
+	// rewind to start
+	if(fseek(f, 0, SEEK_SET) == -1)
 	{
-		self->data = data;
+		LOGE("fseek_set fname=%s", fname);
+		goto fail_fseek_set;
 	}
 
-	self->scenes = cc_list_new();
-	if(self->scenes == NULL)
+	gltf_file_t* self = gltf_file_read(f, length, fname);
+	if(self == NULL)
 	{
-		goto fail_scenes;
+		goto fail_read;
 	}
 
-	self->nodes = cc_list_new();
-	if(self->nodes == NULL)
-	{
-		goto fail_nodes;
-	}
+	fclose(f);
 
-	self->cameras = cc_list_new();
-	if(self->cameras == NULL)
-	{
-		goto fail_cameras;
-	}
+	// success
+	return self;
 
-	self->meshes = cc_list_new();
-	if(self->meshes == NULL)
-	{
-		goto fail_meshes;
-	}
+	// failure
+	fail_read:
+	fail_fseek_set:
+	fail_fseek_end:
+		fclose(f);
+	return NULL;
+}
 
-	self->materials = cc_list_new();
-	if(self->materials == NULL)
-	{
-		goto fail_materials;
-	}
+gltf_file_t* gltf_file_openf(FILE* f, size_t length)
+{
+	ASSERT(f);
+
+	return gltf_file_read(f, length, NULL);
+}
+
+gltf_file_t* gltf_file_openm(const char* fname)
+{
+	ASSERT(fname);
+
+	return gltf_file_map(fname, 0, 1);
+}
+
+gltf_file_t* gltf_file_openLazy(const char* fname)
+{
+	ASSERT(fname);
+
+	return gltf_file_map(fname, 1, 1);
+}
+
+gltf_file_t*
+gltf_file_openb(char* data, size_t size,
+                gltf_fileMode_e mode)
+{
+	ASSERT(data);
 
-	self->accessors = cc_list_new();
-	if(self->accessors == NULL)
+	if(mode == GLTF_FILEMODE_MMAP)
 	{
-		goto fail_accessors;
+		LOGE("invalid mode=%i", (int) mode);
+		return NULL;
 	}
 
-	self->textures = cc_list_new();
-	if(self->textures == NULL)
-	{
-		goto fail_textures;
-	}
+	return gltf_file_load(data, size, mode, 0, 1, NULL);
+}
 
-	self->bufferViews = cc_list_new();
-	if(self->bufferViews == NULL)
-	{
-		goto fail_bufferViews;
-	}
+gltf_file_t*
+gltf_file_openbLazy(char* data, size_t size,
+                    gltf_fileMode_e mode)
+{
+	ASSERT(data);
 
-	self->images = cc_list_new();
-	if(self->images == NULL)
+	if(mode == GLTF_FILEMODE_MMAP)
 	{
-		goto fail_images;
+		LOGE("invalid mode=%i", (int) mode);
+		return NULL;
 	}
 
-	self->buffers = cc_list_new();
-	if(self->buffers == NULL)
-	{
-		goto fail_buffers;
-	}
+	return gltf_file_load(data, size, mode, 1, 1, NULL);
+}
 
-	// parse header
-	if(gltf_file_parseHeader(self) == 0)
+uint32_t gltf_file_threadCount(uint32_t thread_count)
+{
+	// use one thread per online processor by default
+	if(thread_count == 0)
 	{
-		goto fail_header;
+		long n = sysconf(_SC_NPROCESSORS_ONLN);
+		thread_count = (n > 0) ? (uint32_t) n : 1;
 	}
 
-	// parse chunks
-	uint32_t chunk  = 0;
-	size_t   offset = sizeof(gltf_header_t);
-	while(offset < self->length)
-	{
-		if(chunk == 0)
-		{
-			if(gltf_file_parseChunk(self, &offset,
-			                        GLTF_CHUNK_TYPE_JSON) == 0)
-			{
-				goto fail_chunk;
-			}
-		}
-		else if(chunk == 1)
-		{
-			if(gltf_file_parseChunk(self, &offset,
-			                        GLTF_CHUNK_TYPE_BIN) == 0)
-			{
-				goto fail_chunk;
-			}
-		}
-		else
-		{
-			LOGE("invalid chunk=%u", chunk);
-			goto fail_chunk;
-		}
+	return thread_count;
+}
 
-		++chunk;
-	}
+gltf_file_t*
+gltf_file_openParallel(const char* fname,
+                       uint32_t thread_count)
+{
+	ASSERT(fname);
 
-	// ensure json + bin chunks exist
-	if(chunk != 2)
-	{
-		LOGE("invalid chunk=%u", chunk);
-		goto fail_chunk;
-	}
+	return gltf_file_map(fname, 0,
+	                     gltf_file_threadCount(thread_count));
+}
 
-	// success
-	return self;
+gltf_file_t*
+gltf_file_openbParallel(char* data, size_t size,
+                        gltf_fileMode_e mode,
+                        uint32_t thread_count)
+{
+	ASSERT(data);
 
-	// failure
-	fail_chunk:
-		gltf_file_discard(self);
-	fail_header:
-		cc_list_delete(&self->buffers);
-	fail_buffers:
-		cc_list_delete(&self->images);
-	fail_images:
-		cc_list_delete(&self->bufferViews);
-	fail_bufferViews:
-		cc_list_delete(&self->textures);
-	fail_textures:
-		cc_list_delete(&self->accessors);
-	fail_accessors:
-		cc_list_delete(&self->materials);
-	fail_materials:
-		cc_list_delete(&self->meshes);
-	fail_meshes:
-		cc_list_delete(&self->cameras);
-	fail_cameras:
-		cc_list_delete(&self->nodes);
-	fail_nodes:
-		cc_list_delete(&self->scenes);
-	fail_scenes:
+	if(mode == GLTF_FILEMODE_MMAP)
 	{
-		if(self->mode == GLTF_FILEMODE_COPY)
-		{
-			FREE(self->data);
-		}
+		LOGE("invalid mode=%i", (int) mode);
+		return NULL;
 	}
-	fail_data:
-		FREE(self);
-	return NULL;
+
+	return gltf_file_load(data, size, mode, 0,
+	                      gltf_file_threadCount(thread_count),
+	                      NULL);
 }
 
 void gltf_file_close(gltf_file_t** _self)
@@ -2801,22 +6136,20 @@ void gltf_file_close(gltf_file_t** _self)
 	gltf_file_t* self = *_self;
 	if(self)
 	{
-		gltf_file_discard(self);
-		cc_list_delete(&self->buffers);
-		cc_list_delete(&self->images);
-		cc_list_delete(&self->bufferViews);
-		cc_list_delete(&self->textures);
-		cc_list_delete(&self->accessors);
-		cc_list_delete(&self->materials);
-		cc_list_delete(&self->meshes);
-		cc_list_delete(&self->cameras);
-		cc_list_delete(&self->nodes);
-		cc_list_delete(&self->scenes);
+		gltf_file_unmapBuffers(self);
+		gltf_lazy_delete(&self->lazy);
+		gltf_strings_delete(&self->strings);
+		gltf_arena_delete(&self->arena);
 		if((self->mode == GLTF_FILEMODE_COPY) ||
 		   (self->mode == GLTF_FILEMODE_OWNED))
 		{
 			FREE(self->data);
 		}
+		else if(self->mode == GLTF_FILEMODE_MMAP)
+		{
+			munmap((void*) self->data, self->length);
+		}
+		pthread_mutex_destroy(&self->mutex);
 		FREE(self);
 		*_self = NULL;
 	}
@@ -2828,15 +6161,19 @@ gltf_file_getScene(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->scenes, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->scene_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_scene_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_SCENES,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->scenes[idx];
 }
 
 gltf_node_t*
@@ -2845,15 +6182,19 @@ gltf_file_getNode(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->nodes, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->node_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_node_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_NODES,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->nodes[idx];
 }
 
 gltf_camera_t*
@@ -2862,15 +6203,19 @@ gltf_file_getCamera(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->cameras, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->camera_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_camera_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_CAMERAS,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->cameras[idx];
 }
 
 gltf_mesh_t*
@@ -2879,15 +6224,19 @@ gltf_file_getMesh(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->meshes, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->mesh_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_mesh_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_MESHES,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->meshes[idx];
 }
 
 gltf_material_t*
@@ -2896,15 +6245,19 @@ gltf_file_getMaterial(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->materials, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->material_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_material_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_MATERIALS,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->materials[idx];
 }
 
 gltf_accessor_t*
@@ -2913,15 +6266,19 @@ gltf_file_getAccessor(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->accessors, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->accessor_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_accessor_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_ACCESSORS,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->accessors[idx];
 }
 
 gltf_texture_t*
@@ -2930,15 +6287,19 @@ gltf_file_getTexture(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->textures, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->texture_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_texture_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_TEXTURES,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->textures[idx];
 }
 
 gltf_bufferView_t*
@@ -2947,15 +6308,19 @@ gltf_file_getBufferView(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->bufferViews, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->bufferView_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_bufferView_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_BUFFER_VIEWS,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->bufferViews[idx];
 }
 
 gltf_image_t*
@@ -2964,15 +6329,61 @@ gltf_file_getImage(gltf_file_t* self,
 {
 	ASSERT(self);
 
-	cc_listIter_t* iter;
-	iter = cc_list_get(self->images, (int) idx);
-	if(iter == NULL)
+	if(idx >= self->image_count)
+	{
+		LOGE("invalid idx=%u", idx);
+		return NULL;
+	}
+
+	if(gltf_file_parseLazy(self, GLTF_SECTION_IMAGES,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->images[idx];
+}
+
+gltf_animation_t*
+gltf_file_getAnimation(gltf_file_t* self,
+                       uint32_t idx)
+{
+	ASSERT(self);
+
+	if(idx >= self->animation_count)
+	{
+		LOGE("invalid idx=%u", idx);
+		return NULL;
+	}
+
+	if(gltf_file_parseLazy(self, GLTF_SECTION_ANIMATIONS,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->animations[idx];
+}
+
+gltf_skin_t*
+gltf_file_getSkin(gltf_file_t* self,
+                  uint32_t idx)
+{
+	ASSERT(self);
+
+	if(idx >= self->skin_count)
 	{
 		LOGE("invalid idx=%u", idx);
 		return NULL;
 	}
 
-	return (gltf_image_t*) cc_list_peekIter(iter);
+	if(gltf_file_parseLazy(self, GLTF_SECTION_SKINS,
+	                       idx) == 0)
+	{
+		return NULL;
+	}
+
+	return &self->skins[idx];
 }
 
 const char*
@@ -2982,20 +6393,265 @@ gltf_file_getBuffer(gltf_file_t* self,
 	ASSERT(self);
 	ASSERT(bufferView);
 
-	if(bufferView->buffer != 0)
+	if(bufferView->buffer >= self->buffer_count)
 	{
-		LOGE("unsupported buffer=%u", bufferView->buffer);
+		LOGE("invalid buffer=%u", bufferView->buffer);
 		return NULL;
 	}
 
-	// compute the offset to buffer
-	gltf_chunk_t* chunk;
-	size_t        offset = sizeof(gltf_header_t);
-	chunk   = (gltf_chunk_t*) &self->data[offset];
-	offset += sizeof(gltf_chunk_t) + chunk->chunkLength;
-	chunk   = (gltf_chunk_t*) &self->data[offset];
-	offset += sizeof(gltf_chunk_t);
-	offset += bufferView->byteOffset;
+	// check that the bufferView is within the buffer
+	gltf_buffer_t* buffer = &self->buffers[bufferView->buffer];
+	uint64_t       end    = (uint64_t) bufferView->byteOffset +
+	                        (uint64_t) bufferView->byteLength;
+	if(end > buffer->byteLength)
+	{
+		LOGE("invalid byteOffset=%u, byteLength=%u, buffer byteLength=%u",
+		     bufferView->byteOffset, bufferView->byteLength,
+		     buffer->byteLength);
+		return NULL;
+	}
+
+	// embedded buffers of lazy files are decoded on demand
+	if(self->lazy)
+	{
+		pthread_mutex_lock(&self->mutex);
+		int ret = 1;
+		if(buffer->data == NULL)
+		{
+			ret = gltf_file_decodeBuffer(self, buffer);
+		}
+		pthread_mutex_unlock(&self->mutex);
+
+		if(ret == 0)
+		{
+			return NULL;
+		}
+	}
+
+	return &buffer->data[bufferView->byteOffset];
+}
+
+const char*
+gltf_file_getImageData(gltf_file_t* self,
+                       gltf_image_t* image,
+                       uint32_t* _size)
+{
+	ASSERT(self);
+	ASSERT(image);
+	ASSERT(_size);
+
+	if(image->has_bufferView)
+	{
+		gltf_bufferView_t* bufferView;
+		bufferView = gltf_file_getBufferView(self,
+		                                     image->bufferView);
+		if(bufferView == NULL)
+		{
+			return NULL;
+		}
+
+		*_size = bufferView->byteLength;
+		return gltf_file_getBuffer(self, bufferView);
+	}
+	else if(image->embedded)
+	{
+		pthread_mutex_lock(&self->mutex);
+		int ret = 1;
+		if(image->data == NULL)
+		{
+			ret = gltf_file_decodeEmbedded(self, image->embedded,
+			                               image->embedded_length,
+			                               &image->data,
+			                               &image->size);
+		}
+		pthread_mutex_unlock(&self->mutex);
+
+		if(ret == 0)
+		{
+			return NULL;
+		}
+
+		*_size = image->size;
+		return image->data;
+	}
+
+	LOGE("unsupported uri=%s", image->uri ? image->uri : "");
+	return NULL;
+}
+
+const char*
+gltf_file_findString(gltf_file_t* self, const char* str)
+{
+	ASSERT(self);
+	ASSERT(str);
+
+	// lazy parsing may intern strings concurrently
+	if(self->lazy == NULL)
+	{
+		return gltf_strings_find(self->strings, str,
+		                         (uint32_t) strlen(str));
+	}
+
+	pthread_mutex_lock(&self->mutex);
+	const char* found;
+	found = gltf_strings_find(self->strings, str,
+	                          (uint32_t) strlen(str));
+	pthread_mutex_unlock(&self->mutex);
+
+	return found;
+}
+
+gltf_attribute_t*
+gltf_primitive_getAttribute(gltf_primitive_t* self,
+                            gltf_attributeType_e type,
+                            uint32_t set)
+{
+	ASSERT(self);
+
+	uint32_t i;
+	for(i = 0; i < self->attribute_count; ++i)
+	{
+		gltf_attribute_t* attribute = &self->attributes[i];
+		if((attribute->type == type) && (attribute->set == set))
+		{
+			return attribute;
+		}
+	}
+
+	return NULL;
+}
+
+gltf_attribute_t*
+gltf_morphTarget_getAttribute(gltf_morphTarget_t* self,
+                              gltf_attributeType_e type)
+{
+	ASSERT(self);
+
+	uint32_t i;
+	for(i = 0; i < self->attribute_count; ++i)
+	{
+		gltf_attribute_t* attribute = &self->attributes[i];
+		if(attribute->type == type)
+		{
+			return attribute;
+		}
+	}
+
+	return NULL;
+}
+
+void gltf_mat4f_composeTRS(cc_mat4f_t* self,
+                           const cc_vec3f_t* t,
+                           const cc_vec4f_t* r,
+                           const cc_vec3f_t* s)
+{
+	ASSERT(self);
+	ASSERT(t);
+	ASSERT(r);
+	ASSERT(s);
+
+	float xx = r->x*r->x;
+	float yy = r->y*r->y;
+	float zz = r->z*r->z;
+	float xy = r->x*r->y;
+	float xz = r->x*r->z;
+	float yz = r->y*r->z;
+	float wx = r->w*r->x;
+	float wy = r->w*r->y;
+	float wz = r->w*r->z;
+
+	// the columns of R are scaled by S
+	self->m00 = (1.0f - 2.0f*(yy + zz))*s->x;
+	self->m10 = 2.0f*(xy + wz)*s->x;
+	self->m20 = 2.0f*(xz - wy)*s->x;
+	self->m30 = 0.0f;
+	self->m01 = 2.0f*(xy - wz)*s->y;
+	self->m11 = (1.0f - 2.0f*(xx + zz))*s->y;
+	self->m21 = 2.0f*(yz + wx)*s->y;
+	self->m31 = 0.0f;
+	self->m02 = 2.0f*(xz + wy)*s->z;
+	self->m12 = 2.0f*(yz - wx)*s->z;
+	self->m22 = (1.0f - 2.0f*(xx + yy))*s->z;
+	self->m32 = 0.0f;
+	self->m03 = t->x;
+	self->m13 = t->y;
+	self->m23 = t->z;
+	self->m33 = 1.0f;
+}
+
+const uint32_t*
+gltf_file_getNodeChildren(gltf_file_t* self,
+                          gltf_node_t* node)
+{
+	ASSERT(self);
+	ASSERT(node);
+
+	if(node->child_count == 0)
+	{
+		return NULL;
+	}
+
+	return node->children;
+}
+
+const uint32_t*
+gltf_file_getSceneNodes(gltf_file_t* self,
+                        gltf_scene_t* scene)
+{
+	ASSERT(self);
+	ASSERT(scene);
+
+	if(scene->node_count == 0)
+	{
+		return NULL;
+	}
+
+	return scene->nodes;
+}
+
+const uint32_t*
+gltf_file_getSkinJoints(gltf_file_t* self,
+                        gltf_skin_t* skin)
+{
+	ASSERT(self);
+	ASSERT(skin);
+
+	if(skin->joint_count == 0)
+	{
+		return NULL;
+	}
+
+	return skin->joints;
+}
+
+const float*
+gltf_file_getNodeWeights(gltf_file_t* self,
+                         gltf_node_t* node,
+                         uint32_t* _count)
+{
+	ASSERT(self);
+	ASSERT(node);
+	ASSERT(_count);
+
+	*_count = 0;
+
+	if(node->weight_count)
+	{
+		*_count = node->weight_count;
+		return node->weights;
+	}
+
+	if(node->has_mesh == 0)
+	{
+		return NULL;
+	}
+
+	gltf_mesh_t* mesh = gltf_file_getMesh(self, node->mesh);
+	if((mesh == NULL) || (mesh->weight_count == 0))
+	{
+		return NULL;
+	}
 
-	return &self->data[offset];
+	*_count = mesh->weight_count;
+	return mesh->weights;
 }
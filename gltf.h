@@ -25,19 +25,25 @@
 #define gltf_H
 
 #include <inttypes.h>
+#include <pthread.h>
 #include <stdio.h>
 
 #include "../libcc/math/cc_mat4f.h"
 #include "../libcc/math/cc_vec3f.h"
 #include "../libcc/math/cc_vec4f.h"
-#include "../libcc/cc_list.h"
+#include "gltf_arena.h"
+#include "gltf_strings.h"
 
+// names are interned in the file string pool so names
+// from the same file may be compared by pointer
+// index lists (e.g. scene nodes) are allocated from the
+// file arena so they remain valid until the file is closed
 typedef struct gltf_scene_s
 {
-	char name[256];
+	const char* name;
 
-	// uint nd ptrs
-	cc_list_t* nodes;
+	uint32_t  node_count;
+	uint32_t* nodes;
 } gltf_scene_t;
 
 typedef struct gltf_node_s
@@ -46,16 +52,31 @@ typedef struct gltf_node_s
 	{
 		unsigned int has_mesh   : 1;
 		unsigned int has_camera : 1;
-		unsigned int has_pad    : 29;
+		unsigned int has_matrix : 1;
+		unsigned int has_skin   : 1;
+		unsigned int has_pad    : 27;
 	};
 
-	char name[256];
+	const char* name;
 
-	// uint nd ptrs
-	cc_list_t* children;
+	uint32_t   child_count;
+	uint32_t*  children;
+
+	// the TRS is retained (rotation is the quaternion x,y,z,w)
+	// unless has_matrix is set in which case the TRS is
+	// the identity and the matrix is used as specified
+	cc_vec3f_t translation;
+	cc_vec4f_t rotation;
+	cc_vec3f_t scale;
 	cc_mat4f_t matrix; // M=T*R*S
+
 	uint32_t   mesh;
 	uint32_t   camera;
+	uint32_t   skin;
+
+	// morph target weights which override the mesh weights
+	uint32_t   weight_count;
+	float*     weights;
 } gltf_node_t;
 
 typedef enum
@@ -91,12 +112,34 @@ typedef struct gltf_camera_s
 	};
 } gltf_camera_t;
 
+typedef enum
+{
+	GLTF_ATTRIBUTE_TYPE_UNKNOWN,
+	GLTF_ATTRIBUTE_TYPE_POSITION,
+	GLTF_ATTRIBUTE_TYPE_NORMAL,
+	GLTF_ATTRIBUTE_TYPE_TANGENT,
+	GLTF_ATTRIBUTE_TYPE_TEXCOORD,
+	GLTF_ATTRIBUTE_TYPE_COLOR,
+	GLTF_ATTRIBUTE_TYPE_JOINTS,
+	GLTF_ATTRIBUTE_TYPE_WEIGHTS,
+} gltf_attributeType_e;
+
 typedef struct gltf_attribute_s
 {
-	char     name[256];
-	uint32_t accessor;
+	gltf_attributeType_e type;
+	uint32_t             set; // e.g. TEXCOORD_1
+	const char*          name;
+	uint32_t             accessor;
 } gltf_attribute_t;
 
+// morph targets contain the displacements of the
+// primitive attributes (e.g. POSITION, NORMAL and TANGENT)
+typedef struct gltf_morphTarget_s
+{
+	uint32_t          attribute_count;
+	gltf_attribute_t* attributes;
+} gltf_morphTarget_t;
+
 typedef enum
 {
 	GLTF_PRIMITIVE_MODE_POINTS,
@@ -120,14 +163,20 @@ typedef struct gltf_primitive_s
 	gltf_primitiveMode_e mode;
 	uint32_t             indices;
 	uint32_t             material;
-	cc_list_t*           attributes;
-	// TODO - targets
+	uint32_t             attribute_count;
+	gltf_attribute_t*    attributes;
+	uint32_t             target_count;
+	gltf_morphTarget_t*  targets;
 } gltf_primitive_t;
 
 typedef struct gltf_mesh_s
 {
-	cc_list_t* primitives;
-	// TODO - weights
+	uint32_t          primitive_count;
+	gltf_primitive_t* primitives;
+
+	// default morph target weights
+	uint32_t          weight_count;
+	float*            weights;
 } gltf_mesh_t;
 
 typedef struct gltf_materialTexture_s
@@ -213,13 +262,31 @@ typedef enum
 	GLTF_COMPONENT_TYPE_FLOAT          = 0x1406, // 5126
 } gltf_componentType_e;
 
+// sparse indices/values are tightly packed and the values
+// match the accessor type/componentType
+typedef struct gltf_accessorSparse_s
+{
+	uint32_t count;
+
+	// indices
+	uint32_t             indices_bufferView;
+	uint32_t             indices_byteOffset;
+	gltf_componentType_e indices_componentType;
+
+	// values
+	uint32_t values_bufferView;
+	uint32_t values_byteOffset;
+} gltf_accessorSparse_t;
+
 typedef struct gltf_accessor_s
 {
 	struct
 	{
 		unsigned int has_bufferView : 1;
 		unsigned int has_minMax     : 1;
-		unsigned int has_pad        : 30;
+		unsigned int normalized     : 1;
+		unsigned int has_sparse     : 1;
+		unsigned int has_pad        : 28;
 	};
 
 	uint32_t bufferView;
@@ -234,7 +301,7 @@ typedef struct gltf_accessor_s
 	float min[4];
 	float max[4];
 
-	// TODO - sparse and indices blocks
+	gltf_accessorSparse_t sparse;
 } gltf_accessor_t;
 
 typedef struct gltf_texture_s
@@ -281,35 +348,158 @@ typedef struct gltf_image_s
 
 	uint32_t bufferView;
 
+	// external images are referenced by uri relative to the
+	// path of the opened file (NULL for bufferView images)
+	const char* uri;
+
+	// base64 data: URI which references the JSON and is
+	// decoded on the first gltf_file_getImageData call
+	const char* embedded;
+	uint32_t    embedded_length;
+	const char* data;
+	uint32_t    size;
+
 	gltf_imageType_e type;
 } gltf_image_t;
 
 typedef struct gltf_buffer_s
 {
-	uint32_t byteLength;
+	uint32_t    byteLength;
+	const char* uri;
+
+	// base64 data: URI which references the JSON and is
+	// decoded into the arena when the file is opened or on
+	// the first gltf_file_getBuffer call for lazy files
+	const char* embedded;
+	uint32_t    embedded_length;
+
+	// base address resolved from the BIN chunk (uri and
+	// embedded are NULL), the embedded data or an external
+	// file which is mapped relative to the opened file
+	const char* data;
+	size_t      map_length;
 } gltf_buffer_t;
 
+typedef enum
+{
+	GLTF_ANIMATION_PATH_UNKNOWN,
+	GLTF_ANIMATION_PATH_TRANSLATION,
+	GLTF_ANIMATION_PATH_ROTATION,
+	GLTF_ANIMATION_PATH_SCALE,
+	GLTF_ANIMATION_PATH_WEIGHTS,
+} gltf_animationPath_e;
+
+typedef struct gltf_animationChannel_s
+{
+	struct
+	{
+		unsigned int has_node : 1;
+		unsigned int has_pad  : 31;
+	};
+
+	// sampler index is relative to the animation
+	uint32_t             sampler;
+	uint32_t             node;
+	gltf_animationPath_e path;
+} gltf_animationChannel_t;
+
+typedef enum
+{
+	GLTF_ANIMATION_INTERPOLATION_LINEAR,
+	GLTF_ANIMATION_INTERPOLATION_STEP,
+	GLTF_ANIMATION_INTERPOLATION_CUBICSPLINE,
+} gltf_animationInterpolation_e;
+
+typedef struct gltf_animationSampler_s
+{
+	uint32_t                      input;  // keyframe times
+	uint32_t                      output; // keyframe values
+	gltf_animationInterpolation_e interpolation;
+} gltf_animationSampler_t;
+
+typedef struct gltf_animation_s
+{
+	const char* name;
+
+	uint32_t                 channel_count;
+	gltf_animationChannel_t* channels;
+	uint32_t                 sampler_count;
+	gltf_animationSampler_t* samplers;
+} gltf_animation_t;
+
+typedef struct gltf_skin_s
+{
+	struct
+	{
+		unsigned int has_inverseBindMatrices : 1;
+		unsigned int has_skeleton            : 1;
+		unsigned int has_pad                 : 30;
+	};
+
+	const char* name;
+
+	uint32_t  joint_count;
+	uint32_t* joints;
+
+	// MAT4 accessor (identity matrices when absent)
+	uint32_t inverseBindMatrices;
+	uint32_t skeleton;
+} gltf_skin_t;
+
+// MMAP is set by gltf_file_openm and is rejected by the
+// openb functions since the data is not owned by a mapping
 typedef enum
 {
 	GLTF_FILEMODE_OWNED,
 	GLTF_FILEMODE_COPY,
 	GLTF_FILEMODE_REFERENCE,
+	GLTF_FILEMODE_MMAP,
 } gltf_fileMode_e;
 
 typedef struct gltf_file_s
 {
-	uint32_t   scene;
-	cc_list_t* scenes;
-	cc_list_t* nodes;
-	cc_list_t* cameras;
-	cc_list_t* meshes;
-	cc_list_t* materials;
-	cc_list_t* accessors;
-	cc_list_t* textures;
-	cc_list_t* bufferViews;
-	cc_list_t* images;
-	cc_list_t* buffers;
-	// TODO - samplers, skins and animations
+	uint32_t scene;
+
+	// contiguous arrays indexed by the glTF index
+	uint32_t           scene_count;
+	uint32_t           node_count;
+	uint32_t           camera_count;
+	uint32_t           mesh_count;
+	uint32_t           material_count;
+	uint32_t           accessor_count;
+	uint32_t           texture_count;
+	uint32_t           bufferView_count;
+	uint32_t           image_count;
+	uint32_t           buffer_count;
+	uint32_t           animation_count;
+	uint32_t           skin_count;
+	gltf_scene_t*      scenes;
+	gltf_node_t*       nodes;
+	gltf_camera_t*     cameras;
+	gltf_mesh_t*       meshes;
+	gltf_material_t*   materials;
+	gltf_accessor_t*   accessors;
+	gltf_texture_t*    textures;
+	gltf_bufferView_t* bufferViews;
+	gltf_image_t*      images;
+	gltf_buffer_t*     buffers;
+	gltf_animation_t*  animations;
+	gltf_skin_t*       skins;
+	// TODO - samplers
+
+	// owns all parsed objects
+	gltf_arena_t*   arena;
+	gltf_strings_t* strings;
+
+	// lazy mode index of the top-level array elements which
+	// are parsed on the first gltf_file_get* call
+	// the arrays above are zeroed until the element has been
+	// parsed so lazy files must be accessed via the getters
+	struct gltf_lazy_s* lazy;
+
+	// serializes the lazy parsing of elements and the
+	// decoding of embedded buffers and images on demand
+	pthread_mutex_t mutex;
 
 	// file data
 	gltf_fileMode_e mode;
@@ -317,10 +507,32 @@ typedef struct gltf_file_s
 	char*           data;
 } gltf_file_t;
 
+// files may be GLB containers or text glTF files which
+// are identified by the GLB magic
 gltf_file_t*       gltf_file_open(const char* fname);
 gltf_file_t*       gltf_file_openf(FILE* f, size_t size);
+gltf_file_t*       gltf_file_openm(const char* fname);
 gltf_file_t*       gltf_file_openb(char* data, size_t size,
                                    gltf_fileMode_e mode);
+// the getters of lazy files may be called from multiple
+// threads since parsing on demand is serialized by the
+// file mutex
+gltf_file_t*       gltf_file_openLazy(const char* fname);
+gltf_file_t*       gltf_file_openbLazy(char* data, size_t size,
+                                       gltf_fileMode_e mode);
+
+// resolve a thread_count where 0 selects one thread per
+// online processor
+uint32_t           gltf_file_threadCount(uint32_t thread_count);
+
+// parse the elements of the top-level arrays across
+// thread_count threads (0 for one per processor) which
+// produces a file equivalent to gltf_file_openm/openb
+gltf_file_t*       gltf_file_openParallel(const char* fname,
+                                          uint32_t thread_count);
+gltf_file_t*       gltf_file_openbParallel(char* data, size_t size,
+                                           gltf_fileMode_e mode,
+                                           uint32_t thread_count);
 void               gltf_file_close(gltf_file_t** _self);
 gltf_scene_t*      gltf_file_getScene(gltf_file_t* self,
                                       uint32_t idx);
@@ -340,7 +552,40 @@ gltf_bufferView_t* gltf_file_getBufferView(gltf_file_t* self,
                                            uint32_t idx);
 gltf_image_t*      gltf_file_getImage(gltf_file_t* self,
                                       uint32_t idx);
+gltf_animation_t*  gltf_file_getAnimation(gltf_file_t* self,
+                                          uint32_t idx);
+gltf_skin_t*       gltf_file_getSkin(gltf_file_t* self,
+                                     uint32_t idx);
 const char*        gltf_file_getBuffer(gltf_file_t* self,
                                        gltf_bufferView_t* bufferView);
+const char*        gltf_file_getImageData(gltf_file_t* self,
+                                          gltf_image_t* image,
+                                          uint32_t* _size);
+const char*        gltf_file_findString(gltf_file_t* self,
+                                        const char* str);
+const uint32_t*    gltf_file_getNodeChildren(gltf_file_t* self,
+                                             gltf_node_t* node);
+const uint32_t*    gltf_file_getSceneNodes(gltf_file_t* self,
+                                           gltf_scene_t* scene);
+const uint32_t*    gltf_file_getSkinJoints(gltf_file_t* self,
+                                           gltf_skin_t* skin);
+
+// morph target weights of the node or the default weights
+// of the node mesh (NULL when neither are specified)
+const float*       gltf_file_getNodeWeights(gltf_file_t* self,
+                                            gltf_node_t* node,
+                                            uint32_t* _count);
+
+gltf_attribute_t* gltf_primitive_getAttribute(gltf_primitive_t* self,
+                                              gltf_attributeType_e type,
+                                              uint32_t set);
+gltf_attribute_t* gltf_morphTarget_getAttribute(gltf_morphTarget_t* self,
+                                                gltf_attributeType_e type);
+
+// compose M=T*R*S where r is a unit quaternion (x,y,z,w)
+void              gltf_mat4f_composeTRS(cc_mat4f_t* self,
+                                        const cc_vec3f_t* t,
+                                        const cc_vec4f_t* r,
+                                        const cc_vec3f_t* s);
 
 #endif
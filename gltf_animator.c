@@ -0,0 +1,816 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_animator.h"
+#include "gltf_decode.h"
+
+// keyframes checked by the cursor before falling back to
+// a binary search
+#define GLTF_ANIMATOR_WALK 4
+
+/***********************************************************
+* private - kernels                                        *
+***********************************************************/
+
+// the kernels operate on stride floats which is a multiple
+// of 4 such that each value is a whole number of registers
+
+static void
+gltf_animator_blend2(uint32_t stride,
+                     float wa, const float* a,
+                     float wb, const float* b,
+                     float* out)
+{
+	ASSERT(a);
+	ASSERT(b);
+	ASSERT(out);
+
+	uint32_t i;
+	#if defined(__SSE2__)
+	__m128 va = _mm_set1_ps(wa);
+	__m128 vb = _mm_set1_ps(wb);
+	for(i = 0; i < stride; i += 4)
+	{
+		__m128 x = _mm_mul_ps(_mm_loadu_ps(&a[i]), va);
+		__m128 y = _mm_mul_ps(_mm_loadu_ps(&b[i]), vb);
+		_mm_storeu_ps(&out[i], _mm_add_ps(x, y));
+	}
+	#elif defined(__ARM_NEON)
+	for(i = 0; i < stride; i += 4)
+	{
+		float32x4_t x = vmulq_n_f32(vld1q_f32(&a[i]), wa);
+		vst1q_f32(&out[i], vmlaq_n_f32(x, vld1q_f32(&b[i]), wb));
+	}
+	#else
+	for(i = 0; i < stride; ++i)
+	{
+		out[i] = wa*a[i] + wb*b[i];
+	}
+	#endif
+}
+
+static void
+gltf_animator_blend4(uint32_t stride,
+                     float wa, const float* a,
+                     float wb, const float* b,
+                     float wc, const float* c,
+                     float wd, const float* d,
+                     float* out)
+{
+	ASSERT(a);
+	ASSERT(b);
+	ASSERT(c);
+	ASSERT(d);
+	ASSERT(out);
+
+	uint32_t i;
+	#if defined(__SSE2__)
+	__m128 va = _mm_set1_ps(wa);
+	__m128 vb = _mm_set1_ps(wb);
+	__m128 vc = _mm_set1_ps(wc);
+	__m128 vd = _mm_set1_ps(wd);
+	for(i = 0; i < stride; i += 4)
+	{
+		__m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&a[i]), va),
+		                      _mm_mul_ps(_mm_loadu_ps(&b[i]), vb));
+		__m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&c[i]), vc),
+		                      _mm_mul_ps(_mm_loadu_ps(&d[i]), vd));
+		_mm_storeu_ps(&out[i], _mm_add_ps(x, y));
+	}
+	#elif defined(__ARM_NEON)
+	for(i = 0; i < stride; i += 4)
+	{
+		float32x4_t x = vmulq_n_f32(vld1q_f32(&a[i]), wa);
+		x = vmlaq_n_f32(x, vld1q_f32(&b[i]), wb);
+		x = vmlaq_n_f32(x, vld1q_f32(&c[i]), wc);
+		vst1q_f32(&out[i], vmlaq_n_f32(x, vld1q_f32(&d[i]), wd));
+	}
+	#else
+	for(i = 0; i < stride; ++i)
+	{
+		out[i] = wa*a[i] + wb*b[i] + wc*c[i] + wd*d[i];
+	}
+	#endif
+}
+
+static void gltf_animator_normalize(float* q)
+{
+	ASSERT(q);
+
+	float len2 = q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
+	if(len2 > 0.0f)
+	{
+		float s = 1.0f/sqrtf(len2);
+		q[0] *= s;
+		q[1] *= s;
+		q[2] *= s;
+		q[3] *= s;
+	}
+}
+
+static void
+gltf_animator_slerp(const float* a, const float* b, float u,
+                    float* out)
+{
+	ASSERT(a);
+	ASSERT(b);
+	ASSERT(out);
+
+	// interpolate along the shortest path
+	float d  = a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3];
+	float sb = 1.0f;
+	if(d < 0.0f)
+	{
+		d  = -d;
+		sb = -1.0f;
+	}
+
+	// nlerp is used for nearly parallel quaternions where
+	// the slerp weights are unstable
+	if(d > 0.9995f)
+	{
+		gltf_animator_blend2(4, 1.0f - u, a, sb*u, b, out);
+		gltf_animator_normalize(out);
+		return;
+	}
+
+	float theta = acosf(d);
+	float s     = 1.0f/sinf(theta);
+	float wa    = sinf((1.0f - u)*theta)*s;
+	float wb    = sinf(u*theta)*s;
+	gltf_animator_blend2(4, wa, a, sb*wb, b, out);
+}
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static uint32_t
+gltf_animator_seek(const float* times, uint32_t last,
+                   uint32_t cursor, float time)
+{
+	ASSERT(times);
+	ASSERT(last > 0);
+
+	// find the keyframe k in [0,last) such that
+	// times[k] <= time < times[k + 1] given that
+	// times[0] < time < times[last]
+	if(cursor >= last)
+	{
+		cursor = last - 1;
+	}
+
+	uint32_t lo;
+	uint32_t hi;
+	if(time >= times[cursor])
+	{
+		// time typically advances by less than a keyframe
+		// per evaluation so walk forward from the cursor
+		uint32_t i;
+		for(i = 0; i < GLTF_ANIMATOR_WALK; ++i)
+		{
+			if((cursor + 1 == last) ||
+			   (time < times[cursor + 1]))
+			{
+				return cursor;
+			}
+			++cursor;
+		}
+		lo = cursor;
+		hi = last - 1;
+	}
+	else
+	{
+		// time > times[0] so the cursor is non-zero
+		lo = 0;
+		hi = cursor - 1;
+	}
+
+	// largest k in [lo,hi] such that times[k] <= time
+	while(lo < hi)
+	{
+		uint32_t mid = lo + (hi - lo + 1)/2;
+		if(times[mid] <= time)
+		{
+			lo = mid;
+		}
+		else
+		{
+			hi = mid - 1;
+		}
+	}
+
+	return lo;
+}
+
+static void
+gltf_animator_evaluate(gltf_animatorSampler_t* sampler,
+                       int rotation, float time,
+                       uint32_t* _cursor, float* out)
+{
+	ASSERT(sampler);
+	ASSERT(_cursor);
+	ASSERT(out);
+
+	uint32_t     stride = sampler->stride;
+	uint32_t     last   = sampler->key_count - 1;
+	const float* times  = sampler->times;
+	const float* values = sampler->values;
+	size_t       size   = stride*sizeof(float);
+
+	// the value of a CUBICSPLINE keyframe is the middle of
+	// the (in-tangent, value, out-tangent) triplet
+	int cubic = (sampler->interpolation ==
+	             GLTF_ANIMATION_INTERPOLATION_CUBICSPLINE);
+	uint32_t vs = cubic ? 3*stride : stride;
+	uint32_t vo = cubic ? stride : 0;
+
+	// clamp to the keyframes (including NaN times)
+	if((last == 0) || !(time > times[0]))
+	{
+		*_cursor = 0;
+		memcpy(out, &values[vo], size);
+		return;
+	}
+	else if(time >= times[last])
+	{
+		*_cursor = last - 1;
+		memcpy(out, &values[last*vs + vo], size);
+		return;
+	}
+
+	uint32_t k = gltf_animator_seek(times, last, *_cursor, time);
+	*_cursor = k;
+
+	const float* v0 = &values[k*vs + vo];
+	const float* v1 = &values[(k + 1)*vs + vo];
+	if(sampler->interpolation == GLTF_ANIMATION_INTERPOLATION_STEP)
+	{
+		memcpy(out, v0, size);
+		return;
+	}
+
+	float dt = times[k + 1] - times[k];
+	float u  = 0.0f;
+	if(dt > 0.0f)
+	{
+		u = (time - times[k])/dt;
+		u = (u > 1.0f) ? 1.0f : u;
+	}
+
+	if(cubic)
+	{
+		// Hermite spline where the out-tangent of k follows
+		// v0 and the in-tangent of k + 1 precedes v1
+		float u2  = u*u;
+		float u3  = u2*u;
+		float h00 = 2.0f*u3 - 3.0f*u2 + 1.0f;
+		float h10 = (u3 - 2.0f*u2 + u)*dt;
+		float h01 = -2.0f*u3 + 3.0f*u2;
+		float h11 = (u3 - u2)*dt;
+		gltf_animator_blend4(stride, h00, v0, h10, v0 + stride,
+		                     h01, v1, h11, v1 - stride, out);
+		if(rotation)
+		{
+			gltf_animator_normalize(out);
+		}
+	}
+	else if(rotation)
+	{
+		gltf_animator_slerp(v0, v1, u, out);
+	}
+	else
+	{
+		gltf_animator_blend2(stride, 1.0f - u, v0, u, v1, out);
+	}
+}
+
+static int
+gltf_animator_components(gltf_animationPath_e path,
+                         gltf_animationInterpolation_e interpolation,
+                         gltf_accessor_t* input,
+                         gltf_accessor_t* output,
+                         uint32_t* _components)
+{
+	ASSERT(input);
+	ASSERT(output);
+	ASSERT(_components);
+
+	if((input->type != GLTF_ACCESSOR_TYPE_SCALAR) ||
+	   (input->count == 0))
+	{
+		LOGE("invalid type=%u, count=%u",
+		     (uint32_t) input->type, input->count);
+		return 0;
+	}
+
+	uint64_t keys = input->count;
+	if(interpolation == GLTF_ANIMATION_INTERPOLATION_CUBICSPLINE)
+	{
+		keys *= 3;
+	}
+
+	// weights store the components of a keyframe as
+	// consecutive scalars
+	gltf_accessorType_e type;
+	uint32_t            components;
+	uint64_t            count;
+	if(path == GLTF_ANIMATION_PATH_ROTATION)
+	{
+		type       = GLTF_ACCESSOR_TYPE_VEC4;
+		components = 4;
+		count      = keys;
+	}
+	else if(path == GLTF_ANIMATION_PATH_WEIGHTS)
+	{
+		type       = GLTF_ACCESSOR_TYPE_SCALAR;
+		components = (uint32_t) (output->count/keys);
+		count      = keys*components;
+	}
+	else
+	{
+		type       = GLTF_ACCESSOR_TYPE_VEC3;
+		components = 3;
+		count      = keys;
+	}
+
+	if((output->type != type) || (components == 0) ||
+	   (output->count != count))
+	{
+		LOGE("invalid type=%u, count=%u, keys=%u",
+		     (uint32_t) output->type, output->count,
+		     (uint32_t) keys);
+		return 0;
+	}
+
+	*_components = components;
+	return 1;
+}
+
+static int
+gltf_animator_channels(gltf_animator_t* self,
+                       gltf_file_t* file,
+                       gltf_animation_t* animation,
+                       size_t* _data_count)
+{
+	ASSERT(self);
+	ASSERT(file);
+	ASSERT(animation);
+	ASSERT(_data_count);
+
+	size_t   data_count = 0;
+	uint32_t i;
+	for(i = 0; i < animation->channel_count; ++i)
+	{
+		gltf_animationChannel_t* ac = &animation->channels[i];
+		if((ac->has_node == 0) ||
+		   (ac->path == GLTF_ANIMATION_PATH_UNKNOWN))
+		{
+			continue;
+		}
+
+		gltf_node_t* node = gltf_file_getNode(file, ac->node);
+		if(node == NULL)
+		{
+			return 0;
+		}
+
+		// the TRS of nodes with a matrix may not be animated
+		if(node->has_matrix &&
+		   (ac->path != GLTF_ANIMATION_PATH_WEIGHTS))
+		{
+			LOGE("invalid node=%u", ac->node);
+			return 0;
+		}
+
+		gltf_animationSampler_t* as;
+		as = &animation->samplers[ac->sampler];
+
+		gltf_accessor_t* input;
+		gltf_accessor_t* output;
+		input  = gltf_file_getAccessor(file, as->input);
+		output = gltf_file_getAccessor(file, as->output);
+		if((input == NULL) || (output == NULL))
+		{
+			return 0;
+		}
+
+		uint32_t components;
+		if(gltf_animator_components(ac->path, as->interpolation,
+		                            input, output,
+		                            &components) == 0)
+		{
+			return 0;
+		}
+
+		gltf_animatorSampler_t* sampler;
+		sampler = &self->samplers[ac->sampler];
+		if(sampler->stride == 0)
+		{
+			sampler->interpolation = as->interpolation;
+			sampler->key_count     = input->count;
+			sampler->components    = components;
+			sampler->stride        = (components + 3) & ~3;
+
+			size_t values = sampler->key_count;
+			if(sampler->interpolation ==
+			   GLTF_ANIMATION_INTERPOLATION_CUBICSPLINE)
+			{
+				values *= 3;
+			}
+			data_count += sampler->key_count +
+			              values*sampler->stride;
+		}
+		else if(sampler->components != components)
+		{
+			LOGE("invalid components=%u:%u",
+			     sampler->components, components);
+			return 0;
+		}
+
+		gltf_animatorChannel_t* channel;
+		channel = &self->channels[self->channel_count];
+		channel->sampler = ac->sampler;
+		channel->node    = ac->node;
+		channel->path    = ac->path;
+		channel->offset  = self->output_count;
+		self->output_count += sampler->stride;
+		++self->channel_count;
+	}
+
+	*_data_count = data_count;
+	return 1;
+}
+
+static int
+gltf_animator_decode(gltf_animator_t* self,
+                     gltf_file_t* file,
+                     gltf_animation_t* animation)
+{
+	ASSERT(self);
+	ASSERT(file);
+	ASSERT(animation);
+
+	self->start = FLT_MAX;
+	self->end   = -FLT_MAX;
+
+	float*   data = self->data;
+	uint32_t i;
+	for(i = 0; i < self->sampler_count; ++i)
+	{
+		gltf_animatorSampler_t* sampler = &self->samplers[i];
+		if(sampler->stride == 0)
+		{
+			continue;
+		}
+
+		// the accessors were validated by gltf_animator_channels
+		gltf_animationSampler_t* as = &animation->samplers[i];
+		gltf_accessor_t* input;
+		gltf_accessor_t* output;
+		input  = gltf_file_getAccessor(file, as->input);
+		output = gltf_file_getAccessor(file, as->output);
+
+		size_t count = sampler->key_count;
+		if(sampler->interpolation ==
+		   GLTF_ANIMATION_INTERPOLATION_CUBICSPLINE)
+		{
+			count *= 3;
+		}
+
+		sampler->times  = data;
+		data           += sampler->key_count;
+		sampler->values = data;
+		data           += count*sampler->stride;
+
+		if((gltf_decode_float(file, input,
+		                      sampler->times) == 0) ||
+		   (gltf_decode_float(file, output,
+		                      sampler->values) == 0))
+		{
+			return 0;
+		}
+
+		// pad the tightly packed values in place from the end
+		uint32_t components = sampler->components;
+		uint32_t stride     = sampler->stride;
+		if(components < stride)
+		{
+			size_t j = count;
+			while(j > 0)
+			{
+				--j;
+				float* dst = &sampler->values[j*stride];
+				memmove(dst, &sampler->values[j*components],
+				        components*sizeof(float));
+				memset(&dst[components], 0,
+				       (stride - components)*sizeof(float));
+			}
+		}
+
+		float t0 = sampler->times[0];
+		float t1 = sampler->times[sampler->key_count - 1];
+		self->start = (t0 < self->start) ? t0 : self->start;
+		self->end   = (t1 > self->end)   ? t1 : self->end;
+	}
+
+	if(self->start > self->end)
+	{
+		self->start = 0.0f;
+		self->end   = 0.0f;
+	}
+
+	return 1;
+}
+
+static int
+gltf_animator_targets(gltf_animator_t* self,
+                      gltf_file_t* file)
+{
+	ASSERT(self);
+	ASSERT(file);
+
+	self->targets = (gltf_animatorTarget_t*)
+	                CALLOC(self->channel_count + 1,
+	                       sizeof(gltf_animatorTarget_t));
+	if(self->targets == NULL)
+	{
+		LOGE("CALLOC failed");
+		return 0;
+	}
+
+	// target index + 1 of each node
+	uint32_t* map;
+	map = (uint32_t*) CALLOC(file->node_count + 1,
+	                         sizeof(uint32_t));
+	if(map == NULL)
+	{
+		LOGE("CALLOC failed");
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < self->channel_count; ++i)
+	{
+		gltf_animatorChannel_t* channel = &self->channels[i];
+		if(channel->path == GLTF_ANIMATION_PATH_WEIGHTS)
+		{
+			continue;
+		}
+
+		gltf_animatorTarget_t* target;
+		if(map[channel->node])
+		{
+			target = &self->targets[map[channel->node] - 1];
+		}
+		else
+		{
+			// the node was validated by gltf_animator_channels
+			gltf_node_t* node;
+			node = gltf_file_getNode(file, channel->node);
+
+			target = &self->targets[self->target_count];
+			target->node        = channel->node;
+			target->translation = GLTF_ANIMATOR_NONE;
+			target->rotation    = GLTF_ANIMATOR_NONE;
+			target->scale       = GLTF_ANIMATOR_NONE;
+			target->t           = node->translation;
+			target->r           = node->rotation;
+			target->s           = node->scale;
+
+			++self->target_count;
+			map[channel->node] = self->target_count;
+		}
+
+		if(channel->path == GLTF_ANIMATION_PATH_TRANSLATION)
+		{
+			target->translation = channel->offset;
+		}
+		else if(channel->path == GLTF_ANIMATION_PATH_ROTATION)
+		{
+			target->rotation = channel->offset;
+		}
+		else
+		{
+			target->scale = channel->offset;
+		}
+	}
+
+	FREE(map);
+
+	return 1;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_animator_t*
+gltf_animator_new(gltf_file_t* file, uint32_t animation)
+{
+	ASSERT(file);
+
+	gltf_animation_t* anim;
+	anim = gltf_file_getAnimation(file, animation);
+	if(anim == NULL)
+	{
+		return NULL;
+	}
+
+	gltf_animator_t* self;
+	self = (gltf_animator_t*) CALLOC(1, sizeof(gltf_animator_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->sampler_count = anim->sampler_count;
+	self->samplers = (gltf_animatorSampler_t*)
+	                 CALLOC(anim->sampler_count + 1,
+	                        sizeof(gltf_animatorSampler_t));
+	self->channels = (gltf_animatorChannel_t*)
+	                 CALLOC(anim->channel_count + 1,
+	                        sizeof(gltf_animatorChannel_t));
+	if((self->samplers == NULL) || (self->channels == NULL))
+	{
+		LOGE("CALLOC failed");
+		goto fail_alloc;
+	}
+
+	size_t data_count = 0;
+	if(gltf_animator_channels(self, file, anim,
+	                          &data_count) == 0)
+	{
+		goto fail_channels;
+	}
+
+	// keyframes of all samplers are stored in one block
+	self->data = (float*)
+	             MALLOC((data_count + 1)*sizeof(float));
+	if(self->data == NULL)
+	{
+		LOGE("MALLOC failed");
+		goto fail_data;
+	}
+
+	if((gltf_animator_decode(self, file, anim) == 0) ||
+	   (gltf_animator_targets(self, file) == 0))
+	{
+		goto fail_decode;
+	}
+
+	// success
+	return self;
+
+	// failure
+	fail_decode:
+	fail_data:
+	fail_channels:
+	fail_alloc:
+		gltf_animator_delete(&self);
+	return NULL;
+}
+
+void gltf_animator_delete(gltf_animator_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_animator_t* self = *_self;
+	if(self)
+	{
+		FREE(self->data);
+		FREE(self->targets);
+		FREE(self->channels);
+		FREE(self->samplers);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+void gltf_animator_sample(gltf_animator_t* self,
+                          float time, uint32_t* cursors,
+                          float* output)
+{
+	ASSERT(self);
+	ASSERT(cursors);
+	ASSERT(output);
+
+	gltf_animator_sampleBatch(self, 1, &time, cursors, output);
+}
+
+void gltf_animator_sampleBatch(gltf_animator_t* self,
+                               uint32_t count,
+                               const float* times,
+                               uint32_t* cursors,
+                               float* outputs)
+{
+	ASSERT(self);
+	ASSERT(times);
+	ASSERT(cursors);
+	ASSERT(outputs);
+
+	// evaluate each channel across the instances such that
+	// the keyframes of a sampler remain in the cache
+	uint32_t i;
+	uint32_t j;
+	for(i = 0; i < self->channel_count; ++i)
+	{
+		gltf_animatorChannel_t* channel = &self->channels[i];
+		gltf_animatorSampler_t* sampler;
+		sampler = &self->samplers[channel->sampler];
+
+		int rotation = (channel->path ==
+		                GLTF_ANIMATION_PATH_ROTATION);
+		uint32_t* cursor = &cursors[channel->sampler];
+		float*    output = &outputs[channel->offset];
+		for(j = 0; j < count; ++j)
+		{
+			gltf_animator_evaluate(sampler, rotation, times[j],
+			                       cursor, output);
+			cursor += self->sampler_count;
+			output += self->output_count;
+		}
+	}
+}
+
+void gltf_animator_apply(gltf_animator_t* self,
+                         const float* output,
+                         gltf_transforms_t* transforms)
+{
+	ASSERT(self);
+	ASSERT(output);
+	ASSERT(transforms);
+
+	uint32_t i;
+	for(i = 0; i < self->target_count; ++i)
+	{
+		gltf_animatorTarget_t* target = &self->targets[i];
+		if((target->node >= transforms->node_count) ||
+		   (transforms->slots[target->node] ==
+		    GLTF_TRANSFORMS_NONE))
+		{
+			continue;
+		}
+
+		cc_vec3f_t t = target->t;
+		cc_vec4f_t r = target->r;
+		cc_vec3f_t s = target->s;
+
+		const float* v;
+		if(target->translation != GLTF_ANIMATOR_NONE)
+		{
+			v = &output[target->translation];
+			cc_vec3f_load(&t, v[0], v[1], v[2]);
+		}
+
+		if(target->rotation != GLTF_ANIMATOR_NONE)
+		{
+			v = &output[target->rotation];
+			cc_vec4f_load(&r, v[0], v[1], v[2], v[3]);
+		}
+
+		if(target->scale != GLTF_ANIMATOR_NONE)
+		{
+			v = &output[target->scale];
+			cc_vec3f_load(&s, v[0], v[1], v[2]);
+		}
+
+		gltf_transforms_setTRS(transforms, target->node,
+		                       &t, &r, &s);
+	}
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_animator_H
+#define gltf_animator_H
+
+#include "gltf.h"
+#include "gltf_transforms.h"
+
+#define GLTF_ANIMATOR_NONE 0xFFFFFFFF
+
+// decoded keyframes of a sampler where each value is padded
+// to stride floats (a multiple of 4) and CUBICSPLINE values
+// are stored as (in-tangent, value, out-tangent) triplets
+// samplers which are not referenced by a supported channel
+// have a key_count of zero
+typedef struct gltf_animatorSampler_s
+{
+	gltf_animationInterpolation_e interpolation;
+
+	uint32_t key_count;
+	uint32_t components;
+	uint32_t stride;
+	float*   times;
+	float*   values;
+} gltf_animatorSampler_t;
+
+// channels write stride floats at the offset of the output
+// where translation/scale are (x,y,z,0), rotation is the
+// quaternion (x,y,z,w) and weights are zero padded
+typedef struct gltf_animatorChannel_s
+{
+	uint32_t             sampler;
+	uint32_t             node;
+	gltf_animationPath_e path;
+	uint32_t             offset;
+} gltf_animatorChannel_t;
+
+// output offsets of the animated TRS of a node (or
+// GLTF_ANIMATOR_NONE) which override the node TRS
+typedef struct gltf_animatorTarget_s
+{
+	uint32_t   node;
+	uint32_t   translation;
+	uint32_t   rotation;
+	uint32_t   scale;
+	cc_vec3f_t t;
+	cc_vec4f_t r;
+	cc_vec3f_t s;
+} gltf_animatorTarget_t;
+
+// the animator is immutable once created so it may be
+// shared by many instances (e.g. characters) which each
+// own a cursor per sampler that caches the keyframe of the
+// last evaluation such that time which advances
+// monotonically does not require a binary search
+typedef struct gltf_animator_s
+{
+	// keyframe time range of the samplers
+	float start;
+	float end;
+
+	uint32_t                sampler_count;
+	gltf_animatorSampler_t* samplers;
+
+	// channels without a node or with an unknown path are
+	// ignored
+	uint32_t                channel_count;
+	gltf_animatorChannel_t* channels;
+
+	// floats written per evaluation
+	uint32_t output_count;
+
+	uint32_t               target_count;
+	gltf_animatorTarget_t* targets;
+
+	float* data;
+} gltf_animator_t;
+
+gltf_animator_t* gltf_animator_new(gltf_file_t* file,
+                                   uint32_t animation);
+void             gltf_animator_delete(gltf_animator_t** _self);
+
+// cursors are sampler_count elements per instance which
+// should be zeroed for a new instance
+// times outside of the keyframes are clamped
+// gltf_animator_sampleBatch evaluates count instances where
+// instance i uses times[i], the cursors at
+// cursors[i*sampler_count] and the output at
+// outputs[i*output_count]
+void             gltf_animator_sample(gltf_animator_t* self,
+                                      float time,
+                                      uint32_t* cursors,
+                                      float* output);
+void             gltf_animator_sampleBatch(gltf_animator_t* self,
+                                           uint32_t count,
+                                           const float* times,
+                                           uint32_t* cursors,
+                                           float* outputs);
+
+// set the local TRS of the targets from an output where
+// nodes outside of the transforms are skipped
+void             gltf_animator_apply(gltf_animator_t* self,
+                                     const float* output,
+                                     gltf_transforms_t* transforms);
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <stdlib.h>
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_arena.h"
+
+// allocations are aligned for SIMD loads
+#define GLTF_ARENA_ALIGN 16
+
+// blocks grow geometrically up to this size
+#define GLTF_ARENA_BLOCK_MAX (16*1024*1024)
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static size_t gltf_arena_align(size_t size)
+{
+	return (size + GLTF_ARENA_ALIGN - 1) &
+	       ~((size_t) GLTF_ARENA_ALIGN - 1);
+}
+
+static size_t gltf_arena_header(void)
+{
+	return gltf_arena_align(sizeof(gltf_arenaBlock_t));
+}
+
+static gltf_arenaBlock_t*
+gltf_arena_newBlock(gltf_arena_t* self, size_t size)
+{
+	ASSERT(self);
+
+	// CALLOC ensures that allocations are zero initialized
+	gltf_arenaBlock_t* block;
+	block = (gltf_arenaBlock_t*)
+	        CALLOC(1, gltf_arena_header() + size);
+	if(block == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	block->size = size;
+	++self->block_count;
+
+	return block;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_arena_t* gltf_arena_new(size_t block_size)
+{
+	ASSERT(block_size > 0);
+
+	gltf_arena_t* self;
+	self = (gltf_arena_t*) CALLOC(1, sizeof(gltf_arena_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->block_size = gltf_arena_align(block_size);
+
+	return self;
+}
+
+void gltf_arena_delete(gltf_arena_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_arena_t* self = *_self;
+	if(self)
+	{
+		gltf_arenaBlock_t* block = self->head;
+		while(block)
+		{
+			gltf_arenaBlock_t* next = block->next;
+			FREE(block);
+			block = next;
+		}
+
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+void* gltf_arena_alloc(gltf_arena_t* self, size_t size)
+{
+	ASSERT(self);
+
+	if(size == 0)
+	{
+		LOGE("invalid size=0");
+		return NULL;
+	}
+
+	size = gltf_arena_align(size);
+
+	gltf_arenaBlock_t* block = self->head;
+	if((block == NULL) || (block->used + size > block->size))
+	{
+		if(size > self->block_size/4)
+		{
+			// large allocations receive a dedicated block
+			// which is linked behind the current block so
+			// the remaining space is not wasted
+			block = gltf_arena_newBlock(self, size);
+			if(block == NULL)
+			{
+				return NULL;
+			}
+
+			if(self->head)
+			{
+				block->next      = self->head->next;
+				self->head->next = block;
+			}
+			else
+			{
+				self->head = block;
+			}
+		}
+		else
+		{
+			block = gltf_arena_newBlock(self, self->block_size);
+			if(block == NULL)
+			{
+				return NULL;
+			}
+
+			block->next = self->head;
+			self->head  = block;
+
+			// grow blocks geometrically to keep the block
+			// count small for large files
+			if(2*self->block_size <= GLTF_ARENA_BLOCK_MAX)
+			{
+				self->block_size *= 2;
+			}
+		}
+	}
+
+	char* data = ((char*) block) + gltf_arena_header() +
+	             block->used;
+	block->used += size;
+
+	++self->alloc_count;
+	self->alloc_size += size;
+
+	return (void*) data;
+}
+
+void gltf_arena_merge(gltf_arena_t* self,
+                      gltf_arena_t** _other)
+{
+	ASSERT(self);
+	ASSERT(_other);
+
+	gltf_arena_t* other = *_other;
+	if(other == NULL)
+	{
+		return;
+	}
+
+	// link the other blocks behind the current block so the
+	// remaining space of the current block is not wasted
+	gltf_arenaBlock_t* head = other->head;
+	if(head)
+	{
+		gltf_arenaBlock_t* tail = head;
+		while(tail->next)
+		{
+			tail = tail->next;
+		}
+
+		if(self->head)
+		{
+			tail->next       = self->head->next;
+			self->head->next = head;
+		}
+		else
+		{
+			self->head = head;
+		}
+	}
+
+	self->block_count += other->block_count;
+	self->alloc_count += other->alloc_count;
+	self->alloc_size  += other->alloc_size;
+
+	FREE(other);
+	*_other = NULL;
+}
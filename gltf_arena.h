@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_arena_H
+#define gltf_arena_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+typedef struct gltf_arenaBlock_s
+{
+	struct gltf_arenaBlock_s* next;
+
+	size_t size;
+	size_t used;
+
+	// data follows the block header
+} gltf_arenaBlock_t;
+
+// bump allocator which owns all objects created while
+// parsing a file so they may be released at once
+typedef struct gltf_arena_s
+{
+	gltf_arenaBlock_t* head;
+	size_t             block_size;
+
+	// statistics
+	uint32_t block_count;
+	uint32_t alloc_count;
+	size_t   alloc_size;
+} gltf_arena_t;
+
+gltf_arena_t* gltf_arena_new(size_t block_size);
+void          gltf_arena_delete(gltf_arena_t** _self);
+void*         gltf_arena_alloc(gltf_arena_t* self,
+                               size_t size);
+
+// transfer the blocks of other to self and delete other
+// e.g. to combine arenas filled by worker threads
+void          gltf_arena_merge(gltf_arena_t* self,
+                               gltf_arena_t** _other);
+
+#endif
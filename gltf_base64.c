@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <stdlib.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "gltf_base64.h"
+
+// maps the base64 alphabet to 6-bit values where invalid
+// characters are -1, padding is -2 and escapes are -3
+static const int8_t GLTF_BASE64_TABLE[256] =
+{
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+	52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -2, -1, -1,
+	-1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+	15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -3, -1, -1, -1,
+	-1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+	41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+#if defined(__SSE2__)
+
+static __m128i
+gltf_base64_range(__m128i x, char lo, char hi)
+{
+	__m128i a = _mm_cmpgt_epi8(x, _mm_set1_epi8((char) (lo - 1)));
+	__m128i b = _mm_cmplt_epi8(x, _mm_set1_epi8((char) (hi + 1)));
+	return _mm_and_si128(a, b);
+}
+
+static uint32_t
+gltf_base64_decodeSSE2(const char* src, uint32_t len,
+                       char* dst)
+{
+	ASSERT(src);
+	ASSERT(dst);
+
+	// decode blocks of 16 characters into 12 bytes and stop
+	// at the first block which contains a character outside
+	// of the alphabet (e.g. padding or escapes)
+	uint32_t i = 0;
+	uint32_t j;
+	for(; i + 16 <= len; i += 16)
+	{
+		__m128i x = _mm_loadu_si128((const __m128i*) &src[i]);
+
+		// characters >= 0x80 are negative and fail every range
+		__m128i upper = gltf_base64_range(x, 'A', 'Z');
+		__m128i lower = gltf_base64_range(x, 'a', 'z');
+		__m128i digit = gltf_base64_range(x, '0', '9');
+		__m128i plus  = _mm_cmpeq_epi8(x, _mm_set1_epi8('+'));
+		__m128i slash = _mm_cmpeq_epi8(x, _mm_set1_epi8('/'));
+
+		__m128i valid;
+		valid = _mm_or_si128(_mm_or_si128(upper, lower),
+		                     _mm_or_si128(digit,
+		                                  _mm_or_si128(plus, slash)));
+		if(_mm_movemask_epi8(valid) != 0xFFFF)
+		{
+			break;
+		}
+
+		// translate characters to 6-bit values
+		__m128i off;
+		off = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-65)),
+		                   _mm_and_si128(lower, _mm_set1_epi8(-71)));
+		off = _mm_or_si128(off,
+		                   _mm_and_si128(digit, _mm_set1_epi8(4)));
+		off = _mm_or_si128(off,
+		                   _mm_and_si128(plus, _mm_set1_epi8(19)));
+		off = _mm_or_si128(off,
+		                   _mm_and_si128(slash, _mm_set1_epi8(16)));
+		__m128i v = _mm_add_epi8(x, off);
+
+		// merge pairs of 6-bit values into 12-bit words and
+		// pairs of words into 24-bit groups
+		__m128i lo = _mm_and_si128(v, _mm_set1_epi16(0x00FF));
+		__m128i hi = _mm_srli_epi16(v, 8);
+		__m128i w  = _mm_or_si128(_mm_slli_epi16(lo, 6), hi);
+		__m128i d  = _mm_madd_epi16(w, _mm_set1_epi32(0x00011000));
+
+		uint32_t t[4];
+		_mm_storeu_si128((__m128i*) t, d);
+		for(j = 0; j < 4; ++j)
+		{
+			dst[0] = (char) (t[j] >> 16);
+			dst[1] = (char) (t[j] >> 8);
+			dst[2] = (char) t[j];
+			dst += 3;
+		}
+	}
+
+	return i;
+}
+
+#elif defined(__ARM_NEON)
+
+static uint8x16_t
+gltf_base64_lookup(uint8x16_t x, uint8x16_t* _valid)
+{
+	ASSERT(_valid);
+
+	uint8x16_t upper = vandq_u8(vcgeq_u8(x, vdupq_n_u8('A')),
+	                            vcleq_u8(x, vdupq_n_u8('Z')));
+	uint8x16_t lower = vandq_u8(vcgeq_u8(x, vdupq_n_u8('a')),
+	                            vcleq_u8(x, vdupq_n_u8('z')));
+	uint8x16_t digit = vandq_u8(vcgeq_u8(x, vdupq_n_u8('0')),
+	                            vcleq_u8(x, vdupq_n_u8('9')));
+	uint8x16_t plus  = vceqq_u8(x, vdupq_n_u8('+'));
+	uint8x16_t slash = vceqq_u8(x, vdupq_n_u8('/'));
+
+	*_valid = vandq_u8(*_valid,
+	                   vorrq_u8(vorrq_u8(upper, lower),
+	                            vorrq_u8(digit,
+	                                     vorrq_u8(plus, slash))));
+
+	// translate characters to 6-bit values (mod 256)
+	uint8x16_t off;
+	off = vorrq_u8(vandq_u8(upper, vdupq_n_u8((uint8_t) -65)),
+	               vandq_u8(lower, vdupq_n_u8((uint8_t) -71)));
+	off = vorrq_u8(off, vandq_u8(digit, vdupq_n_u8(4)));
+	off = vorrq_u8(off, vandq_u8(plus,  vdupq_n_u8(19)));
+	off = vorrq_u8(off, vandq_u8(slash, vdupq_n_u8(16)));
+	return vaddq_u8(x, off);
+}
+
+static uint32_t
+gltf_base64_decodeNEON(const char* src, uint32_t len,
+                       char* dst)
+{
+	ASSERT(src);
+	ASSERT(dst);
+
+	// decode blocks of 64 characters into 48 bytes where
+	// vld4 deinterleaves the four characters of each group
+	uint32_t i = 0;
+	for(; i + 64 <= len; i += 64)
+	{
+		uint8x16x4_t x = vld4q_u8((const uint8_t*) &src[i]);
+		uint8x16_t   valid = vdupq_n_u8(0xFF);
+		uint8x16_t   a = gltf_base64_lookup(x.val[0], &valid);
+		uint8x16_t   b = gltf_base64_lookup(x.val[1], &valid);
+		uint8x16_t   c = gltf_base64_lookup(x.val[2], &valid);
+		uint8x16_t   d = gltf_base64_lookup(x.val[3], &valid);
+
+		uint64x2_t v = vreinterpretq_u64_u8(vmvnq_u8(valid));
+		if(vgetq_lane_u64(v, 0) | vgetq_lane_u64(v, 1))
+		{
+			break;
+		}
+
+		uint8x16x3_t y;
+		y.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+		y.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+		y.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+		vst3q_u8((uint8_t*) dst, y);
+		dst += 48;
+	}
+
+	return i;
+}
+
+#endif
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+uint32_t gltf_base64_size(uint32_t len)
+{
+	return 3*(len/4) + 3;
+}
+
+int gltf_base64_decode(const char* src, uint32_t len,
+                       char* dst, uint32_t* _size)
+{
+	ASSERT(src);
+	ASSERT(dst);
+	ASSERT(_size);
+
+	// the vector path decodes the leading blocks of the
+	// alphabet which is typically the entire string
+	uint32_t i = 0;
+	#if defined(__SSE2__)
+	i = gltf_base64_decodeSSE2(src, len, dst);
+	#elif defined(__ARM_NEON)
+	i = gltf_base64_decodeNEON(src, len, dst);
+	#endif
+
+	// decode the remaining characters one at a time
+	uint32_t size    = 3*(i/4);
+	uint32_t bits    = 0;
+	uint32_t count   = 0;
+	int      padding = 0;
+	for(; i < len; ++i)
+	{
+		int8_t v = GLTF_BASE64_TABLE[(uint8_t) src[i]];
+		if(v == -3)
+		{
+			// skip the backslash of an escaped slash
+			continue;
+		}
+		else if(v == -2)
+		{
+			padding = 1;
+			continue;
+		}
+		else if((v < 0) || padding)
+		{
+			LOGE("invalid i=%u, c=0x%X", i, (uint32_t)
+			     (uint8_t) src[i]);
+			return 0;
+		}
+
+		bits = (bits << 6) | ((uint32_t) v);
+		++count;
+		if(count == 4)
+		{
+			dst[size]     = (char) (bits >> 16);
+			dst[size + 1] = (char) (bits >> 8);
+			dst[size + 2] = (char) bits;
+			size  += 3;
+			bits   = 0;
+			count  = 0;
+		}
+	}
+
+	// flush a partial group
+	if(count == 1)
+	{
+		LOGE("invalid count=%u", count);
+		return 0;
+	}
+	else if(count == 2)
+	{
+		dst[size] = (char) (bits >> 4);
+		size += 1;
+	}
+	else if(count == 3)
+	{
+		dst[size]     = (char) (bits >> 10);
+		dst[size + 1] = (char) (bits >> 2);
+		size += 2;
+	}
+
+	*_size = size;
+	return 1;
+}
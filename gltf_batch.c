@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_batch.h"
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static void
+gltf_batch_loadFile(gltf_batch_t* self, uint32_t idx)
+{
+	ASSERT(self);
+
+	const char* fname = self->fnames[idx];
+
+	// the file size estimates the memory required to load
+	// the file which is reserved from the in-flight budget
+	size_t             size   = 0;
+	gltf_batchStatus_e status = GLTF_BATCH_STATUS_OK;
+	struct stat        st;
+	if(stat(fname, &st) == 0)
+	{
+		size = (size_t) st.st_size;
+	}
+	else if(errno == ENOENT)
+	{
+		status = GLTF_BATCH_STATUS_NOT_FOUND;
+	}
+	else
+	{
+		status = GLTF_BATCH_STATUS_IO;
+	}
+
+	pthread_mutex_lock(&self->mutex);
+	while(self->max_bytes && self->inflight &&
+	      (self->inflight + size > self->max_bytes))
+	{
+		pthread_cond_wait(&self->cond_memory, &self->mutex);
+	}
+	self->inflight += size;
+	pthread_mutex_unlock(&self->mutex);
+
+	gltf_file_t* file = NULL;
+	if(status == GLTF_BATCH_STATUS_OK)
+	{
+		file = gltf_file_open(fname);
+		if(file == NULL)
+		{
+			status = GLTF_BATCH_STATUS_INVALID;
+		}
+	}
+	(*self->batch_fn)(self->priv, idx, fname, status, file);
+
+	pthread_mutex_lock(&self->mutex);
+	self->inflight -= size;
+	++self->done;
+	pthread_cond_broadcast(&self->cond_memory);
+	if(self->done == self->count)
+	{
+		pthread_cond_broadcast(&self->cond_done);
+	}
+	pthread_mutex_unlock(&self->mutex);
+}
+
+static void* gltf_batch_run(void* arg)
+{
+	ASSERT(arg);
+
+	gltf_batch_t* self = (gltf_batch_t*) arg;
+
+	pthread_mutex_lock(&self->mutex);
+	while(self->running)
+	{
+		if(self->next < self->count)
+		{
+			uint32_t idx = self->next++;
+			pthread_mutex_unlock(&self->mutex);
+			gltf_batch_loadFile(self, idx);
+			pthread_mutex_lock(&self->mutex);
+		}
+		else
+		{
+			pthread_cond_wait(&self->cond_work, &self->mutex);
+		}
+	}
+	pthread_mutex_unlock(&self->mutex);
+
+	return NULL;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_batch_t* gltf_batch_new(uint32_t thread_count,
+                             size_t max_bytes)
+{
+	thread_count = gltf_file_threadCount(thread_count);
+
+	gltf_batch_t* self;
+	self = (gltf_batch_t*) CALLOC(1, sizeof(gltf_batch_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->max_bytes = max_bytes;
+	self->running   = 1;
+
+	self->threads = (pthread_t*)
+	                CALLOC(thread_count, sizeof(pthread_t));
+	if(self->threads == NULL)
+	{
+		LOGE("CALLOC failed");
+		goto fail_threads;
+	}
+
+	if(pthread_mutex_init(&self->mutex, NULL) != 0)
+	{
+		LOGE("pthread_mutex_init failed");
+		goto fail_mutex;
+	}
+
+	if(pthread_cond_init(&self->cond_work, NULL) != 0)
+	{
+		LOGE("pthread_cond_init failed");
+		goto fail_cond_work;
+	}
+
+	if(pthread_cond_init(&self->cond_memory, NULL) != 0)
+	{
+		LOGE("pthread_cond_init failed");
+		goto fail_cond_memory;
+	}
+
+	if(pthread_cond_init(&self->cond_done, NULL) != 0)
+	{
+		LOGE("pthread_cond_init failed");
+		goto fail_cond_done;
+	}
+
+	uint32_t i;
+	for(i = 0; i < thread_count; ++i)
+	{
+		if(pthread_create(&self->threads[i], NULL,
+		                  gltf_batch_run, (void*) self) != 0)
+		{
+			LOGE("pthread_create failed");
+			goto fail_create;
+		}
+		++self->thread_count;
+	}
+
+	// success
+	return self;
+
+	// failure
+	fail_create:
+	{
+		pthread_mutex_lock(&self->mutex);
+		self->running = 0;
+		pthread_cond_broadcast(&self->cond_work);
+		pthread_mutex_unlock(&self->mutex);
+
+		for(i = 0; i < self->thread_count; ++i)
+		{
+			pthread_join(self->threads[i], NULL);
+		}
+		pthread_cond_destroy(&self->cond_done);
+	}
+	fail_cond_done:
+		pthread_cond_destroy(&self->cond_memory);
+	fail_cond_memory:
+		pthread_cond_destroy(&self->cond_work);
+	fail_cond_work:
+		pthread_mutex_destroy(&self->mutex);
+	fail_mutex:
+		FREE(self->threads);
+	fail_threads:
+		FREE(self);
+	return NULL;
+}
+
+void gltf_batch_delete(gltf_batch_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_batch_t* self = *_self;
+	if(self)
+	{
+		pthread_mutex_lock(&self->mutex);
+		self->running = 0;
+		pthread_cond_broadcast(&self->cond_work);
+		pthread_mutex_unlock(&self->mutex);
+
+		uint32_t i;
+		for(i = 0; i < self->thread_count; ++i)
+		{
+			pthread_join(self->threads[i], NULL);
+		}
+
+		pthread_cond_destroy(&self->cond_done);
+		pthread_cond_destroy(&self->cond_memory);
+		pthread_cond_destroy(&self->cond_work);
+		pthread_mutex_destroy(&self->mutex);
+		FREE(self->threads);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+void gltf_batch_load(gltf_batch_t* self,
+                     uint32_t count,
+                     const char** fnames,
+                     void* priv,
+                     gltf_batch_fn batch_fn)
+{
+	ASSERT(self);
+	ASSERT(fnames);
+	ASSERT(batch_fn);
+
+	if(count == 0)
+	{
+		return;
+	}
+
+	// wait for the current batch of another caller
+	pthread_mutex_lock(&self->mutex);
+	while(self->count)
+	{
+		pthread_cond_wait(&self->cond_done, &self->mutex);
+	}
+
+	// start the batch and wait for every file to complete
+	self->count    = count;
+	self->fnames   = fnames;
+	self->next     = 0;
+	self->done     = 0;
+	self->priv     = priv;
+	self->batch_fn = batch_fn;
+	pthread_cond_broadcast(&self->cond_work);
+
+	while(self->done < self->count)
+	{
+		pthread_cond_wait(&self->cond_done, &self->mutex);
+	}
+
+	self->count    = 0;
+	self->fnames   = NULL;
+	self->next     = 0;
+	self->done     = 0;
+	self->priv     = NULL;
+	self->batch_fn = NULL;
+	pthread_cond_broadcast(&self->cond_done);
+	pthread_mutex_unlock(&self->mutex);
+}
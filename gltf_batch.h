@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_batch_H
+#define gltf_batch_H
+
+#include <pthread.h>
+
+#include "gltf.h"
+
+typedef enum
+{
+	GLTF_BATCH_STATUS_OK,
+	GLTF_BATCH_STATUS_NOT_FOUND, // the file does not exist
+	GLTF_BATCH_STATUS_IO,        // the file could not be accessed
+	GLTF_BATCH_STATUS_INVALID,   // the file failed to load or parse
+} gltf_batchStatus_e;
+
+// called from the worker threads (possibly concurrently)
+// for each file where file is NULL unless the status is
+// GLTF_BATCH_STATUS_OK in which case the callback must
+// close the file
+typedef void (*gltf_batch_fn)(void* priv, uint32_t idx,
+                              const char* fname,
+                              gltf_batchStatus_e status,
+                              gltf_file_t* file);
+
+// fixed pool of worker threads which open lists of files
+// where max_bytes bounds the size of the files being read
+// or parsed at once (0 for unbounded) and a file which
+// exceeds max_bytes is loaded alone
+typedef struct gltf_batch_s
+{
+	size_t max_bytes;
+
+	uint32_t   thread_count;
+	pthread_t* threads;
+
+	// protects the state below
+	pthread_mutex_t mutex;
+	pthread_cond_t  cond_work;
+	pthread_cond_t  cond_memory;
+	pthread_cond_t  cond_done;
+	int             running;
+	size_t          inflight;
+
+	// current batch
+	uint32_t      count;
+	const char**  fnames;
+	uint32_t      next;
+	uint32_t      done;
+	void*         priv;
+	gltf_batch_fn batch_fn;
+} gltf_batch_t;
+
+gltf_batch_t* gltf_batch_new(uint32_t thread_count,
+                             size_t max_bytes);
+void          gltf_batch_delete(gltf_batch_t** _self);
+
+// load the files and wait for every callback to complete
+// where concurrent callers are serialized so each batch
+// runs to completion before the next begins
+void          gltf_batch_load(gltf_batch_t* self,
+                              uint32_t count,
+                              const char** fnames,
+                              void* priv,
+                              gltf_batch_fn batch_fn);
+
+#endif
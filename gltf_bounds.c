@@ -0,0 +1,693 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_bounds.h"
+#include "gltf_decode.h"
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static void gltf_bound_sphere(gltf_bound_t* self)
+{
+	ASSERT(self);
+
+	// sphere containing the box
+	float dx = 0.5f*(self->max.x - self->min.x);
+	float dy = 0.5f*(self->max.y - self->min.y);
+	float dz = 0.5f*(self->max.z - self->min.z);
+	self->center.x = self->min.x + dx;
+	self->center.y = self->min.y + dy;
+	self->center.z = self->min.z + dz;
+	self->radius   = sqrtf(dx*dx + dy*dy + dz*dz);
+}
+
+static float gltf_bound_maxScale(const float* m)
+{
+	ASSERT(m);
+
+	// the largest singular value of the upper 3x3 is the
+	// square root of the largest eigenvalue of A=M^T*M
+	// which is symmetric and solved in closed form since
+	// the column lengths are not sufficient for the skewed
+	// matrices produced by non-uniform parent scales
+	double a[3][3];
+	uint32_t i;
+	uint32_t j;
+	for(i = 0; i < 3; ++i)
+	{
+		for(j = 0; j < 3; ++j)
+		{
+			a[i][j] = ((double) m[4*i])*m[4*j] +
+			          ((double) m[4*i + 1])*m[4*j + 1] +
+			          ((double) m[4*i + 2])*m[4*j + 2];
+		}
+	}
+
+	double p1 = a[0][1]*a[0][1] + a[0][2]*a[0][2] +
+	            a[1][2]*a[1][2];
+	double q  = (a[0][0] + a[1][1] + a[2][2])/3.0;
+	double d0 = a[0][0] - q;
+	double d1 = a[1][1] - q;
+	double d2 = a[2][2] - q;
+	double p2 = d0*d0 + d1*d1 + d2*d2 + 2.0*p1;
+	if(p2 <= 0.0)
+	{
+		return (float) sqrt(q);
+	}
+
+	double p = sqrt(p2/6.0);
+	double b00 = d0/p;
+	double b11 = d1/p;
+	double b22 = d2/p;
+	double b01 = a[0][1]/p;
+	double b02 = a[0][2]/p;
+	double b12 = a[1][2]/p;
+	double r   = 0.5*(b00*(b11*b22 - b12*b12) -
+	                  b01*(b01*b22 - b12*b02) +
+	                  b02*(b01*b12 - b11*b02));
+	if(r < -1.0)
+	{
+		r = -1.0;
+	}
+	else if(r > 1.0)
+	{
+		r = 1.0;
+	}
+
+	double e = q + 2.0*p*cos(acos(r)/3.0);
+	if(e < 0.0)
+	{
+		e = 0.0;
+	}
+
+	// pad for rounding so the sphere remains conservative
+	return (float) (sqrt(e)*(1.0 + 1e-6));
+}
+
+static void
+gltf_bounds_scan(gltf_bound_t* self, uint32_t count,
+                 const float* xyz)
+{
+	ASSERT(self);
+	ASSERT(xyz);
+
+	float*   mn = (float*) &self->min;
+	float*   mx = (float*) &self->max;
+	uint32_t i  = 0;
+
+	#if defined(__SSE2__) || defined(__ARM_NEON)
+	// four packed vertices are loaded as three registers
+	// with the lanes a=(x,y,z,x), b=(y,z,x,y), c=(z,x,y,z)
+	if(count >= 4)
+	{
+		#if defined(__SSE2__)
+		__m128 a0 = _mm_loadu_ps(&xyz[0]);
+		__m128 b0 = _mm_loadu_ps(&xyz[4]);
+		__m128 c0 = _mm_loadu_ps(&xyz[8]);
+		__m128 a1 = a0;
+		__m128 b1 = b0;
+		__m128 c1 = c0;
+		for(i = 4; i + 4 <= count; i += 4)
+		{
+			const float* p = &xyz[3*i];
+			__m128 a = _mm_loadu_ps(&p[0]);
+			__m128 b = _mm_loadu_ps(&p[4]);
+			__m128 c = _mm_loadu_ps(&p[8]);
+			a0 = _mm_min_ps(a0, a);
+			b0 = _mm_min_ps(b0, b);
+			c0 = _mm_min_ps(c0, c);
+			a1 = _mm_max_ps(a1, a);
+			b1 = _mm_max_ps(b1, b);
+			c1 = _mm_max_ps(c1, c);
+		}
+
+		float t[24];
+		_mm_storeu_ps(&t[0],  a0);
+		_mm_storeu_ps(&t[4],  b0);
+		_mm_storeu_ps(&t[8],  c0);
+		_mm_storeu_ps(&t[12], a1);
+		_mm_storeu_ps(&t[16], b1);
+		_mm_storeu_ps(&t[20], c1);
+		#else
+		float32x4_t a0 = vld1q_f32(&xyz[0]);
+		float32x4_t b0 = vld1q_f32(&xyz[4]);
+		float32x4_t c0 = vld1q_f32(&xyz[8]);
+		float32x4_t a1 = a0;
+		float32x4_t b1 = b0;
+		float32x4_t c1 = c0;
+		for(i = 4; i + 4 <= count; i += 4)
+		{
+			const float* p = &xyz[3*i];
+			float32x4_t a = vld1q_f32(&p[0]);
+			float32x4_t b = vld1q_f32(&p[4]);
+			float32x4_t c = vld1q_f32(&p[8]);
+			a0 = vminq_f32(a0, a);
+			b0 = vminq_f32(b0, b);
+			c0 = vminq_f32(c0, c);
+			a1 = vmaxq_f32(a1, a);
+			b1 = vmaxq_f32(b1, b);
+			c1 = vmaxq_f32(c1, c);
+		}
+
+		float t[24];
+		vst1q_f32(&t[0],  a0);
+		vst1q_f32(&t[4],  b0);
+		vst1q_f32(&t[8],  c0);
+		vst1q_f32(&t[12], a1);
+		vst1q_f32(&t[16], b1);
+		vst1q_f32(&t[20], c1);
+		#endif
+
+		// the 12 lanes hold the components x,y,z repeated
+		uint32_t j;
+		for(j = 0; j < 12; ++j)
+		{
+			uint32_t k = j%3;
+			if(t[j] < mn[k])
+			{
+				mn[k] = t[j];
+			}
+			if(t[12 + j] > mx[k])
+			{
+				mx[k] = t[12 + j];
+			}
+		}
+	}
+	#endif
+
+	for(; i < count; ++i)
+	{
+		uint32_t k;
+		for(k = 0; k < 3; ++k)
+		{
+			float v = xyz[3*i + k];
+			if(v < mn[k])
+			{
+				mn[k] = v;
+			}
+			if(v > mx[k])
+			{
+				mx[k] = v;
+			}
+		}
+	}
+
+	// the scan allows a tighter radius about the box center
+	gltf_bound_sphere(self);
+
+	float r2 = 0.0f;
+	for(i = 0; i < count; ++i)
+	{
+		float dx = xyz[3*i]     - self->center.x;
+		float dy = xyz[3*i + 1] - self->center.y;
+		float dz = xyz[3*i + 2] - self->center.z;
+		float d2 = dx*dx + dy*dy + dz*dz;
+		if(d2 > r2)
+		{
+			r2 = d2;
+		}
+	}
+	self->radius = sqrtf(r2);
+}
+
+static int
+gltf_bounds_primitive(gltf_bound_t* self, gltf_file_t* file,
+                      gltf_primitive_t* primitive)
+{
+	ASSERT(self);
+	ASSERT(file);
+	ASSERT(primitive);
+
+	gltf_bound_empty(self);
+
+	gltf_attribute_t* attribute;
+	attribute = gltf_primitive_getAttribute(primitive,
+	                                        GLTF_ATTRIBUTE_TYPE_POSITION,
+	                                        0);
+	if(attribute == NULL)
+	{
+		return 1;
+	}
+
+	gltf_accessor_t* accessor;
+	accessor = gltf_file_getAccessor(file, attribute->accessor);
+	if(accessor == NULL)
+	{
+		return 0;
+	}
+
+	if(accessor->type != GLTF_ACCESSOR_TYPE_VEC3)
+	{
+		LOGE("invalid type=%u", (uint32_t) accessor->type);
+		return 0;
+	}
+
+	if(accessor->count == 0)
+	{
+		return 1;
+	}
+
+	if(accessor->has_minMax)
+	{
+		cc_vec3f_load(&self->min, accessor->min[0],
+		              accessor->min[1], accessor->min[2]);
+		cc_vec3f_load(&self->max, accessor->max[0],
+		              accessor->max[1], accessor->max[2]);
+		gltf_bound_sphere(self);
+		return 1;
+	}
+
+	float* xyz = (float*)
+	             MALLOC(3*((size_t) accessor->count)*sizeof(float));
+	if(xyz == NULL)
+	{
+		LOGE("MALLOC failed");
+		return 0;
+	}
+
+	if(gltf_decode_float(file, accessor, xyz) == 0)
+	{
+		FREE(xyz);
+		return 0;
+	}
+
+	gltf_bounds_scan(self, accessor->count, xyz);
+	FREE(xyz);
+
+	return 1;
+}
+
+static int
+gltf_bounds_meshes(gltf_bounds_t* self, gltf_file_t* file)
+{
+	ASSERT(self);
+	ASSERT(file);
+
+	uint32_t i;
+	uint32_t count = 0;
+	for(i = 0; i < self->mesh_count; ++i)
+	{
+		gltf_mesh_t* mesh = gltf_file_getMesh(file, i);
+		if(mesh == NULL)
+		{
+			return 0;
+		}
+
+		self->primitive_offsets[i] = count;
+		count += mesh->primitive_count;
+	}
+	self->primitive_offsets[self->mesh_count] = count;
+
+	self->primitives = (gltf_bound_t*)
+	                   CALLOC(count + 1, sizeof(gltf_bound_t));
+	if(self->primitives == NULL)
+	{
+		LOGE("CALLOC failed");
+		return 0;
+	}
+
+	for(i = 0; i < self->mesh_count; ++i)
+	{
+		gltf_mesh_t*  mesh  = gltf_file_getMesh(file, i);
+		gltf_bound_t* bound = &self->meshes[i];
+		gltf_bound_empty(bound);
+
+		uint32_t j;
+		for(j = 0; j < mesh->primitive_count; ++j)
+		{
+			gltf_bound_t* pb;
+			pb = &self->primitives[self->primitive_offsets[i] + j];
+			if(gltf_bounds_primitive(pb, file,
+			                         &mesh->primitives[j]) == 0)
+			{
+				return 0;
+			}
+			gltf_bound_union(bound, pb);
+		}
+	}
+
+	return 1;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_bounds_t* gltf_bounds_new(gltf_file_t* file)
+{
+	ASSERT(file);
+
+	gltf_bounds_t* self;
+	self = (gltf_bounds_t*) CALLOC(1, sizeof(gltf_bounds_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->mesh_count  = file->mesh_count;
+	self->node_count  = file->node_count;
+	self->scene_count = file->scene_count;
+
+	self->primitive_offsets = (uint32_t*)
+	                          CALLOC(self->mesh_count + 1,
+	                                 sizeof(uint32_t));
+	self->meshes   = (gltf_bound_t*)
+	                 CALLOC(self->mesh_count + 1,
+	                        sizeof(gltf_bound_t));
+	self->nodes    = (gltf_bound_t*)
+	                 CALLOC(self->node_count + 1,
+	                        sizeof(gltf_bound_t));
+	self->subtrees = (gltf_bound_t*)
+	                 CALLOC(self->node_count + 1,
+	                        sizeof(gltf_bound_t));
+	self->scenes   = (gltf_bound_t*)
+	                 CALLOC(self->scene_count + 1,
+	                        sizeof(gltf_bound_t));
+	if((self->primitive_offsets == NULL) ||
+	   (self->meshes   == NULL) || (self->nodes  == NULL) ||
+	   (self->subtrees == NULL) || (self->scenes == NULL))
+	{
+		LOGE("CALLOC failed");
+		goto fail_alloc;
+	}
+
+	if(gltf_bounds_meshes(self, file) == 0)
+	{
+		goto fail_meshes;
+	}
+
+	// every node is reachable from the non-child nodes
+	gltf_transforms_t* transforms;
+	transforms = gltf_transforms_new(file, NULL);
+	if(transforms == NULL)
+	{
+		goto fail_transforms;
+	}
+
+	if(gltf_bounds_update(self, file, transforms) == 0)
+	{
+		goto fail_update;
+	}
+
+	gltf_transforms_delete(&transforms);
+
+	// success
+	return self;
+
+	// failure
+	fail_update:
+		gltf_transforms_delete(&transforms);
+	fail_transforms:
+	fail_meshes:
+	fail_alloc:
+		gltf_bounds_delete(&self);
+	return NULL;
+}
+
+void gltf_bounds_delete(gltf_bounds_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_bounds_t* self = *_self;
+	if(self)
+	{
+		FREE(self->scenes);
+		FREE(self->subtrees);
+		FREE(self->nodes);
+		FREE(self->meshes);
+		FREE(self->primitives);
+		FREE(self->primitive_offsets);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+int gltf_bounds_update(gltf_bounds_t* self,
+                       gltf_file_t* file,
+                       gltf_transforms_t* transforms)
+{
+	ASSERT(self);
+	ASSERT(file);
+	ASSERT(transforms);
+
+	if(transforms->node_count != self->node_count)
+	{
+		LOGE("invalid node_count=%u:%u",
+		     transforms->node_count, self->node_count);
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < self->node_count; ++i)
+	{
+		gltf_bound_empty(&self->nodes[i]);
+		gltf_bound_empty(&self->subtrees[i]);
+	}
+
+	uint32_t slot;
+	for(slot = 0; slot < transforms->count; ++slot)
+	{
+		uint32_t     n    = transforms->nodes[slot];
+		gltf_node_t* node = gltf_file_getNode(file, n);
+		if(node == NULL)
+		{
+			return 0;
+		}
+
+		if(node->has_mesh == 0)
+		{
+			continue;
+		}
+
+		if(node->mesh >= self->mesh_count)
+		{
+			LOGE("invalid mesh=%u", node->mesh);
+			return 0;
+		}
+
+		cc_mat4f_t world;
+		gltf_transforms_getWorld(transforms, n, &world);
+		gltf_bound_transform(&self->nodes[n],
+		                     &self->meshes[node->mesh], &world);
+		self->subtrees[n] = self->nodes[n];
+	}
+
+	// children follow their parents in level order so the
+	// reverse order completes each subtree before it is
+	// merged into the parent
+	for(slot = transforms->count; slot > 0; --slot)
+	{
+		uint32_t parent = transforms->parents[slot - 1];
+		if(parent == GLTF_TRANSFORMS_NONE)
+		{
+			continue;
+		}
+
+		uint32_t n = transforms->nodes[slot - 1];
+		uint32_t p = transforms->nodes[parent];
+		gltf_bound_union(&self->subtrees[p], &self->subtrees[n]);
+	}
+
+	for(i = 0; i < self->scene_count; ++i)
+	{
+		gltf_bound_t* bound = &self->scenes[i];
+		gltf_bound_empty(bound);
+
+		gltf_scene_t* scene = gltf_file_getScene(file, i);
+		if(scene == NULL)
+		{
+			return 0;
+		}
+
+		uint32_t        j;
+		const uint32_t* roots;
+		roots = gltf_file_getSceneNodes(file, scene);
+		for(j = 0; j < scene->node_count; ++j)
+		{
+			if(roots[j] < self->node_count)
+			{
+				gltf_bound_union(bound, &self->subtrees[roots[j]]);
+			}
+		}
+	}
+
+	return 1;
+}
+
+const gltf_bound_t*
+gltf_bounds_getPrimitive(gltf_bounds_t* self,
+                         uint32_t mesh, uint32_t primitive)
+{
+	ASSERT(self);
+
+	if(mesh >= self->mesh_count)
+	{
+		LOGE("invalid mesh=%u", mesh);
+		return NULL;
+	}
+
+	uint32_t offset = self->primitive_offsets[mesh];
+	if(offset + primitive >= self->primitive_offsets[mesh + 1])
+	{
+		LOGE("invalid primitive=%u", primitive);
+		return NULL;
+	}
+
+	return &self->primitives[offset + primitive];
+}
+
+void gltf_bound_empty(gltf_bound_t* self)
+{
+	ASSERT(self);
+
+	cc_vec3f_load(&self->min, FLT_MAX, FLT_MAX, FLT_MAX);
+	cc_vec3f_load(&self->max, -FLT_MAX, -FLT_MAX, -FLT_MAX);
+	cc_vec3f_load(&self->center, 0.0f, 0.0f, 0.0f);
+	self->radius = -1.0f;
+}
+
+int gltf_bound_isEmpty(const gltf_bound_t* self)
+{
+	ASSERT(self);
+
+	return self->radius < 0.0f;
+}
+
+void gltf_bound_union(gltf_bound_t* self,
+                      const gltf_bound_t* bound)
+{
+	ASSERT(self);
+	ASSERT(bound);
+
+	if(gltf_bound_isEmpty(bound))
+	{
+		return;
+	}
+	else if(gltf_bound_isEmpty(self))
+	{
+		*self = *bound;
+		return;
+	}
+
+	self->min.x = fminf(self->min.x, bound->min.x);
+	self->min.y = fminf(self->min.y, bound->min.y);
+	self->min.z = fminf(self->min.z, bound->min.z);
+	self->max.x = fmaxf(self->max.x, bound->max.x);
+	self->max.y = fmaxf(self->max.y, bound->max.y);
+	self->max.z = fmaxf(self->max.z, bound->max.z);
+
+	// smallest sphere containing both spheres
+	float dx = bound->center.x - self->center.x;
+	float dy = bound->center.y - self->center.y;
+	float dz = bound->center.z - self->center.z;
+	float d  = sqrtf(dx*dx + dy*dy + dz*dz);
+	if(d + bound->radius <= self->radius)
+	{
+		return;
+	}
+	else if(d + self->radius <= bound->radius)
+	{
+		self->center = bound->center;
+		self->radius = bound->radius;
+		return;
+	}
+
+	float r = 0.5f*(d + self->radius + bound->radius);
+	float s = (r - self->radius)/d;
+	self->center.x += s*dx;
+	self->center.y += s*dy;
+	self->center.z += s*dz;
+	self->radius    = r;
+}
+
+void gltf_bound_transform(gltf_bound_t* self,
+                          const gltf_bound_t* bound,
+                          const cc_mat4f_t* matrix)
+{
+	ASSERT(self);
+	ASSERT(bound);
+	ASSERT(matrix);
+
+	if(gltf_bound_isEmpty(bound))
+	{
+		gltf_bound_empty(self);
+		return;
+	}
+
+	// transform the box center and the extents by the
+	// absolute matrix (Arvo) which is exact for the box
+	// corners
+	const float* m = (const float*) matrix;
+	const float  c[3] =
+	{
+		0.5f*(bound->min.x + bound->max.x),
+		0.5f*(bound->min.y + bound->max.y),
+		0.5f*(bound->min.z + bound->max.z),
+	};
+	const float e[3] =
+	{
+		0.5f*(bound->max.x - bound->min.x),
+		0.5f*(bound->max.y - bound->min.y),
+		0.5f*(bound->max.z - bound->min.z),
+	};
+	const float* sc = (const float*) &bound->center;
+	float*       mn = (float*) &self->min;
+	float*       mx = (float*) &self->max;
+	float*       oc = (float*) &self->center;
+
+	uint32_t r;
+	uint32_t k;
+	for(r = 0; r < 3; ++r)
+	{
+		float cr = m[12 + r];
+		float er = 0.0f;
+		float sr = m[12 + r];
+		for(k = 0; k < 3; ++k)
+		{
+			cr += m[4*k + r]*c[k];
+			er += fabsf(m[4*k + r])*e[k];
+			sr += m[4*k + r]*sc[k];
+		}
+		mn[r] = cr - er;
+		mx[r] = cr + er;
+		oc[r] = sr;
+	}
+
+	self->radius = bound->radius*gltf_bound_maxScale(m);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_bounds_H
+#define gltf_bounds_H
+
+#include "gltf.h"
+#include "gltf_transforms.h"
+
+// axis-aligned box and bounding sphere where empty bounds
+// have min > max and a negative radius
+typedef struct gltf_bound_s
+{
+	cc_vec3f_t min;
+	cc_vec3f_t max;
+	cc_vec3f_t center;
+	float      radius;
+} gltf_bound_t;
+
+// primitive and mesh bounds are in local space and are
+// computed from the POSITION accessor min/max or from a
+// scan of the POSITION data when min/max is absent
+// node bounds contain the node mesh while subtree bounds
+// also contain the descendants of the node and both are
+// in world space
+typedef struct gltf_bounds_s
+{
+	// the primitives of mesh i are stored at
+	// primitives[primitive_offsets[i]]
+	uint32_t      mesh_count;
+	uint32_t*     primitive_offsets;
+	gltf_bound_t* primitives;
+	gltf_bound_t* meshes;
+
+	uint32_t      node_count;
+	gltf_bound_t* nodes;
+	gltf_bound_t* subtrees;
+
+	uint32_t      scene_count;
+	gltf_bound_t* scenes;
+} gltf_bounds_t;
+
+// gltf_bounds_new computes the world space bounds from the
+// node matrices while gltf_bounds_update recomputes the
+// world space bounds from the transforms (e.g. after an
+// animation) where nodes outside of the transforms and
+// scenes whose nodes are outside of the transforms are
+// empty
+gltf_bounds_t*      gltf_bounds_new(gltf_file_t* file);
+void                gltf_bounds_delete(gltf_bounds_t** _self);
+int                 gltf_bounds_update(gltf_bounds_t* self,
+                                       gltf_file_t* file,
+                                       gltf_transforms_t* transforms);
+const gltf_bound_t* gltf_bounds_getPrimitive(gltf_bounds_t* self,
+                                             uint32_t mesh,
+                                             uint32_t primitive);
+
+void gltf_bound_empty(gltf_bound_t* self);
+int  gltf_bound_isEmpty(const gltf_bound_t* self);
+void gltf_bound_union(gltf_bound_t* self,
+                      const gltf_bound_t* bound);
+void gltf_bound_transform(gltf_bound_t* self,
+                          const gltf_bound_t* bound,
+                          const cc_mat4f_t* matrix);
+
+#endif
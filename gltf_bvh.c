@@ -0,0 +1,915 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <float.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_bvh.h"
+
+#define GLTF_BVH_BINS      16
+#define GLTF_BVH_LEAF_SIZE 4
+
+// minimum subtree size to build on a separate thread
+#define GLTF_BVH_PARALLEL_SIZE 4096
+
+/***********************************************************
+* private - box                                            *
+***********************************************************/
+
+// comparisons compile to minss/maxss unlike fminf/fmaxf
+// which must also handle NaN
+static float gltf_bvh_min(float a, float b)
+{
+	return (a < b) ? a : b;
+}
+
+static float gltf_bvh_max(float a, float b)
+{
+	return (a > b) ? a : b;
+}
+
+static void gltf_bvhBox_empty(gltf_bvhBox_t* self)
+{
+	ASSERT(self);
+
+	cc_vec3f_load(&self->min, FLT_MAX, FLT_MAX, FLT_MAX);
+	cc_vec3f_load(&self->max, -FLT_MAX, -FLT_MAX, -FLT_MAX);
+}
+
+static int gltf_bvhBox_isEmpty(const gltf_bvhBox_t* self)
+{
+	ASSERT(self);
+
+	return (self->min.x > self->max.x) ||
+	       (self->min.y > self->max.y) ||
+	       (self->min.z > self->max.z);
+}
+
+static void
+gltf_bvhBox_union(gltf_bvhBox_t* self, const gltf_bvhBox_t* box)
+{
+	ASSERT(self);
+	ASSERT(box);
+
+	self->min.x = gltf_bvh_min(self->min.x, box->min.x);
+	self->min.y = gltf_bvh_min(self->min.y, box->min.y);
+	self->min.z = gltf_bvh_min(self->min.z, box->min.z);
+	self->max.x = gltf_bvh_max(self->max.x, box->max.x);
+	self->max.y = gltf_bvh_max(self->max.y, box->max.y);
+	self->max.z = gltf_bvh_max(self->max.z, box->max.z);
+}
+
+static float gltf_bvhBox_area(const gltf_bvhBox_t* self)
+{
+	ASSERT(self);
+
+	if(gltf_bvhBox_isEmpty(self))
+	{
+		return 0.0f;
+	}
+
+	float dx = self->max.x - self->min.x;
+	float dy = self->max.y - self->min.y;
+	float dz = self->max.z - self->min.z;
+	return 2.0f*(dx*dy + dy*dz + dz*dx);
+}
+
+static void
+gltf_bvhBox_load(gltf_bvhBox_t* self, const gltf_bound_t* bound)
+{
+	ASSERT(self);
+	ASSERT(bound);
+
+	if(gltf_bound_isEmpty(bound))
+	{
+		gltf_bvhBox_empty(self);
+		return;
+	}
+
+	self->min = bound->min;
+	self->max = bound->max;
+}
+
+/***********************************************************
+* private - build                                          *
+***********************************************************/
+
+static void
+gltf_bvh_swap(gltf_bvh_t* self, float* centroids,
+              uint32_t i, uint32_t j)
+{
+	ASSERT(self);
+	ASSERT(centroids);
+
+	uint32_t item = self->items[i];
+	self->items[i] = self->items[j];
+	self->items[j] = item;
+
+	gltf_bvhBox_t box = self->boxes[i];
+	self->boxes[i] = self->boxes[j];
+	self->boxes[j] = box;
+
+	uint32_t k;
+	for(k = 0; k < 3; ++k)
+	{
+		float c = centroids[3*i + k];
+		centroids[3*i + k] = centroids[3*j + k];
+		centroids[3*j + k] = c;
+	}
+}
+
+static uint32_t
+gltf_bvh_split(gltf_bvh_t* self, float* centroids,
+               uint32_t start, uint32_t end, float area,
+               const float* cmin, const float* cmax)
+{
+	ASSERT(self);
+	ASSERT(centroids);
+	ASSERT(cmin);
+	ASSERT(cmax);
+
+	uint32_t n = end - start;
+
+	// split along the largest centroid extent
+	uint32_t axis = 0;
+	uint32_t k;
+	for(k = 1; k < 3; ++k)
+	{
+		if(cmax[k] - cmin[k] > cmax[axis] - cmin[axis])
+		{
+			axis = k;
+		}
+	}
+
+	// coincident centroids cannot be binned so split the
+	// range in half unless it fits in a leaf
+	float extent = cmax[axis] - cmin[axis];
+	if(extent <= 0.0f)
+	{
+		return (n <= GLTF_BVH_LEAF_SIZE) ? end : start + n/2;
+	}
+
+	uint32_t      bin_counts[GLTF_BVH_BINS];
+	gltf_bvhBox_t bin_boxes[GLTF_BVH_BINS];
+	uint32_t      b;
+	for(b = 0; b < GLTF_BVH_BINS; ++b)
+	{
+		bin_counts[b] = 0;
+		gltf_bvhBox_empty(&bin_boxes[b]);
+	}
+
+	float    scale = ((float) GLTF_BVH_BINS)/extent;
+	uint32_t i;
+	for(i = start; i < end; ++i)
+	{
+		b = (uint32_t) ((centroids[3*i + axis] - cmin[axis])*scale);
+		if(b >= GLTF_BVH_BINS)
+		{
+			b = GLTF_BVH_BINS - 1;
+		}
+		++bin_counts[b];
+		gltf_bvhBox_union(&bin_boxes[b], &self->boxes[i]);
+	}
+
+	// sweep from the right to accumulate the right side
+	// costs and then from the left to find the best split
+	float         right_costs[GLTF_BVH_BINS];
+	uint32_t      count = 0;
+	gltf_bvhBox_t box;
+	gltf_bvhBox_empty(&box);
+	for(b = GLTF_BVH_BINS - 1; b > 0; --b)
+	{
+		count += bin_counts[b];
+		gltf_bvhBox_union(&box, &bin_boxes[b]);
+		right_costs[b] = -1.0f;
+		if(count)
+		{
+			right_costs[b] = ((float) count)*gltf_bvhBox_area(&box);
+		}
+	}
+
+	uint32_t best      = GLTF_BVH_BINS;
+	float    best_cost = FLT_MAX;
+	count = 0;
+	gltf_bvhBox_empty(&box);
+	for(b = 0; b < GLTF_BVH_BINS - 1; ++b)
+	{
+		count += bin_counts[b];
+		gltf_bvhBox_union(&box, &bin_boxes[b]);
+		if((count == 0) || (right_costs[b + 1] < 0.0f))
+		{
+			continue;
+		}
+
+		float cost = ((float) count)*gltf_bvhBox_area(&box) +
+		             right_costs[b + 1];
+		if(cost < best_cost)
+		{
+			best      = b;
+			best_cost = cost;
+		}
+	}
+
+	// SAH with unit traversal and intersection costs
+	if((n <= GLTF_BVH_LEAF_SIZE) &&
+	   (((float) n)*area <= area + best_cost))
+	{
+		return end;
+	}
+
+	i = start;
+	uint32_t j = end;
+	while(i < j)
+	{
+		b = (uint32_t) ((centroids[3*i + axis] - cmin[axis])*scale);
+		if(b >= GLTF_BVH_BINS)
+		{
+			b = GLTF_BVH_BINS - 1;
+		}
+
+		if(b <= best)
+		{
+			++i;
+		}
+		else
+		{
+			gltf_bvh_swap(self, centroids, i, --j);
+		}
+	}
+
+	return i;
+}
+
+typedef struct
+{
+	gltf_bvh_t* self;
+	float*      centroids;
+	uint32_t    idx;
+	uint32_t    start;
+	uint32_t    end;
+	uint32_t    depth;
+	uint32_t    thread_count;
+} gltf_bvhTask_t;
+
+static void gltf_bvh_build(gltf_bvhTask_t* task);
+
+static void* gltf_bvh_thread(void* arg)
+{
+	ASSERT(arg);
+
+	gltf_bvh_build((gltf_bvhTask_t*) arg);
+	return NULL;
+}
+
+static void gltf_bvh_build(gltf_bvhTask_t* task)
+{
+	ASSERT(task);
+
+	gltf_bvh_t*     self      = task->self;
+	float*          centroids = task->centroids;
+	uint32_t        start     = task->start;
+	uint32_t        end       = task->end;
+	gltf_bvhNode_t* node      = &self->nodes[task->idx];
+
+	float cmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float cmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	gltf_bvhBox_empty(&node->box);
+
+	uint32_t i;
+	uint32_t k;
+	for(i = start; i < end; ++i)
+	{
+		gltf_bvhBox_union(&node->box, &self->boxes[i]);
+		for(k = 0; k < 3; ++k)
+		{
+			cmin[k] = gltf_bvh_min(cmin[k], centroids[3*i + k]);
+			cmax[k] = gltf_bvh_max(cmax[k], centroids[3*i + k]);
+		}
+	}
+
+	uint32_t mid = end;
+	if((end - start > 1) && (task->depth + 1 < GLTF_BVH_MAX_DEPTH))
+	{
+		mid = gltf_bvh_split(self, centroids, start, end,
+		                     gltf_bvhBox_area(&node->box),
+		                     cmin, cmax);
+	}
+
+	if((mid == start) || (mid == end))
+	{
+		node->offset = start;
+		node->count  = end - start;
+		return;
+	}
+
+	// each subtree of n items reserves the 2n - 1 nodes of
+	// the worst case so subtrees may be built concurrently
+	// and the unused nodes are removed by gltf_bvh_compact
+	node->offset = task->idx + 2*(mid - start);
+	node->count  = 0;
+
+	gltf_bvhTask_t left =
+	{
+		.self         = self,
+		.centroids    = centroids,
+		.idx          = task->idx + 1,
+		.start        = start,
+		.end          = mid,
+		.depth        = task->depth + 1,
+		.thread_count = task->thread_count/2,
+	};
+
+	gltf_bvhTask_t right =
+	{
+		.self         = self,
+		.centroids    = centroids,
+		.idx          = node->offset,
+		.start        = mid,
+		.end          = end,
+		.depth        = task->depth + 1,
+		.thread_count = task->thread_count - left.thread_count,
+	};
+
+	pthread_t thread;
+	if((left.thread_count > 0) &&
+	   (mid - start >= GLTF_BVH_PARALLEL_SIZE) &&
+	   (pthread_create(&thread, NULL, gltf_bvh_thread,
+	                   &left) == 0))
+	{
+		gltf_bvh_build(&right);
+		pthread_join(thread, NULL);
+	}
+	else
+	{
+		left.thread_count  = 1;
+		right.thread_count = task->thread_count;
+		gltf_bvh_build(&left);
+		gltf_bvh_build(&right);
+	}
+}
+
+static uint32_t
+gltf_bvh_compact(gltf_bvhNode_t* dst, uint32_t* _count,
+                 const gltf_bvhNode_t* src, uint32_t idx)
+{
+	ASSERT(dst);
+	ASSERT(_count);
+	ASSERT(src);
+
+	// depth first copy which preserves the layout
+	uint32_t i = (*_count)++;
+	dst[i] = src[idx];
+	if(src[idx].count == 0)
+	{
+		gltf_bvh_compact(dst, _count, src, idx + 1);
+		dst[i].offset = gltf_bvh_compact(dst, _count, src,
+		                                 src[idx].offset);
+	}
+
+	return i;
+}
+
+static int
+gltf_bvh_buildItems(gltf_bvh_t* self, uint32_t thread_count)
+{
+	ASSERT(self);
+
+	thread_count = gltf_file_threadCount(thread_count);
+
+	uint32_t n = self->item_count;
+	if(n == 0)
+	{
+		return 1;
+	}
+
+	// a binary tree with n leaves has 2n - 1 nodes
+	gltf_bvhNode_t* nodes;
+	nodes = (gltf_bvhNode_t*)
+	        CALLOC(2*n, sizeof(gltf_bvhNode_t));
+	self->nodes = (gltf_bvhNode_t*)
+	              CALLOC(2*n, sizeof(gltf_bvhNode_t));
+
+	float* centroids;
+	centroids = (float*) CALLOC(3*n, sizeof(float));
+	if((nodes == NULL) || (self->nodes == NULL) ||
+	   (centroids == NULL))
+	{
+		LOGE("CALLOC failed");
+		goto fail_alloc;
+	}
+
+	uint32_t i;
+	for(i = 0; i < n; ++i)
+	{
+		gltf_bvhBox_t* box = &self->boxes[i];
+		centroids[3*i]     = 0.5f*(box->min.x + box->max.x);
+		centroids[3*i + 1] = 0.5f*(box->min.y + box->max.y);
+		centroids[3*i + 2] = 0.5f*(box->min.z + box->max.z);
+	}
+
+	gltf_bvhTask_t task =
+	{
+		.self         = self,
+		.centroids    = centroids,
+		.idx          = 0,
+		.start        = 0,
+		.end          = n,
+		.depth        = 0,
+		.thread_count = thread_count,
+	};
+	gltf_bvh_build(&task);
+
+	gltf_bvh_compact(nodes, &self->node_count, self->nodes, 0);
+	FREE(self->nodes);
+	self->nodes = nodes;
+
+	FREE(centroids);
+
+	// success
+	return 1;
+
+	// failure
+	fail_alloc:
+		FREE(centroids);
+		FREE(self->nodes);
+		FREE(nodes);
+		self->nodes = NULL;
+	return 0;
+}
+
+/***********************************************************
+* private - query                                          *
+***********************************************************/
+
+static int
+gltf_bvh_test(const gltf_bvhQuery_t* query,
+              const float* inv, const gltf_bvhBox_t* box)
+{
+	ASSERT(query);
+	ASSERT(inv);
+	ASSERT(box);
+
+	if(gltf_bvhBox_isEmpty(box))
+	{
+		return 0;
+	}
+
+	if(query->type == GLTF_BVH_QUERY_AABB)
+	{
+		const gltf_bvhBox_t* a = &query->aabb;
+		return (a->min.x <= box->max.x) && (a->max.x >= box->min.x) &&
+		       (a->min.y <= box->max.y) && (a->max.y >= box->min.y) &&
+		       (a->min.z <= box->max.z) && (a->max.z >= box->min.z);
+	}
+	else if(query->type == GLTF_BVH_QUERY_FRUSTUM)
+	{
+		// the box is outside when the corner furthest along
+		// the plane normal is outside
+		uint32_t i;
+		for(i = 0; i < 6; ++i)
+		{
+			const cc_vec4f_t* p = &query->planes[i];
+			float x = (p->x >= 0.0f) ? box->max.x : box->min.x;
+			float y = (p->y >= 0.0f) ? box->max.y : box->min.y;
+			float z = (p->z >= 0.0f) ? box->max.z : box->min.z;
+			if(p->x*x + p->y*y + p->z*z + p->w < 0.0f)
+			{
+				return 0;
+			}
+		}
+		return 1;
+	}
+	else if(query->type == GLTF_BVH_QUERY_RAY)
+	{
+		float t;
+		return gltf_bvhBox_intersectRay(box,
+		                                (const float*) &query->ray.origin,
+		                                inv, query->ray.tmax, &t);
+	}
+
+	return 0;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_bvh_t* gltf_bvh_new(gltf_bounds_t* bounds)
+{
+	ASSERT(bounds);
+
+	gltf_bvh_t* self;
+	self = (gltf_bvh_t*) CALLOC(1, sizeof(gltf_bvh_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	if(gltf_bvh_rebuild(self, bounds) == 0)
+	{
+		goto fail_rebuild;
+	}
+
+	// success
+	return self;
+
+	// failure
+	fail_rebuild:
+		FREE(self);
+	return NULL;
+}
+
+void gltf_bvh_delete(gltf_bvh_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_bvh_t* self = *_self;
+	if(self)
+	{
+		FREE(self->boxes);
+		FREE(self->items);
+		FREE(self->nodes);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+int gltf_bvh_rebuild(gltf_bvh_t* self, gltf_bounds_t* bounds)
+{
+	ASSERT(self);
+	ASSERT(bounds);
+
+	FREE(self->boxes);
+	FREE(self->items);
+	FREE(self->nodes);
+	self->boxes      = NULL;
+	self->items      = NULL;
+	self->nodes      = NULL;
+	self->node_count = 0;
+	self->item_count = 0;
+
+	uint32_t i;
+	uint32_t n = 0;
+	for(i = 0; i < bounds->node_count; ++i)
+	{
+		if(gltf_bound_isEmpty(&bounds->nodes[i]) == 0)
+		{
+			++n;
+		}
+	}
+
+	self->items = (uint32_t*) CALLOC(n + 1, sizeof(uint32_t));
+	self->boxes = (gltf_bvhBox_t*)
+	              CALLOC(n + 1, sizeof(gltf_bvhBox_t));
+	if((self->items == NULL) || (self->boxes == NULL))
+	{
+		LOGE("CALLOC failed");
+		goto fail_alloc;
+	}
+
+	for(i = 0; i < bounds->node_count; ++i)
+	{
+		gltf_bound_t* bound = &bounds->nodes[i];
+		if(gltf_bound_isEmpty(bound))
+		{
+			continue;
+		}
+
+		uint32_t k = self->item_count++;
+		self->items[k] = i;
+		gltf_bvhBox_load(&self->boxes[k], bound);
+	}
+
+	if(gltf_bvh_buildItems(self, 1) == 0)
+	{
+		goto fail_build;
+	}
+
+	// success
+	return 1;
+
+	// failure
+	fail_build:
+	fail_alloc:
+		FREE(self->boxes);
+		FREE(self->items);
+		self->boxes      = NULL;
+		self->items      = NULL;
+		self->item_count = 0;
+	return 0;
+}
+
+gltf_bvh_t*
+gltf_bvh_newBoxes(uint32_t count, const gltf_bvhBox_t* boxes,
+                  uint32_t thread_count)
+{
+	ASSERT(boxes);
+
+	gltf_bvh_t* self;
+	self = (gltf_bvh_t*) CALLOC(1, sizeof(gltf_bvh_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->items = (uint32_t*) CALLOC(count + 1, sizeof(uint32_t));
+	self->boxes = (gltf_bvhBox_t*)
+	              CALLOC(count + 1, sizeof(gltf_bvhBox_t));
+	if((self->items == NULL) || (self->boxes == NULL))
+	{
+		LOGE("CALLOC failed");
+		goto fail_alloc;
+	}
+
+	uint32_t i;
+	for(i = 0; i < count; ++i)
+	{
+		self->items[i] = i;
+		self->boxes[i] = boxes[i];
+	}
+	self->item_count = count;
+
+	if(gltf_bvh_buildItems(self, thread_count) == 0)
+	{
+		goto fail_build;
+	}
+
+	// success
+	return self;
+
+	// failure
+	fail_build:
+	fail_alloc:
+		gltf_bvh_delete(&self);
+	return NULL;
+}
+
+void gltf_bvh_refit(gltf_bvh_t* self, gltf_bounds_t* bounds)
+{
+	ASSERT(self);
+	ASSERT(bounds);
+
+	uint32_t i;
+	for(i = 0; i < self->item_count; ++i)
+	{
+		uint32_t item = self->items[i];
+		if(item < bounds->node_count)
+		{
+			gltf_bvhBox_load(&self->boxes[i], &bounds->nodes[item]);
+		}
+		else
+		{
+			gltf_bvhBox_empty(&self->boxes[i]);
+		}
+	}
+
+	// children follow their parents so the reverse order
+	// refits the children first
+	for(i = self->node_count; i > 0; --i)
+	{
+		gltf_bvhNode_t* node = &self->nodes[i - 1];
+		gltf_bvhBox_empty(&node->box);
+		if(node->count)
+		{
+			uint32_t j;
+			for(j = 0; j < node->count; ++j)
+			{
+				gltf_bvhBox_union(&node->box,
+				                  &self->boxes[node->offset + j]);
+			}
+		}
+		else
+		{
+			gltf_bvhBox_union(&node->box, &self->nodes[i].box);
+			gltf_bvhBox_union(&node->box,
+			                  &self->nodes[node->offset].box);
+		}
+	}
+}
+
+int gltf_bvh_query(gltf_bvh_t* self, uint32_t count,
+                   const gltf_bvhQuery_t* queries,
+                   uint32_t* counts, uint32_t* results)
+{
+	ASSERT(self);
+	ASSERT(queries);
+	ASSERT(counts);
+	ASSERT(results);
+
+	if(count > GLTF_BVH_MAX_QUERIES)
+	{
+		LOGE("invalid count=%u", count);
+		return 0;
+	}
+
+	uint32_t q;
+	float    inv[3*GLTF_BVH_MAX_QUERIES];
+	for(q = 0; q < count; ++q)
+	{
+		counts[q] = 0;
+		if(queries[q].type == GLTF_BVH_QUERY_RAY)
+		{
+			const cc_vec3f_t* dir = &queries[q].ray.dir;
+			inv[3*q]     = 1.0f/dir->x;
+			inv[3*q + 1] = 1.0f/dir->y;
+			inv[3*q + 2] = 1.0f/dir->z;
+		}
+	}
+
+	if((count == 0) || (self->node_count == 0))
+	{
+		return 1;
+	}
+
+	// each stack entry holds a node and the mask of the
+	// queries which intersect its parent
+	uint32_t stack_nodes[GLTF_BVH_MAX_DEPTH + 1];
+	uint32_t stack_masks[GLTF_BVH_MAX_DEPTH + 1];
+	uint32_t depth = 1;
+	stack_nodes[0] = 0;
+	stack_masks[0] = (count == 32) ? 0xFFFFFFFF :
+	                                 ((1u << count) - 1);
+	while(depth)
+	{
+		--depth;
+		uint32_t        idx  = stack_nodes[depth];
+		uint32_t        mask = stack_masks[depth];
+		gltf_bvhNode_t* node = &self->nodes[idx];
+
+		uint32_t hits = 0;
+		for(q = 0; q < count; ++q)
+		{
+			if((mask & (1u << q)) &&
+			   gltf_bvh_test(&queries[q], &inv[3*q], &node->box))
+			{
+				hits |= 1u << q;
+			}
+		}
+
+		if(hits == 0)
+		{
+			continue;
+		}
+
+		if(node->count == 0)
+		{
+			// visit the left child first
+			stack_nodes[depth]   = node->offset;
+			stack_masks[depth++] = hits;
+			stack_nodes[depth]   = idx + 1;
+			stack_masks[depth++] = hits;
+			continue;
+		}
+
+		uint32_t i;
+		for(i = node->offset; i < node->offset + node->count; ++i)
+		{
+			for(q = 0; q < count; ++q)
+			{
+				if((hits & (1u << q)) &&
+				   gltf_bvh_test(&queries[q], &inv[3*q],
+				                 &self->boxes[i]))
+				{
+					results[q*self->item_count + counts[q]] =
+						self->items[i];
+					++counts[q];
+				}
+			}
+		}
+	}
+
+	return 1;
+}
+
+uint32_t gltf_bvh_queryAABB(gltf_bvh_t* self,
+                            const gltf_bvhBox_t* aabb,
+                            uint32_t* results)
+{
+	ASSERT(self);
+	ASSERT(aabb);
+	ASSERT(results);
+
+	gltf_bvhQuery_t query =
+	{
+		.type = GLTF_BVH_QUERY_AABB,
+		.aabb = *aabb,
+	};
+
+	uint32_t count = 0;
+	gltf_bvh_query(self, 1, &query, &count, results);
+	return count;
+}
+
+uint32_t gltf_bvh_queryFrustum(gltf_bvh_t* self,
+                               const cc_vec4f_t* planes,
+                               uint32_t* results)
+{
+	ASSERT(self);
+	ASSERT(planes);
+	ASSERT(results);
+
+	gltf_bvhQuery_t query =
+	{
+		.type = GLTF_BVH_QUERY_FRUSTUM,
+	};
+	memcpy(query.planes, planes, sizeof(query.planes));
+
+	uint32_t count = 0;
+	gltf_bvh_query(self, 1, &query, &count, results);
+	return count;
+}
+
+uint32_t gltf_bvh_queryRay(gltf_bvh_t* self,
+                           const cc_vec3f_t* origin,
+                           const cc_vec3f_t* dir,
+                           float tmax,
+                           uint32_t* results)
+{
+	ASSERT(self);
+	ASSERT(origin);
+	ASSERT(dir);
+	ASSERT(results);
+
+	gltf_bvhQuery_t query =
+	{
+		.type = GLTF_BVH_QUERY_RAY,
+		.ray  =
+		{
+			.origin = *origin,
+			.dir    = *dir,
+			.tmax   = tmax,
+		},
+	};
+
+	uint32_t count = 0;
+	gltf_bvh_query(self, 1, &query, &count, results);
+	return count;
+}
+
+int gltf_bvhBox_intersectRay(const gltf_bvhBox_t* self,
+                             const float* origin,
+                             const float* inv,
+                             float tmax, float* _t)
+{
+	ASSERT(self);
+	ASSERT(origin);
+	ASSERT(inv);
+	ASSERT(_t);
+
+	const float* bmin = (const float*) &self->min;
+	const float* bmax = (const float*) &self->max;
+
+	float t0 = 0.0f;
+	float t1 = tmax;
+	int   i;
+	for(i = 0; i < 3; ++i)
+	{
+		// the slab distances of a ray parallel to the slab
+		// are infinite or NaN (0*inf) when the origin lies
+		// on the boundary so the origin is tested instead
+		if(isinf(inv[i]))
+		{
+			if((origin[i] < bmin[i]) || (origin[i] > bmax[i]))
+			{
+				return 0;
+			}
+			continue;
+		}
+
+		float ta = (bmin[i] - origin[i])*inv[i];
+		float tb = (bmax[i] - origin[i])*inv[i];
+		t0 = gltf_bvh_max(t0, gltf_bvh_min(ta, tb));
+		t1 = gltf_bvh_min(t1, gltf_bvh_max(ta, tb));
+	}
+
+	*_t = t0;
+	return t0 <= t1;
+}
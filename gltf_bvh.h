@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_bvh_H
+#define gltf_bvh_H
+
+#include "gltf.h"
+#include "gltf_bounds.h"
+
+#define GLTF_BVH_MAX_QUERIES 32
+
+// the depth is limited so traversal may use a fixed stack
+// and queries do not modify the hierarchy
+#define GLTF_BVH_MAX_DEPTH 64
+
+typedef struct gltf_bvhBox_s
+{
+	cc_vec3f_t min;
+	cc_vec3f_t max;
+} gltf_bvhBox_t;
+
+// the left child of an inner node immediately follows the
+// node while the right child is stored at offset
+// leaves reference the items [offset, offset + count)
+typedef struct gltf_bvhNode_s
+{
+	gltf_bvhBox_t box;
+	uint32_t      offset;
+	uint32_t      count; // zero for inner nodes
+} gltf_bvhNode_t;
+
+// binned SAH hierarchy where items are the glTF node
+// indices of the nodes which contain a mesh (gltf_bvh_new)
+// or the box indices (gltf_bvh_newBoxes) and boxes are the
+// item bounds
+typedef struct gltf_bvh_s
+{
+	uint32_t        node_count;
+	gltf_bvhNode_t* nodes;
+
+	uint32_t       item_count;
+	uint32_t*      items;
+	gltf_bvhBox_t* boxes;
+} gltf_bvh_t;
+
+typedef enum
+{
+	GLTF_BVH_QUERY_AABB,
+	GLTF_BVH_QUERY_FRUSTUM,
+	GLTF_BVH_QUERY_RAY,
+} gltf_bvhQueryType_e;
+
+// frustum planes (a,b,c,d) contain the points where
+// a*x + b*y + c*z + d >= 0
+// rays test against the item boxes for 0 <= t <= tmax
+typedef struct gltf_bvhQuery_s
+{
+	gltf_bvhQueryType_e type;
+	union
+	{
+		gltf_bvhBox_t aabb;
+		cc_vec4f_t    planes[6];
+		struct
+		{
+			cc_vec3f_t origin;
+			cc_vec3f_t dir;
+			float      tmax;
+		} ray;
+	};
+} gltf_bvhQuery_t;
+
+// gltf_bvh_refit updates the boxes from new bounds (e.g.
+// after gltf_bounds_update) while gltf_bvh_rebuild also
+// rebuilds the hierarchy which is preferred when the nodes
+// have moved significantly or the set of meshes changed
+gltf_bvh_t* gltf_bvh_new(gltf_bounds_t* bounds);
+void        gltf_bvh_delete(gltf_bvh_t** _self);
+
+// build over caller boxes (e.g. triangles) where subtrees
+// are built across thread_count threads (0 for one per
+// processor)
+gltf_bvh_t* gltf_bvh_newBoxes(uint32_t count,
+                              const gltf_bvhBox_t* boxes,
+                              uint32_t thread_count);
+int         gltf_bvh_rebuild(gltf_bvh_t* self,
+                             gltf_bounds_t* bounds);
+void        gltf_bvh_refit(gltf_bvh_t* self,
+                           gltf_bounds_t* bounds);
+
+// perform up to GLTF_BVH_MAX_QUERIES queries in a single
+// traversal where the glTF node indices of query q are
+// stored at results[q*item_count] and the number of
+// results is stored at counts[q]
+int         gltf_bvh_query(gltf_bvh_t* self,
+                           uint32_t count,
+                           const gltf_bvhQuery_t* queries,
+                           uint32_t* counts,
+                           uint32_t* results);
+
+// single query helpers where results must hold item_count
+// elements and the number of results is returned
+uint32_t    gltf_bvh_queryAABB(gltf_bvh_t* self,
+                               const gltf_bvhBox_t* aabb,
+                               uint32_t* results);
+uint32_t    gltf_bvh_queryFrustum(gltf_bvh_t* self,
+                                  const cc_vec4f_t* planes,
+                                  uint32_t* results);
+uint32_t    gltf_bvh_queryRay(gltf_bvh_t* self,
+                              const cc_vec3f_t* origin,
+                              const cc_vec3f_t* dir,
+                              float tmax,
+                              uint32_t* results);
+
+// slab test of a ray against a box where inv is the
+// reciprocal of the ray direction and the entry distance
+// clamped to [0, tmax] is returned in _t
+// axis aligned rays (infinite inv) are tested against the
+// slab by the origin so rays on a slab boundary still hit
+int         gltf_bvhBox_intersectRay(const gltf_bvhBox_t* self,
+                                     const float* origin,
+                                     const float* inv,
+                                     float tmax, float* _t);
+
+#endif
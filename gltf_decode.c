@@ -0,0 +1,1490 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_decode.h"
+
+// source layout of an accessor element
+typedef struct
+{
+	uint32_t    cols;
+	uint32_t    rows;
+	uint32_t    csize;
+	uint32_t    col_stride;
+	uint32_t    elem_size;
+	uint32_t    stride;
+	const char* src;
+} gltf_decodeLayout_t;
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static uint32_t
+gltf_decode_componentSize(gltf_componentType_e componentType)
+{
+	if((componentType == GLTF_COMPONENT_TYPE_BYTE) ||
+	   (componentType == GLTF_COMPONENT_TYPE_UNSIGNED_BYTE))
+	{
+		return 1;
+	}
+	else if((componentType == GLTF_COMPONENT_TYPE_SHORT) ||
+	        (componentType == GLTF_COMPONENT_TYPE_UNSIGNED_SHORT))
+	{
+		return 2;
+	}
+	else if((componentType == GLTF_COMPONENT_TYPE_UNSIGNED_INT) ||
+	        (componentType == GLTF_COMPONENT_TYPE_FLOAT))
+	{
+		return 4;
+	}
+
+	return 0;
+}
+
+static int
+gltf_decode_shape(gltf_accessorType_e type,
+                  uint32_t* _cols, uint32_t* _rows)
+{
+	ASSERT(_cols);
+	ASSERT(_rows);
+
+	uint32_t cols = 1;
+	uint32_t rows = 1;
+	if(type == GLTF_ACCESSOR_TYPE_SCALAR)
+	{
+		rows = 1;
+	}
+	else if(type == GLTF_ACCESSOR_TYPE_VEC2)
+	{
+		rows = 2;
+	}
+	else if(type == GLTF_ACCESSOR_TYPE_VEC3)
+	{
+		rows = 3;
+	}
+	else if(type == GLTF_ACCESSOR_TYPE_VEC4)
+	{
+		rows = 4;
+	}
+	else if(type == GLTF_ACCESSOR_TYPE_MAT2)
+	{
+		cols = 2;
+		rows = 2;
+	}
+	else if(type == GLTF_ACCESSOR_TYPE_MAT3)
+	{
+		cols = 3;
+		rows = 3;
+	}
+	else if(type == GLTF_ACCESSOR_TYPE_MAT4)
+	{
+		cols = 4;
+		rows = 4;
+	}
+	else
+	{
+		LOGE("invalid type=%u", (uint32_t) type);
+		return 0;
+	}
+
+	*_cols = cols;
+	*_rows = rows;
+	return 1;
+}
+
+static int
+gltf_decode_layout(gltf_file_t* file,
+                   gltf_accessor_t* accessor,
+                   gltf_decodeLayout_t* layout)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(layout);
+
+	if(gltf_decode_shape(accessor->type, &layout->cols,
+	                     &layout->rows) == 0)
+	{
+		return 0;
+	}
+
+	gltf_componentType_e ct = accessor->componentType;
+	layout->csize = gltf_decode_componentSize(ct);
+	if(layout->csize == 0)
+	{
+		LOGE("invalid componentType=%u",
+		     (uint32_t) accessor->componentType);
+		return 0;
+	}
+
+	// matrix columns are aligned to 4 bytes
+	layout->col_stride = layout->rows*layout->csize;
+	if(layout->cols > 1)
+	{
+		layout->col_stride = (layout->col_stride + 3) & ~3u;
+	}
+	layout->elem_size = layout->cols*layout->col_stride;
+
+	if(accessor->has_bufferView == 0)
+	{
+		layout->stride = layout->elem_size;
+		layout->src    = NULL;
+		return 1;
+	}
+
+	gltf_bufferView_t* bufferView;
+	bufferView = gltf_file_getBufferView(file,
+	                                     accessor->bufferView);
+	if(bufferView == NULL)
+	{
+		return 0;
+	}
+
+	layout->stride = layout->elem_size;
+	if(bufferView->has_byteStride)
+	{
+		layout->stride = bufferView->byteStride;
+	}
+
+	if(layout->stride < layout->elem_size)
+	{
+		LOGE("invalid stride=%u, elem_size=%u",
+		     layout->stride, layout->elem_size);
+		return 0;
+	}
+
+	// check that the last element is within the bufferView
+	uint64_t end = (uint64_t) accessor->byteOffset;
+	if(accessor->count)
+	{
+		end += (uint64_t) layout->stride*(accessor->count - 1) +
+		       layout->elem_size;
+	}
+
+	if(end > bufferView->byteLength)
+	{
+		LOGE("invalid end=%" PRIu64 ", byteLength=%u",
+		     end, bufferView->byteLength);
+		return 0;
+	}
+
+	const char* buf = gltf_file_getBuffer(file, bufferView);
+	if(buf == NULL)
+	{
+		return 0;
+	}
+	layout->src = &buf[accessor->byteOffset];
+
+	return 1;
+}
+
+static float
+gltf_decode_readFloat(const char* src,
+                      gltf_componentType_e componentType,
+                      int normalized)
+{
+	ASSERT(src);
+
+	// memcpy handles unaligned sources
+	if(componentType == GLTF_COMPONENT_TYPE_FLOAT)
+	{
+		float f;
+		memcpy(&f, src, sizeof(float));
+		return f;
+	}
+	else if(componentType == GLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+	{
+		uint8_t u = (uint8_t) src[0];
+		return normalized ? (float) u/255.0f : (float) u;
+	}
+	else if(componentType == GLTF_COMPONENT_TYPE_BYTE)
+	{
+		int8_t i = (int8_t) src[0];
+		if(normalized)
+		{
+			float f = (float) i/127.0f;
+			return (f < -1.0f) ? -1.0f : f;
+		}
+		return (float) i;
+	}
+	else if(componentType == GLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+	{
+		uint16_t u;
+		memcpy(&u, src, sizeof(uint16_t));
+		return normalized ? (float) u/65535.0f : (float) u;
+	}
+	else if(componentType == GLTF_COMPONENT_TYPE_SHORT)
+	{
+		int16_t i;
+		memcpy(&i, src, sizeof(int16_t));
+		if(normalized)
+		{
+			float f = (float) i/32767.0f;
+			return (f < -1.0f) ? -1.0f : f;
+		}
+		return (float) i;
+	}
+
+	uint32_t u;
+	memcpy(&u, src, sizeof(uint32_t));
+	return normalized ? (float) ((double) u/4294967295.0) :
+	                    (float) u;
+}
+
+static uint32_t
+gltf_decode_readUint32(const char* src,
+                       gltf_componentType_e componentType)
+{
+	ASSERT(src);
+
+	if(componentType == GLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+	{
+		return (uint8_t) src[0];
+	}
+	else if(componentType == GLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+	{
+		uint16_t u;
+		memcpy(&u, src, sizeof(uint16_t));
+		return u;
+	}
+
+	uint32_t u;
+	memcpy(&u, src, sizeof(uint32_t));
+	return u;
+}
+
+static void
+gltf_decode_ubyteToFloat(const uint8_t* src, uint32_t n,
+                         float scale, float* dst)
+{
+	ASSERT(src);
+	ASSERT(dst);
+
+	uint32_t i = 0;
+	#if defined(__SSE2__)
+	__m128i zero = _mm_setzero_si128();
+	__m128  s    = _mm_set1_ps(scale);
+	for(; i + 16 <= n; i += 16)
+	{
+		__m128i v  = _mm_loadu_si128((const __m128i*) &src[i]);
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		__m128  f0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+		__m128  f1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+		__m128  f2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+		__m128  f3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero));
+		_mm_storeu_ps(&dst[i],      _mm_mul_ps(f0, s));
+		_mm_storeu_ps(&dst[i + 4],  _mm_mul_ps(f1, s));
+		_mm_storeu_ps(&dst[i + 8],  _mm_mul_ps(f2, s));
+		_mm_storeu_ps(&dst[i + 12], _mm_mul_ps(f3, s));
+	}
+	#elif defined(__ARM_NEON)
+	for(; i + 16 <= n; i += 16)
+	{
+		uint8x16_t  v  = vld1q_u8(&src[i]);
+		uint16x8_t  lo = vmovl_u8(vget_low_u8(v));
+		uint16x8_t  hi = vmovl_u8(vget_high_u8(v));
+		float32x4_t f0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo)));
+		float32x4_t f1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo)));
+		float32x4_t f2 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi)));
+		float32x4_t f3 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi)));
+		vst1q_f32(&dst[i],      vmulq_n_f32(f0, scale));
+		vst1q_f32(&dst[i + 4],  vmulq_n_f32(f1, scale));
+		vst1q_f32(&dst[i + 8],  vmulq_n_f32(f2, scale));
+		vst1q_f32(&dst[i + 12], vmulq_n_f32(f3, scale));
+	}
+	#endif
+
+	for(; i < n; ++i)
+	{
+		dst[i] = (float) src[i]*scale;
+	}
+}
+
+static void
+gltf_decode_ushortToFloat(const char* src, uint32_t n,
+                          float scale, float* dst)
+{
+	ASSERT(src);
+	ASSERT(dst);
+
+	uint32_t i = 0;
+	#if defined(__SSE2__)
+	__m128i zero = _mm_setzero_si128();
+	__m128  s    = _mm_set1_ps(scale);
+	for(; i + 8 <= n; i += 8)
+	{
+		__m128i v  = _mm_loadu_si128((const __m128i*) &src[2*i]);
+		__m128  f0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero));
+		__m128  f1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero));
+		_mm_storeu_ps(&dst[i],     _mm_mul_ps(f0, s));
+		_mm_storeu_ps(&dst[i + 4], _mm_mul_ps(f1, s));
+	}
+	#elif defined(__ARM_NEON)
+	for(; i + 8 <= n; i += 8)
+	{
+		uint8x16_t  b  = vld1q_u8((const uint8_t*) &src[2*i]);
+		uint16x8_t  v  = vreinterpretq_u16_u8(b);
+		float32x4_t f0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)));
+		float32x4_t f1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(v)));
+		vst1q_f32(&dst[i],     vmulq_n_f32(f0, scale));
+		vst1q_f32(&dst[i + 4], vmulq_n_f32(f1, scale));
+	}
+	#endif
+
+	for(; i < n; ++i)
+	{
+		uint16_t u;
+		memcpy(&u, &src[2*i], sizeof(uint16_t));
+		dst[i] = (float) u*scale;
+	}
+}
+
+static void
+gltf_decode_ushortToUint32(const char* src, uint32_t n,
+                           uint32_t* dst)
+{
+	ASSERT(src);
+	ASSERT(dst);
+
+	uint32_t i = 0;
+	#if defined(__SSE2__)
+	__m128i zero = _mm_setzero_si128();
+	for(; i + 8 <= n; i += 8)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*) &src[2*i]);
+		_mm_storeu_si128((__m128i*) &dst[i],
+		                 _mm_unpacklo_epi16(v, zero));
+		_mm_storeu_si128((__m128i*) &dst[i + 4],
+		                 _mm_unpackhi_epi16(v, zero));
+	}
+	#elif defined(__ARM_NEON)
+	for(; i + 8 <= n; i += 8)
+	{
+		uint8x16_t b = vld1q_u8((const uint8_t*) &src[2*i]);
+		uint16x8_t v = vreinterpretq_u16_u8(b);
+		vst1q_u32(&dst[i],     vmovl_u16(vget_low_u16(v)));
+		vst1q_u32(&dst[i + 4], vmovl_u16(vget_high_u16(v)));
+	}
+	#endif
+
+	for(; i < n; ++i)
+	{
+		uint16_t u;
+		memcpy(&u, &src[2*i], sizeof(uint16_t));
+		dst[i] = u;
+	}
+}
+
+static void
+gltf_decode_ubyteToUint32(const uint8_t* src, uint32_t n,
+                          uint32_t* dst)
+{
+	ASSERT(src);
+	ASSERT(dst);
+
+	uint32_t i = 0;
+	#if defined(__SSE2__)
+	__m128i zero = _mm_setzero_si128();
+	for(; i + 16 <= n; i += 16)
+	{
+		__m128i v  = _mm_loadu_si128((const __m128i*) &src[i]);
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i*) &dst[i],
+		                 _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i*) &dst[i + 4],
+		                 _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i*) &dst[i + 8],
+		                 _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i*) &dst[i + 12],
+		                 _mm_unpackhi_epi16(hi, zero));
+	}
+	#elif defined(__ARM_NEON)
+	for(; i + 16 <= n; i += 16)
+	{
+		uint8x16_t v  = vld1q_u8(&src[i]);
+		uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+		vst1q_u32(&dst[i],      vmovl_u16(vget_low_u16(lo)));
+		vst1q_u32(&dst[i + 4],  vmovl_u16(vget_high_u16(lo)));
+		vst1q_u32(&dst[i + 8],  vmovl_u16(vget_low_u16(hi)));
+		vst1q_u32(&dst[i + 12], vmovl_u16(vget_high_u16(hi)));
+	}
+	#endif
+
+	for(; i < n; ++i)
+	{
+		dst[i] = src[i];
+	}
+}
+
+static void
+gltf_decode_copyFloat(const gltf_decodeLayout_t* layout,
+                      uint32_t count, float* data)
+{
+	ASSERT(layout);
+	ASSERT(data);
+
+	// float columns are always 4 byte aligned so elements
+	// are a contiguous run of floats
+	uint32_t    n   = layout->cols*layout->rows;
+	const char* src = layout->src;
+	if(layout->stride == layout->elem_size)
+	{
+		memcpy(data, src, (size_t) count*n*sizeof(float));
+		return;
+	}
+
+	// strided (interleaved) views copy one element at a time
+	// where the constant sizes allow the compiler to emit a
+	// single vector move per element
+	uint32_t i;
+	if(n == 2)
+	{
+		for(i = 0; i < count; ++i)
+		{
+			memcpy(&data[2*i], src, 2*sizeof(float));
+			src += layout->stride;
+		}
+	}
+	else if(n == 3)
+	{
+		for(i = 0; i < count; ++i)
+		{
+			memcpy(&data[3*i], src, 3*sizeof(float));
+			src += layout->stride;
+		}
+	}
+	else if(n == 4)
+	{
+		for(i = 0; i < count; ++i)
+		{
+			memcpy(&data[4*i], src, 4*sizeof(float));
+			src += layout->stride;
+		}
+	}
+	else
+	{
+		for(i = 0; i < count; ++i)
+		{
+			memcpy(&data[n*i], src, n*sizeof(float));
+			src += layout->stride;
+		}
+	}
+}
+
+static int
+gltf_decode_denseFloat(gltf_file_t* file,
+                       gltf_accessor_t* accessor,
+                       float* data)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(data);
+
+	gltf_decodeLayout_t layout;
+	if(gltf_decode_layout(file, accessor, &layout) == 0)
+	{
+		return 0;
+	}
+
+	uint32_t             n     = layout.cols*layout.rows;
+	uint32_t             count = accessor->count;
+	gltf_componentType_e ct    = accessor->componentType;
+	if(layout.src == NULL)
+	{
+		memset(data, 0, (size_t) count*n*sizeof(float));
+		return 1;
+	}
+
+	if(ct == GLTF_COMPONENT_TYPE_FLOAT)
+	{
+		gltf_decode_copyFloat(&layout, count, data);
+		return 1;
+	}
+
+	// packed unsigned streams convert as a flat array
+	int packed = (layout.stride == layout.elem_size) &&
+	             (layout.col_stride == layout.rows*layout.csize);
+	if(packed && (ct == GLTF_COMPONENT_TYPE_UNSIGNED_BYTE))
+	{
+		float scale = accessor->normalized ? 1.0f/255.0f : 1.0f;
+		gltf_decode_ubyteToFloat((const uint8_t*) layout.src,
+		                         count*n, scale, data);
+		return 1;
+	}
+	else if(packed && (ct == GLTF_COMPONENT_TYPE_UNSIGNED_SHORT))
+	{
+		float scale = accessor->normalized ? 1.0f/65535.0f : 1.0f;
+		gltf_decode_ushortToFloat(layout.src, count*n,
+		                          scale, data);
+		return 1;
+	}
+
+	// generic path
+	uint32_t i;
+	uint32_t c;
+	uint32_t r;
+	const char* elem = layout.src;
+	for(i = 0; i < count; ++i)
+	{
+		for(c = 0; c < layout.cols; ++c)
+		{
+			const char* col = &elem[c*layout.col_stride];
+			for(r = 0; r < layout.rows; ++r)
+			{
+				const char* src = &col[r*layout.csize];
+				*data = gltf_decode_readFloat(src, ct,
+				                              accessor->normalized);
+				++data;
+			}
+		}
+		elem += layout.stride;
+	}
+
+	return 1;
+}
+
+static int
+gltf_decode_denseUint32(gltf_file_t* file,
+                        gltf_accessor_t* accessor,
+                        uint32_t* data)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(data);
+
+	gltf_componentType_e ct = accessor->componentType;
+	if((ct != GLTF_COMPONENT_TYPE_UNSIGNED_BYTE)  &&
+	   (ct != GLTF_COMPONENT_TYPE_UNSIGNED_SHORT) &&
+	   (ct != GLTF_COMPONENT_TYPE_UNSIGNED_INT))
+	{
+		LOGE("invalid componentType=%u", (uint32_t) ct);
+		return 0;
+	}
+
+	gltf_decodeLayout_t layout;
+	if(gltf_decode_layout(file, accessor, &layout) == 0)
+	{
+		return 0;
+	}
+
+	uint32_t n     = layout.cols*layout.rows;
+	uint32_t count = accessor->count;
+	if(layout.src == NULL)
+	{
+		memset(data, 0, (size_t) count*n*sizeof(uint32_t));
+		return 1;
+	}
+
+	int packed = (layout.stride == layout.elem_size) &&
+	             (layout.col_stride == layout.rows*layout.csize);
+	if(packed && (ct == GLTF_COMPONENT_TYPE_UNSIGNED_INT))
+	{
+		memcpy(data, layout.src,
+		       (size_t) count*n*sizeof(uint32_t));
+		return 1;
+	}
+	else if(packed && (ct == GLTF_COMPONENT_TYPE_UNSIGNED_SHORT))
+	{
+		gltf_decode_ushortToUint32(layout.src, count*n, data);
+		return 1;
+	}
+	else if(packed && (ct == GLTF_COMPONENT_TYPE_UNSIGNED_BYTE))
+	{
+		gltf_decode_ubyteToUint32((const uint8_t*) layout.src,
+		                          count*n, data);
+		return 1;
+	}
+
+	// generic path
+	uint32_t i;
+	uint32_t c;
+	uint32_t r;
+	const char* elem = layout.src;
+	for(i = 0; i < count; ++i)
+	{
+		for(c = 0; c < layout.cols; ++c)
+		{
+			const char* col = &elem[c*layout.col_stride];
+			for(r = 0; r < layout.rows; ++r)
+			{
+				const char* src = &col[r*layout.csize];
+				*data = gltf_decode_readUint32(src, ct);
+				++data;
+			}
+		}
+		elem += layout.stride;
+	}
+
+	return 1;
+}
+
+/***********************************************************
+* private - indices                                        *
+***********************************************************/
+
+// the index kernels convert a packed index stream to
+// dst16 or dst32 (or neither for a range scan) and
+// accumulate the min/max index in the same pass
+// SSE2 lacks unsigned 16/32-bit min/max so the values are
+// biased into the signed range for the compares
+// the 32-bit kernel uses AVX2 when enabled by the compiler
+// flags (e.g. -mavx2) since it scans twice the indices per
+// iteration without the bias
+
+#if defined(__SSE2__) && !defined(__AVX2__)
+static __m128i gltf_decode_min32(__m128i a, __m128i b)
+{
+	__m128i m = _mm_cmpgt_epi32(a, b);
+	return _mm_or_si128(_mm_and_si128(m, b),
+	                    _mm_andnot_si128(m, a));
+}
+
+static __m128i gltf_decode_max32(__m128i a, __m128i b)
+{
+	__m128i m = _mm_cmpgt_epi32(a, b);
+	return _mm_or_si128(_mm_and_si128(m, a),
+	                    _mm_andnot_si128(m, b));
+}
+#endif
+
+static void
+gltf_decode_range(uint32_t x, uint32_t* _min, uint32_t* _max)
+{
+	ASSERT(_min);
+	ASSERT(_max);
+
+	if(x < *_min)
+	{
+		*_min = x;
+	}
+	if(x > *_max)
+	{
+		*_max = x;
+	}
+}
+
+static void
+gltf_decode_indicesU8(const uint8_t* src, uint32_t n,
+                      uint16_t* dst16, uint32_t* dst32,
+                      uint32_t* _min, uint32_t* _max)
+{
+	ASSERT(src);
+	ASSERT(_min);
+	ASSERT(_max);
+
+	uint32_t i = 0;
+	uint32_t j;
+	#if defined(__SSE2__)
+	if(n >= 16)
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i vmin = _mm_set1_epi8((char) 0xFF);
+		__m128i vmax = zero;
+		for(; i + 16 <= n; i += 16)
+		{
+			__m128i v  = _mm_loadu_si128((const __m128i*) &src[i]);
+			__m128i lo = _mm_unpacklo_epi8(v, zero);
+			__m128i hi = _mm_unpackhi_epi8(v, zero);
+			vmin = _mm_min_epu8(vmin, v);
+			vmax = _mm_max_epu8(vmax, v);
+			if(dst16)
+			{
+				_mm_storeu_si128((__m128i*) &dst16[i],     lo);
+				_mm_storeu_si128((__m128i*) &dst16[i + 8], hi);
+			}
+			else if(dst32)
+			{
+				_mm_storeu_si128((__m128i*) &dst32[i],
+				                 _mm_unpacklo_epi16(lo, zero));
+				_mm_storeu_si128((__m128i*) &dst32[i + 4],
+				                 _mm_unpackhi_epi16(lo, zero));
+				_mm_storeu_si128((__m128i*) &dst32[i + 8],
+				                 _mm_unpacklo_epi16(hi, zero));
+				_mm_storeu_si128((__m128i*) &dst32[i + 12],
+				                 _mm_unpackhi_epi16(hi, zero));
+			}
+		}
+
+		uint8_t tmin[16];
+		uint8_t tmax[16];
+		_mm_storeu_si128((__m128i*) tmin, vmin);
+		_mm_storeu_si128((__m128i*) tmax, vmax);
+		for(j = 0; j < 16; ++j)
+		{
+			gltf_decode_range(tmin[j], _min, _max);
+			gltf_decode_range(tmax[j], _min, _max);
+		}
+	}
+	#elif defined(__ARM_NEON)
+	if(n >= 16)
+	{
+		uint8x16_t vmin = vdupq_n_u8(0xFF);
+		uint8x16_t vmax = vdupq_n_u8(0);
+		for(; i + 16 <= n; i += 16)
+		{
+			uint8x16_t v  = vld1q_u8(&src[i]);
+			uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+			uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+			vmin = vminq_u8(vmin, v);
+			vmax = vmaxq_u8(vmax, v);
+			if(dst16)
+			{
+				vst1q_u16(&dst16[i],     lo);
+				vst1q_u16(&dst16[i + 8], hi);
+			}
+			else if(dst32)
+			{
+				vst1q_u32(&dst32[i],      vmovl_u16(vget_low_u16(lo)));
+				vst1q_u32(&dst32[i + 4],  vmovl_u16(vget_high_u16(lo)));
+				vst1q_u32(&dst32[i + 8],  vmovl_u16(vget_low_u16(hi)));
+				vst1q_u32(&dst32[i + 12], vmovl_u16(vget_high_u16(hi)));
+			}
+		}
+
+		uint8_t tmin[16];
+		uint8_t tmax[16];
+		vst1q_u8(tmin, vmin);
+		vst1q_u8(tmax, vmax);
+		for(j = 0; j < 16; ++j)
+		{
+			gltf_decode_range(tmin[j], _min, _max);
+			gltf_decode_range(tmax[j], _min, _max);
+		}
+	}
+	#endif
+
+	for(; i < n; ++i)
+	{
+		uint32_t x = src[i];
+		if(dst16)
+		{
+			dst16[i] = (uint16_t) x;
+		}
+		else if(dst32)
+		{
+			dst32[i] = x;
+		}
+		gltf_decode_range(x, _min, _max);
+	}
+}
+
+static void
+gltf_decode_indicesU16(const char* src, uint32_t n,
+                       uint16_t* dst16, uint32_t* dst32,
+                       uint32_t* _min, uint32_t* _max)
+{
+	ASSERT(src);
+	ASSERT(_min);
+	ASSERT(_max);
+
+	uint32_t i = 0;
+	uint32_t j;
+	#if defined(__SSE2__)
+	if(n >= 8)
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i bias = _mm_set1_epi16((short) 0x8000);
+		__m128i vmin = _mm_set1_epi16(0x7FFF);
+		__m128i vmax = bias;
+		for(; i + 8 <= n; i += 8)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i*) &src[2*i]);
+			__m128i b = _mm_xor_si128(v, bias);
+			vmin = _mm_min_epi16(vmin, b);
+			vmax = _mm_max_epi16(vmax, b);
+			if(dst16)
+			{
+				_mm_storeu_si128((__m128i*) &dst16[i], v);
+			}
+			else if(dst32)
+			{
+				_mm_storeu_si128((__m128i*) &dst32[i],
+				                 _mm_unpacklo_epi16(v, zero));
+				_mm_storeu_si128((__m128i*) &dst32[i + 4],
+				                 _mm_unpackhi_epi16(v, zero));
+			}
+		}
+
+		uint16_t tmin[8];
+		uint16_t tmax[8];
+		_mm_storeu_si128((__m128i*) tmin, _mm_xor_si128(vmin, bias));
+		_mm_storeu_si128((__m128i*) tmax, _mm_xor_si128(vmax, bias));
+		for(j = 0; j < 8; ++j)
+		{
+			gltf_decode_range(tmin[j], _min, _max);
+			gltf_decode_range(tmax[j], _min, _max);
+		}
+	}
+	#elif defined(__ARM_NEON)
+	if(n >= 8)
+	{
+		uint16x8_t vmin = vdupq_n_u16(0xFFFF);
+		uint16x8_t vmax = vdupq_n_u16(0);
+		for(; i + 8 <= n; i += 8)
+		{
+			uint8x16_t b = vld1q_u8((const uint8_t*) &src[2*i]);
+			uint16x8_t v = vreinterpretq_u16_u8(b);
+			vmin = vminq_u16(vmin, v);
+			vmax = vmaxq_u16(vmax, v);
+			if(dst16)
+			{
+				vst1q_u16(&dst16[i], v);
+			}
+			else if(dst32)
+			{
+				vst1q_u32(&dst32[i],     vmovl_u16(vget_low_u16(v)));
+				vst1q_u32(&dst32[i + 4], vmovl_u16(vget_high_u16(v)));
+			}
+		}
+
+		uint16_t tmin[8];
+		uint16_t tmax[8];
+		vst1q_u16(tmin, vmin);
+		vst1q_u16(tmax, vmax);
+		for(j = 0; j < 8; ++j)
+		{
+			gltf_decode_range(tmin[j], _min, _max);
+			gltf_decode_range(tmax[j], _min, _max);
+		}
+	}
+	#endif
+
+	for(; i < n; ++i)
+	{
+		uint16_t x;
+		memcpy(&x, &src[2*i], sizeof(uint16_t));
+		if(dst16)
+		{
+			dst16[i] = x;
+		}
+		else if(dst32)
+		{
+			dst32[i] = x;
+		}
+		gltf_decode_range(x, _min, _max);
+	}
+}
+
+static void
+gltf_decode_indicesU32(const char* src, uint32_t n,
+                       uint16_t* dst16, uint32_t* dst32,
+                       uint32_t* _min, uint32_t* _max)
+{
+	ASSERT(src);
+	ASSERT(_min);
+	ASSERT(_max);
+
+	// narrowing to dst16 truncates indices which exceed
+	// 16-bits so the caller must check the max index
+
+	uint32_t i = 0;
+	uint32_t j;
+	#if defined(__AVX2__)
+	if(n >= 16)
+	{
+		__m256i mask16 = _mm256_set1_epi32(0xFFFF);
+		__m256i vmin   = _mm256_set1_epi32(-1);
+		__m256i vmax   = _mm256_setzero_si256();
+		for(; i + 16 <= n; i += 16)
+		{
+			__m256i v0 = _mm256_loadu_si256((const __m256i*) &src[4*i]);
+			__m256i v1 = _mm256_loadu_si256((const __m256i*) &src[4*i + 32]);
+			vmin = _mm256_min_epu32(vmin, _mm256_min_epu32(v0, v1));
+			vmax = _mm256_max_epu32(vmax, _mm256_max_epu32(v0, v1));
+			if(dst16)
+			{
+				// the truncated values cannot saturate and the
+				// pack interleaves the 128-bit lanes which are
+				// restored by the permute
+				__m256i t0 = _mm256_and_si256(v0, mask16);
+				__m256i t1 = _mm256_and_si256(v1, mask16);
+				__m256i p  = _mm256_packus_epi32(t0, t1);
+				p = _mm256_permute4x64_epi64(p, 0xD8);
+				_mm256_storeu_si256((__m256i*) &dst16[i], p);
+			}
+			else if(dst32)
+			{
+				_mm256_storeu_si256((__m256i*) &dst32[i],     v0);
+				_mm256_storeu_si256((__m256i*) &dst32[i + 8], v1);
+			}
+		}
+
+		uint32_t tmin[8];
+		uint32_t tmax[8];
+		_mm256_storeu_si256((__m256i*) tmin, vmin);
+		_mm256_storeu_si256((__m256i*) tmax, vmax);
+		for(j = 0; j < 8; ++j)
+		{
+			gltf_decode_range(tmin[j], _min, _max);
+			gltf_decode_range(tmax[j], _min, _max);
+		}
+	}
+	#elif defined(__SSE2__)
+	if(n >= 8)
+	{
+		__m128i bias   = _mm_set1_epi32((int) 0x80000000);
+		__m128i bias16 = _mm_set1_epi32(0x8000);
+		__m128i mask16 = _mm_set1_epi32(0xFFFF);
+		__m128i vmin   = _mm_set1_epi32(0x7FFFFFFF);
+		__m128i vmax   = bias;
+		for(; i + 8 <= n; i += 8)
+		{
+			__m128i v0 = _mm_loadu_si128((const __m128i*) &src[4*i]);
+			__m128i v1 = _mm_loadu_si128((const __m128i*) &src[4*i + 16]);
+			__m128i b0 = _mm_xor_si128(v0, bias);
+			__m128i b1 = _mm_xor_si128(v1, bias);
+			vmin = gltf_decode_min32(vmin, gltf_decode_min32(b0, b1));
+			vmax = gltf_decode_max32(vmax, gltf_decode_max32(b0, b1));
+			if(dst16)
+			{
+				// truncate to 16-bits and bias into the signed
+				// range so that the saturating pack is exact
+				__m128i t0 = _mm_and_si128(v0, mask16);
+				__m128i t1 = _mm_and_si128(v1, mask16);
+				t0 = _mm_sub_epi32(t0, bias16);
+				t1 = _mm_sub_epi32(t1, bias16);
+				__m128i p = _mm_packs_epi32(t0, t1);
+				p = _mm_xor_si128(p, _mm_set1_epi16((short) 0x8000));
+				_mm_storeu_si128((__m128i*) &dst16[i], p);
+			}
+			else if(dst32)
+			{
+				_mm_storeu_si128((__m128i*) &dst32[i],     v0);
+				_mm_storeu_si128((__m128i*) &dst32[i + 4], v1);
+			}
+		}
+
+		uint32_t tmin[4];
+		uint32_t tmax[4];
+		_mm_storeu_si128((__m128i*) tmin, _mm_xor_si128(vmin, bias));
+		_mm_storeu_si128((__m128i*) tmax, _mm_xor_si128(vmax, bias));
+		for(j = 0; j < 4; ++j)
+		{
+			gltf_decode_range(tmin[j], _min, _max);
+			gltf_decode_range(tmax[j], _min, _max);
+		}
+	}
+	#elif defined(__ARM_NEON)
+	if(n >= 8)
+	{
+		uint32x4_t vmin = vdupq_n_u32(0xFFFFFFFF);
+		uint32x4_t vmax = vdupq_n_u32(0);
+		for(; i + 8 <= n; i += 8)
+		{
+			uint8x16_t b0 = vld1q_u8((const uint8_t*) &src[4*i]);
+			uint8x16_t b1 = vld1q_u8((const uint8_t*) &src[4*i + 16]);
+			uint32x4_t v0 = vreinterpretq_u32_u8(b0);
+			uint32x4_t v1 = vreinterpretq_u32_u8(b1);
+			vmin = vminq_u32(vmin, vminq_u32(v0, v1));
+			vmax = vmaxq_u32(vmax, vmaxq_u32(v0, v1));
+			if(dst16)
+			{
+				vst1q_u16(&dst16[i], vcombine_u16(vmovn_u32(v0),
+				                                  vmovn_u32(v1)));
+			}
+			else if(dst32)
+			{
+				vst1q_u32(&dst32[i],     v0);
+				vst1q_u32(&dst32[i + 4], v1);
+			}
+		}
+
+		uint32_t tmin[4];
+		uint32_t tmax[4];
+		vst1q_u32(tmin, vmin);
+		vst1q_u32(tmax, vmax);
+		for(j = 0; j < 4; ++j)
+		{
+			gltf_decode_range(tmin[j], _min, _max);
+			gltf_decode_range(tmax[j], _min, _max);
+		}
+	}
+	#endif
+
+	for(; i < n; ++i)
+	{
+		uint32_t x;
+		memcpy(&x, &src[4*i], sizeof(uint32_t));
+		if(dst16)
+		{
+			dst16[i] = (uint16_t) x;
+		}
+		else if(dst32)
+		{
+			dst32[i] = x;
+		}
+		gltf_decode_range(x, _min, _max);
+	}
+}
+
+static int
+gltf_decode_indices(gltf_file_t* file,
+                    gltf_accessor_t* accessor,
+                    uint16_t* dst16, uint32_t* dst32,
+                    uint32_t* _min, uint32_t* _max)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(_min);
+	ASSERT(_max);
+
+	if(accessor->has_sparse)
+	{
+		LOGE("unsupported sparse indices");
+		return 0;
+	}
+
+	gltf_componentType_e ct = accessor->componentType;
+	if((accessor->type != GLTF_ACCESSOR_TYPE_SCALAR) ||
+	   ((ct != GLTF_COMPONENT_TYPE_UNSIGNED_BYTE)  &&
+	    (ct != GLTF_COMPONENT_TYPE_UNSIGNED_SHORT) &&
+	    (ct != GLTF_COMPONENT_TYPE_UNSIGNED_INT)))
+	{
+		LOGE("invalid type=%u, componentType=%u",
+		     (uint32_t) accessor->type, (uint32_t) ct);
+		return 0;
+	}
+
+	gltf_decodeLayout_t layout;
+	if(gltf_decode_layout(file, accessor, &layout) == 0)
+	{
+		return 0;
+	}
+
+	uint32_t count = accessor->count;
+	uint32_t min   = 0xFFFFFFFF;
+	uint32_t max   = 0;
+	if(layout.src == NULL)
+	{
+		if(dst16)
+		{
+			memset(dst16, 0, (size_t) count*sizeof(uint16_t));
+		}
+		else if(dst32)
+		{
+			memset(dst32, 0, (size_t) count*sizeof(uint32_t));
+		}
+		min = 0;
+	}
+	else if(layout.stride != layout.elem_size)
+	{
+		// strided index buffers are unusual
+		uint32_t    i;
+		const char* src = layout.src;
+		for(i = 0; i < count; ++i)
+		{
+			uint32_t x = gltf_decode_readUint32(src, ct);
+			if(dst16)
+			{
+				dst16[i] = (uint16_t) x;
+			}
+			else if(dst32)
+			{
+				dst32[i] = x;
+			}
+			gltf_decode_range(x, &min, &max);
+			src += layout.stride;
+		}
+	}
+	else if(ct == GLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+	{
+		gltf_decode_indicesU8((const uint8_t*) layout.src, count,
+		                      dst16, dst32, &min, &max);
+	}
+	else if(ct == GLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+	{
+		gltf_decode_indicesU16(layout.src, count,
+		                       dst16, dst32, &min, &max);
+	}
+	else
+	{
+		gltf_decode_indicesU32(layout.src, count,
+		                       dst16, dst32, &min, &max);
+	}
+
+	// empty accessors have an empty range
+	if(count == 0)
+	{
+		min = 0;
+		max = 0;
+	}
+
+	*_min = min;
+	*_max = max;
+
+	if(dst16 && (max > 0xFFFF))
+	{
+		LOGD("invalid max=%u", max);
+		return 0;
+	}
+
+	return 1;
+}
+
+/***********************************************************
+* private - sparse                                         *
+***********************************************************/
+
+static int
+gltf_decode_sparseIndices(gltf_file_t* file,
+                          gltf_accessor_t* accessor,
+                          uint32_t* indices)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(indices);
+
+	gltf_accessorSparse_t* sparse = &accessor->sparse;
+
+	// the sparse indices are a tightly packed SCALAR view
+	gltf_accessor_t tmp;
+	memset(&tmp, 0, sizeof(gltf_accessor_t));
+	tmp.has_bufferView = 1;
+	tmp.bufferView     = sparse->indices_bufferView;
+	tmp.byteOffset     = sparse->indices_byteOffset;
+	tmp.componentType  = sparse->indices_componentType;
+	tmp.count          = sparse->count;
+	tmp.type           = GLTF_ACCESSOR_TYPE_SCALAR;
+
+	uint32_t min;
+	uint32_t max;
+	if(gltf_decode_indices(file, &tmp, NULL, indices,
+	                       &min, &max) == 0)
+	{
+		return 0;
+	}
+
+	if(sparse->count && (max >= accessor->count))
+	{
+		LOGE("invalid max=%u, count=%u", max, accessor->count);
+		return 0;
+	}
+
+	return 1;
+}
+
+static void
+gltf_decode_sparseValues(gltf_accessor_t* accessor,
+                         gltf_accessor_t* tmp)
+{
+	ASSERT(accessor);
+	ASSERT(tmp);
+
+	// the sparse values share the accessor type and
+	// componentType but are tightly packed
+	*tmp = *accessor;
+	tmp->has_bufferView = 1;
+	tmp->has_sparse     = 0;
+	tmp->bufferView     = accessor->sparse.values_bufferView;
+	tmp->byteOffset     = accessor->sparse.values_byteOffset;
+	tmp->count          = accessor->sparse.count;
+}
+
+static void
+gltf_decode_scatter(uint32_t n, uint32_t count,
+                    const uint32_t* indices,
+                    const uint32_t* values,
+                    uint32_t* data)
+{
+	ASSERT(indices);
+	ASSERT(values);
+	ASSERT(data);
+
+	// floats and uint32 share the same 4 byte element so the
+	// patch is a copy of n words per index where the constant
+	// sizes allow the compiler to emit a single vector move
+	uint32_t i;
+	if(n == 1)
+	{
+		for(i = 0; i < count; ++i)
+		{
+			data[indices[i]] = values[i];
+		}
+	}
+	else if(n == 2)
+	{
+		for(i = 0; i < count; ++i)
+		{
+			memcpy(&data[2*indices[i]], &values[2*i],
+			       2*sizeof(uint32_t));
+		}
+	}
+	else if(n == 3)
+	{
+		for(i = 0; i < count; ++i)
+		{
+			memcpy(&data[3*indices[i]], &values[3*i],
+			       3*sizeof(uint32_t));
+		}
+	}
+	else if(n == 4)
+	{
+		for(i = 0; i < count; ++i)
+		{
+			memcpy(&data[4*indices[i]], &values[4*i],
+			       4*sizeof(uint32_t));
+		}
+	}
+	else
+	{
+		for(i = 0; i < count; ++i)
+		{
+			memcpy(&data[n*indices[i]], &values[n*i],
+			       n*sizeof(uint32_t));
+		}
+	}
+}
+
+static int
+gltf_decode_sparse(gltf_file_t* file,
+                   gltf_accessor_t* accessor,
+                   int is_float, uint32_t* data)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(data);
+
+	uint32_t n     = gltf_decode_components(accessor);
+	uint32_t count = accessor->sparse.count;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	// indices and values share one scratch allocation
+	uint32_t* indices;
+	indices = (uint32_t*)
+	          MALLOC((size_t) count*(n + 1)*sizeof(uint32_t));
+	if(indices == NULL)
+	{
+		LOGE("MALLOC failed");
+		return 0;
+	}
+	uint32_t* values = &indices[count];
+
+	if(gltf_decode_sparseIndices(file, accessor, indices) == 0)
+	{
+		goto fail_decode;
+	}
+
+	gltf_accessor_t tmp;
+	gltf_decode_sparseValues(accessor, &tmp);
+	if(is_float)
+	{
+		if(gltf_decode_denseFloat(file, &tmp,
+		                          (float*) values) == 0)
+		{
+			goto fail_decode;
+		}
+	}
+	else
+	{
+		if(gltf_decode_denseUint32(file, &tmp, values) == 0)
+		{
+			goto fail_decode;
+		}
+	}
+
+	gltf_decode_scatter(n, count, indices, values, data);
+	FREE(indices);
+
+	// success
+	return 1;
+
+	// failure
+	fail_decode:
+		FREE(indices);
+	return 0;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+uint32_t gltf_decode_components(gltf_accessor_t* accessor)
+{
+	ASSERT(accessor);
+
+	uint32_t cols;
+	uint32_t rows;
+	if(gltf_decode_shape(accessor->type, &cols, &rows) == 0)
+	{
+		return 0;
+	}
+
+	return cols*rows;
+}
+
+int gltf_decode_float(gltf_file_t* file,
+                      gltf_accessor_t* accessor,
+                      float* data)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(data);
+
+	if(gltf_decode_denseFloat(file, accessor, data) == 0)
+	{
+		return 0;
+	}
+
+	if(accessor->has_sparse)
+	{
+		return gltf_decode_sparse(file, accessor, 1,
+		                          (uint32_t*) data);
+	}
+
+	return 1;
+}
+
+int gltf_decode_uint32(gltf_file_t* file,
+                       gltf_accessor_t* accessor,
+                       uint32_t* data)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(data);
+
+	if(gltf_decode_denseUint32(file, accessor, data) == 0)
+	{
+		return 0;
+	}
+
+	if(accessor->has_sparse)
+	{
+		return gltf_decode_sparse(file, accessor, 0, data);
+	}
+
+	return 1;
+}
+
+int gltf_decode_sparseFloat(gltf_file_t* file,
+                            gltf_accessor_t* accessor,
+                            uint32_t* indices,
+                            float* values)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(indices);
+	ASSERT(values);
+
+	if(accessor->has_sparse == 0)
+	{
+		LOGE("invalid has_sparse=0");
+		return 0;
+	}
+
+	if(gltf_decode_sparseIndices(file, accessor, indices) == 0)
+	{
+		return 0;
+	}
+
+	gltf_accessor_t tmp;
+	gltf_decode_sparseValues(accessor, &tmp);
+	return gltf_decode_denseFloat(file, &tmp, values);
+}
+
+int gltf_decode_sparseUint32(gltf_file_t* file,
+                             gltf_accessor_t* accessor,
+                             uint32_t* indices,
+                             uint32_t* values)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(indices);
+	ASSERT(values);
+
+	if(accessor->has_sparse == 0)
+	{
+		LOGE("invalid has_sparse=0");
+		return 0;
+	}
+
+	if(gltf_decode_sparseIndices(file, accessor, indices) == 0)
+	{
+		return 0;
+	}
+
+	gltf_accessor_t tmp;
+	gltf_decode_sparseValues(accessor, &tmp);
+	return gltf_decode_denseUint32(file, &tmp, values);
+}
+
+int gltf_decode_indices16(gltf_file_t* file,
+                          gltf_accessor_t* accessor,
+                          uint16_t* data,
+                          uint32_t* _min, uint32_t* _max)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(data);
+	ASSERT(_min);
+	ASSERT(_max);
+
+	return gltf_decode_indices(file, accessor, data, NULL,
+	                           _min, _max);
+}
+
+int gltf_decode_indices32(gltf_file_t* file,
+                          gltf_accessor_t* accessor,
+                          uint32_t* data,
+                          uint32_t* _min, uint32_t* _max)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(data);
+	ASSERT(_min);
+	ASSERT(_max);
+
+	return gltf_decode_indices(file, accessor, NULL, data,
+	                           _min, _max);
+}
+
+int gltf_decode_indexRange(gltf_file_t* file,
+                           gltf_accessor_t* accessor,
+                           uint32_t* _min, uint32_t* _max)
+{
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(_min);
+	ASSERT(_max);
+
+	return gltf_decode_indices(file, accessor, NULL, NULL,
+	                           _min, _max);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_decode_H
+#define gltf_decode_H
+
+#include "gltf.h"
+
+// decode an accessor into a tightly packed caller provided
+// array of count*components values (column-major for
+// matrices) from any component type and bufferView stride
+// normalized integers are converted to [0,1] or [-1,1] and
+// accessors without a bufferView decode as zeros
+// sparse accessors apply the sparse values onto the base
+// (or zero) array
+uint32_t gltf_decode_components(gltf_accessor_t* accessor);
+int      gltf_decode_float(gltf_file_t* file,
+                           gltf_accessor_t* accessor,
+                           float* data);
+int      gltf_decode_uint32(gltf_file_t* file,
+                            gltf_accessor_t* accessor,
+                            uint32_t* data);
+
+// decode only the sparse delta list of a sparse accessor
+// into caller provided arrays of sparse.count indices and
+// sparse.count*components values
+int      gltf_decode_sparseFloat(gltf_file_t* file,
+                                 gltf_accessor_t* accessor,
+                                 uint32_t* indices,
+                                 float* values);
+int      gltf_decode_sparseUint32(gltf_file_t* file,
+                                  gltf_accessor_t* accessor,
+                                  uint32_t* indices,
+                                  uint32_t* values);
+
+// decode a SCALAR unsigned index accessor and return the
+// min/max index from the same pass
+// sparse index accessors are not supported
+// gltf_decode_indices16 fails when the max index exceeds
+// 16-bits (the min/max are still returned) in which case
+// the caller may fall back to gltf_decode_indices32
+int      gltf_decode_indices16(gltf_file_t* file,
+                               gltf_accessor_t* accessor,
+                               uint16_t* data,
+                               uint32_t* _min, uint32_t* _max);
+int      gltf_decode_indices32(gltf_file_t* file,
+                               gltf_accessor_t* accessor,
+                               uint32_t* data,
+                               uint32_t* _min, uint32_t* _max);
+int      gltf_decode_indexRange(gltf_file_t* file,
+                                gltf_accessor_t* accessor,
+                                uint32_t* _min, uint32_t* _max);
+
+#endif
@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_decode.h"
+#include "gltf_morph.h"
+
+// floats per tile which remains in the L1 cache while the
+// dense targets are accumulated
+#define GLTF_MORPH_TILE 1024
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static void
+gltf_morph_add1(float* dst, const float* a, float wa,
+                uint32_t count)
+{
+	ASSERT(dst);
+	ASSERT(a);
+
+	uint32_t i = 0;
+
+	#if defined(__SSE2__)
+	__m128 va = _mm_set1_ps(wa);
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 d = _mm_loadu_ps(&dst[i]);
+		d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(&a[i]), va));
+		_mm_storeu_ps(&dst[i], d);
+	}
+	#elif defined(__ARM_NEON)
+	for(; i + 4 <= count; i += 4)
+	{
+		float32x4_t d = vld1q_f32(&dst[i]);
+		d = vmlaq_n_f32(d, vld1q_f32(&a[i]), wa);
+		vst1q_f32(&dst[i], d);
+	}
+	#endif
+
+	for(; i < count; ++i)
+	{
+		dst[i] += wa*a[i];
+	}
+}
+
+static void
+gltf_morph_add2(float* dst, const float* a, float wa,
+                const float* b, float wb, uint32_t count)
+{
+	ASSERT(dst);
+	ASSERT(a);
+	ASSERT(b);
+
+	uint32_t i = 0;
+
+	#if defined(__SSE2__)
+	__m128 va = _mm_set1_ps(wa);
+	__m128 vb = _mm_set1_ps(wb);
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 d = _mm_loadu_ps(&dst[i]);
+		d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(&a[i]), va));
+		d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(&b[i]), vb));
+		_mm_storeu_ps(&dst[i], d);
+	}
+	#elif defined(__ARM_NEON)
+	for(; i + 4 <= count; i += 4)
+	{
+		float32x4_t d = vld1q_f32(&dst[i]);
+		d = vmlaq_n_f32(d, vld1q_f32(&a[i]), wa);
+		d = vmlaq_n_f32(d, vld1q_f32(&b[i]), wb);
+		vst1q_f32(&dst[i], d);
+	}
+	#endif
+
+	for(; i < count; ++i)
+	{
+		dst[i] += wa*a[i] + wb*b[i];
+	}
+}
+
+static float
+gltf_morph_weight(uint32_t weight_count, const float* weights,
+                  uint32_t idx)
+{
+	return (idx < weight_count) ? weights[idx] : 0.0f;
+}
+
+static void
+gltf_morph_blendAttribute(gltf_morph_t* self,
+                          gltf_morphAttribute_t* attr,
+                          uint32_t weight_count,
+                          const float* weights,
+                          float* out)
+{
+	ASSERT(self);
+	ASSERT(attr);
+
+	if((attr->base == NULL) || (out == NULL))
+	{
+		return;
+	}
+
+	// select the dense targets with a non-zero weight
+	uint32_t active_count = 0;
+	uint32_t i;
+	for(i = 0; i < self->target_count; ++i)
+	{
+		gltf_morphDelta_t* delta = &attr->deltas[i];
+		if(delta->values && (delta->indices == NULL) &&
+		   (gltf_morph_weight(weight_count, weights, i) != 0.0f))
+		{
+			self->active[active_count++] = i;
+		}
+	}
+
+	// stream the base and dense targets through one tile at
+	// a time where pairs of targets are accumulated per pass
+	uint32_t c = attr->components;
+	size_t   n = ((size_t) c)*((size_t) self->vertex_count);
+	size_t   t;
+	for(t = 0; t < n; t += GLTF_MORPH_TILE)
+	{
+		uint32_t len = GLTF_MORPH_TILE;
+		if(t + len > n)
+		{
+			len = (uint32_t) (n - t);
+		}
+
+		float* dst = &out[t];
+		memcpy(dst, &attr->base[t], len*sizeof(float));
+
+		uint32_t j = 0;
+		for(; j + 2 <= active_count; j += 2)
+		{
+			uint32_t a = self->active[j];
+			uint32_t b = self->active[j + 1];
+			gltf_morph_add2(dst,
+			                &attr->deltas[a].values[t], weights[a],
+			                &attr->deltas[b].values[t], weights[b],
+			                len);
+		}
+
+		if(j < active_count)
+		{
+			uint32_t a = self->active[j];
+			gltf_morph_add1(dst, &attr->deltas[a].values[t],
+			                weights[a], len);
+		}
+	}
+
+	// scatter the sparse targets
+	for(i = 0; i < self->target_count; ++i)
+	{
+		gltf_morphDelta_t* delta = &attr->deltas[i];
+		if((delta->values == NULL) || (delta->indices == NULL))
+		{
+			continue;
+		}
+
+		float w = gltf_morph_weight(weight_count, weights, i);
+		if(w == 0.0f)
+		{
+			continue;
+		}
+
+		uint32_t j;
+		uint32_t e;
+		for(j = 0; j < delta->count; ++j)
+		{
+			float*       d = &out[((size_t) c)*delta->indices[j]];
+			const float* v = &delta->values[c*j];
+			for(e = 0; e < c; ++e)
+			{
+				d[e] += w*v[e];
+			}
+		}
+	}
+}
+
+// expand count VEC3 values in place to 4 components
+static void gltf_morph_expand(float* values, uint32_t count)
+{
+	ASSERT(values);
+
+	uint32_t i = count;
+	while(i > 0)
+	{
+		--i;
+
+		float x = values[3*i];
+		float y = values[3*i + 1];
+		float z = values[3*i + 2];
+		values[4*i]     = x;
+		values[4*i + 1] = y;
+		values[4*i + 2] = z;
+		values[4*i + 3] = 0.0f;
+	}
+}
+
+static int
+gltf_morph_decodeDelta(gltf_morph_t* self,
+                       gltf_file_t* file,
+                       gltf_accessor_t* accessor,
+                       uint32_t components,
+                       gltf_morphDelta_t* delta)
+{
+	ASSERT(self);
+	ASSERT(file);
+	ASSERT(accessor);
+	ASSERT(delta);
+
+	if((accessor->type  != GLTF_ACCESSOR_TYPE_VEC3) ||
+	   (accessor->count != self->vertex_count))
+	{
+		LOGE("invalid type=%u, count=%u",
+		     (uint32_t) accessor->type, accessor->count);
+		return 0;
+	}
+
+	// targets without a bufferView or sparse values are zero
+	if((accessor->has_bufferView == 0) &&
+	   (accessor->has_sparse == 0))
+	{
+		return 1;
+	}
+
+	// sparse targets without a base are only displaced at
+	// the sparse indices
+	int      sparse = accessor->has_sparse &&
+	                  (accessor->has_bufferView == 0);
+	uint32_t count  = sparse ? accessor->sparse.count :
+	                           self->vertex_count;
+	if(count == 0)
+	{
+		return 1;
+	}
+
+	size_t n = ((size_t) count)*components;
+	delta->values = (float*) MALLOC(n*sizeof(float));
+	if(delta->values == NULL)
+	{
+		LOGE("MALLOC failed");
+		return 0;
+	}
+	delta->count = count;
+
+	if(sparse)
+	{
+		delta->indices = (uint32_t*)
+		                 MALLOC(count*sizeof(uint32_t));
+		if(delta->indices == NULL)
+		{
+			LOGE("MALLOC failed");
+			return 0;
+		}
+
+		if(gltf_decode_sparseFloat(file, accessor, delta->indices,
+		                           delta->values) == 0)
+		{
+			return 0;
+		}
+	}
+	else if(gltf_decode_float(file, accessor,
+	                          delta->values) == 0)
+	{
+		return 0;
+	}
+
+	if(components == 4)
+	{
+		gltf_morph_expand(delta->values, count);
+	}
+
+	return 1;
+}
+
+static int
+gltf_morph_initAttribute(gltf_morph_t* self,
+                         gltf_morphAttribute_t* attr,
+                         gltf_file_t* file,
+                         gltf_primitive_t* primitive,
+                         gltf_attributeType_e type,
+                         gltf_accessorType_e accessor_type,
+                         uint32_t components)
+{
+	ASSERT(self);
+	ASSERT(attr);
+	ASSERT(file);
+	ASSERT(primitive);
+
+	attr->components = components;
+
+	gltf_attribute_t* attribute;
+	attribute = gltf_primitive_getAttribute(primitive, type, 0);
+	if(attribute == NULL)
+	{
+		return 1;
+	}
+
+	gltf_accessor_t* accessor;
+	accessor = gltf_file_getAccessor(file, attribute->accessor);
+	if(accessor == NULL)
+	{
+		return 0;
+	}
+
+	if((accessor->type  != accessor_type) ||
+	   (accessor->count != self->vertex_count))
+	{
+		LOGE("invalid type=%u, count=%u",
+		     (uint32_t) accessor->type, accessor->count);
+		return 0;
+	}
+
+	size_t n = ((size_t) self->vertex_count + 1)*components;
+	attr->base = (float*) MALLOC(n*sizeof(float));
+	if(attr->base == NULL)
+	{
+		LOGE("MALLOC failed");
+		return 0;
+	}
+
+	if(gltf_decode_float(file, accessor, attr->base) == 0)
+	{
+		return 0;
+	}
+
+	attr->deltas = (gltf_morphDelta_t*)
+	               CALLOC(self->target_count + 1,
+	                      sizeof(gltf_morphDelta_t));
+	if(attr->deltas == NULL)
+	{
+		LOGE("CALLOC failed");
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < self->target_count; ++i)
+	{
+		gltf_morphTarget_t* target = &primitive->targets[i];
+		attribute = gltf_morphTarget_getAttribute(target, type);
+		if(attribute == NULL)
+		{
+			continue;
+		}
+
+		accessor = gltf_file_getAccessor(file, attribute->accessor);
+		if((accessor == NULL) ||
+		   (gltf_morph_decodeDelta(self, file, accessor,
+		                           components,
+		                           &attr->deltas[i]) == 0))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static void
+gltf_morph_freeAttribute(gltf_morph_t* self,
+                         gltf_morphAttribute_t* attr)
+{
+	ASSERT(self);
+	ASSERT(attr);
+
+	if(attr->deltas)
+	{
+		uint32_t i;
+		for(i = 0; i < self->target_count; ++i)
+		{
+			FREE(attr->deltas[i].indices);
+			FREE(attr->deltas[i].values);
+		}
+		FREE(attr->deltas);
+	}
+	FREE(attr->base);
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_morph_t*
+gltf_morph_new(gltf_file_t* file, gltf_primitive_t* primitive)
+{
+	ASSERT(file);
+	ASSERT(primitive);
+
+	gltf_attribute_t* attribute;
+	attribute = gltf_primitive_getAttribute(primitive,
+	                                        GLTF_ATTRIBUTE_TYPE_POSITION,
+	                                        0);
+	if(attribute == NULL)
+	{
+		LOGE("invalid POSITION");
+		return NULL;
+	}
+
+	gltf_accessor_t* position;
+	position = gltf_file_getAccessor(file, attribute->accessor);
+	if(position == NULL)
+	{
+		return NULL;
+	}
+
+	gltf_morph_t* self;
+	self = (gltf_morph_t*) CALLOC(1, sizeof(gltf_morph_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->vertex_count = position->count;
+	self->target_count = primitive->target_count;
+
+	self->active = (uint32_t*)
+	               CALLOC(self->target_count + 1,
+	                      sizeof(uint32_t));
+	if(self->active == NULL)
+	{
+		LOGE("CALLOC failed");
+		goto fail_active;
+	}
+
+	if((gltf_morph_initAttribute(self, &self->positions, file,
+	                             primitive,
+	                             GLTF_ATTRIBUTE_TYPE_POSITION,
+	                             GLTF_ACCESSOR_TYPE_VEC3, 3) == 0) ||
+	   (gltf_morph_initAttribute(self, &self->normals, file,
+	                             primitive,
+	                             GLTF_ATTRIBUTE_TYPE_NORMAL,
+	                             GLTF_ACCESSOR_TYPE_VEC3, 3) == 0) ||
+	   (gltf_morph_initAttribute(self, &self->tangents, file,
+	                             primitive,
+	                             GLTF_ATTRIBUTE_TYPE_TANGENT,
+	                             GLTF_ACCESSOR_TYPE_VEC4, 4) == 0))
+	{
+		goto fail_attribute;
+	}
+
+	// success
+	return self;
+
+	// failure
+	fail_attribute:
+	fail_active:
+		gltf_morph_delete(&self);
+	return NULL;
+}
+
+void gltf_morph_delete(gltf_morph_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_morph_t* self = *_self;
+	if(self)
+	{
+		gltf_morph_freeAttribute(self, &self->tangents);
+		gltf_morph_freeAttribute(self, &self->normals);
+		gltf_morph_freeAttribute(self, &self->positions);
+		FREE(self->active);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+void gltf_morph_blend(gltf_morph_t* self,
+                      uint32_t weight_count,
+                      const float* weights,
+                      float* positions,
+                      float* normals,
+                      float* tangents)
+{
+	ASSERT(self);
+	ASSERT(positions);
+	ASSERT(weights || (weight_count == 0));
+
+	gltf_morph_blendAttribute(self, &self->positions,
+	                          weight_count, weights, positions);
+	gltf_morph_blendAttribute(self, &self->normals,
+	                          weight_count, weights, normals);
+	gltf_morph_blendAttribute(self, &self->tangents,
+	                          weight_count, weights, tangents);
+}
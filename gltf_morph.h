@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_morph_H
+#define gltf_morph_H
+
+#include "gltf.h"
+
+// displacements of a morph target attribute where dense
+// targets store vertex_count elements and sparse targets
+// (accessors without a bufferView) store only the sparse
+// indices and values
+typedef struct gltf_morphDelta_s
+{
+	uint32_t  count;
+	uint32_t* indices; // NULL for dense targets
+	float*    values;  // NULL when the target omits the attribute
+} gltf_morphDelta_t;
+
+// TANGENT is stored as 4 components (deltas are zero padded)
+// so the handedness of the base tangent is retained
+typedef struct gltf_morphAttribute_s
+{
+	uint32_t           components;
+	float*             base;   // NULL when the primitive omits the attribute
+	gltf_morphDelta_t* deltas; // target_count
+} gltf_morphAttribute_t;
+
+// CPU morph target blending of a primitive where the
+// POSITION, NORMAL and TANGENT attributes and deltas are
+// decoded once from any valid component type
+typedef struct gltf_morph_s
+{
+	uint32_t vertex_count;
+	uint32_t target_count;
+
+	gltf_morphAttribute_t positions;
+	gltf_morphAttribute_t normals;
+	gltf_morphAttribute_t tangents;
+
+	// active dense targets of the current blend
+	uint32_t* active;
+} gltf_morph_t;
+
+gltf_morph_t* gltf_morph_new(gltf_file_t* file,
+                             gltf_primitive_t* primitive);
+void          gltf_morph_delete(gltf_morph_t** _self);
+
+// blend the weighted targets onto the base attributes into
+// caller provided arrays of 3*vertex_count positions and
+// normals and 4*vertex_count tangents
+// weights (e.g. from gltf_file_getNodeWeights or sampled by
+// gltf_animator) beyond weight_count are zero and targets
+// with a zero weight are skipped
+// normals and tangents may be NULL, are ignored when the
+// primitive omits them and are not renormalized
+// a morph must not be blended by multiple threads at once
+void          gltf_morph_blend(gltf_morph_t* self,
+                               uint32_t weight_count,
+                               const float* weights,
+                               float* positions,
+                               float* normals,
+                               float* tangents);
+
+#endif
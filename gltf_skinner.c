@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_decode.h"
+#include "gltf_skinner.h"
+
+// minimum vertices to skin on a separate thread
+#define GLTF_SKINNER_PARALLEL_SIZE 16384
+
+typedef struct
+{
+	gltf_skinner_t*   self;
+	const cc_mat4f_t* palette;
+	float*            positions;
+	float*            normals;
+	uint32_t          start;
+	uint32_t          end;
+	pthread_t         thread;
+	int               started;
+} gltf_skinnerTask_t;
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static void gltf_skinner_normalize(const float* v, float* out)
+{
+	ASSERT(v);
+	ASSERT(out);
+
+	float len2 = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+	float s    = (len2 > 0.0f) ? 1.0f/sqrtf(len2) : 0.0f;
+	out[0] = s*v[0];
+	out[1] = s*v[1];
+	out[2] = s*v[2];
+}
+
+static void gltf_skinner_run(gltf_skinnerTask_t* task)
+{
+	ASSERT(task);
+
+	gltf_skinner_t* self    = task->self;
+	const float*    palette = (const float*) task->palette;
+	const uint16_t* joints  = self->joints;
+	const float*    weights = self->weights;
+	const float*    p       = self->positions;
+	const float*    n       = self->normals;
+	float*          pout    = task->positions;
+	float*          nout    = task->normals;
+
+	// blend the matrix columns of the joints and transform
+	// the position (w=1) and normal (w=0) by the result
+	uint32_t i;
+	for(i = task->start; i < task->end; ++i)
+	{
+		const uint16_t* j  = &joints[4*i];
+		const float*    w  = &weights[4*i];
+		const float*    m0 = &palette[16*j[0]];
+		const float*    m1 = &palette[16*j[1]];
+		const float*    m2 = &palette[16*j[2]];
+		const float*    m3 = &palette[16*j[3]];
+		float           v[4];
+		uint32_t        c;
+
+		#if defined(__SSE2__)
+		__m128 w0 = _mm_set1_ps(w[0]);
+		__m128 w1 = _mm_set1_ps(w[1]);
+		__m128 w2 = _mm_set1_ps(w[2]);
+		__m128 w3 = _mm_set1_ps(w[3]);
+		__m128 col[4];
+		for(c = 0; c < 4; ++c)
+		{
+			__m128 x;
+			__m128 y;
+			x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m0[4*c]), w0),
+			               _mm_mul_ps(_mm_loadu_ps(&m1[4*c]), w1));
+			y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m2[4*c]), w2),
+			               _mm_mul_ps(_mm_loadu_ps(&m3[4*c]), w3));
+			col[c] = _mm_add_ps(x, y);
+		}
+
+		__m128 r;
+		r = _mm_add_ps(_mm_mul_ps(col[0], _mm_set1_ps(p[3*i])),
+		               _mm_mul_ps(col[1], _mm_set1_ps(p[3*i + 1])));
+		r = _mm_add_ps(r, _mm_mul_ps(col[2], _mm_set1_ps(p[3*i + 2])));
+		r = _mm_add_ps(r, col[3]);
+		_mm_storeu_ps(v, r);
+		memcpy(&pout[3*i], v, 3*sizeof(float));
+
+		if(nout)
+		{
+			r = _mm_add_ps(_mm_mul_ps(col[0], _mm_set1_ps(n[3*i])),
+			               _mm_mul_ps(col[1], _mm_set1_ps(n[3*i + 1])));
+			r = _mm_add_ps(r, _mm_mul_ps(col[2], _mm_set1_ps(n[3*i + 2])));
+			_mm_storeu_ps(v, r);
+			gltf_skinner_normalize(v, &nout[3*i]);
+		}
+		#elif defined(__ARM_NEON)
+		float32x4_t col[4];
+		for(c = 0; c < 4; ++c)
+		{
+			float32x4_t x = vmulq_n_f32(vld1q_f32(&m0[4*c]), w[0]);
+			x = vmlaq_n_f32(x, vld1q_f32(&m1[4*c]), w[1]);
+			x = vmlaq_n_f32(x, vld1q_f32(&m2[4*c]), w[2]);
+			col[c] = vmlaq_n_f32(x, vld1q_f32(&m3[4*c]), w[3]);
+		}
+
+		float32x4_t r;
+		r = vmlaq_n_f32(col[3], col[0], p[3*i]);
+		r = vmlaq_n_f32(r, col[1], p[3*i + 1]);
+		r = vmlaq_n_f32(r, col[2], p[3*i + 2]);
+		vst1q_f32(v, r);
+		memcpy(&pout[3*i], v, 3*sizeof(float));
+
+		if(nout)
+		{
+			r = vmulq_n_f32(col[0], n[3*i]);
+			r = vmlaq_n_f32(r, col[1], n[3*i + 1]);
+			r = vmlaq_n_f32(r, col[2], n[3*i + 2]);
+			vst1q_f32(v, r);
+			gltf_skinner_normalize(v, &nout[3*i]);
+		}
+		#else
+		float col[16];
+		for(c = 0; c < 16; ++c)
+		{
+			col[c] = w[0]*m0[c] + w[1]*m1[c] +
+			         w[2]*m2[c] + w[3]*m3[c];
+		}
+
+		for(c = 0; c < 3; ++c)
+		{
+			pout[3*i + c] = col[c]*p[3*i] + col[4 + c]*p[3*i + 1] +
+			                col[8 + c]*p[3*i + 2] + col[12 + c];
+		}
+
+		if(nout)
+		{
+			for(c = 0; c < 3; ++c)
+			{
+				v[c] = col[c]*n[3*i] + col[4 + c]*n[3*i + 1] +
+				       col[8 + c]*n[3*i + 2];
+			}
+			gltf_skinner_normalize(v, &nout[3*i]);
+		}
+		#endif
+	}
+}
+
+static void* gltf_skinner_thread(void* arg)
+{
+	ASSERT(arg);
+
+	gltf_skinner_run((gltf_skinnerTask_t*) arg);
+	return NULL;
+}
+
+static gltf_accessor_t*
+gltf_skinner_accessor(gltf_file_t* file,
+                      gltf_primitive_t* primitive,
+                      gltf_attributeType_e type,
+                      gltf_accessorType_e accessor_type,
+                      uint32_t count)
+{
+	ASSERT(file);
+	ASSERT(primitive);
+
+	gltf_attribute_t* attribute;
+	attribute = gltf_primitive_getAttribute(primitive, type, 0);
+	if(attribute == NULL)
+	{
+		return NULL;
+	}
+
+	gltf_accessor_t* accessor;
+	accessor = gltf_file_getAccessor(file, attribute->accessor);
+	if(accessor == NULL)
+	{
+		return NULL;
+	}
+
+	if((accessor->type != accessor_type) ||
+	   (accessor->count != count))
+	{
+		LOGE("invalid type=%u, count=%u",
+		     (uint32_t) accessor->type, accessor->count);
+		return NULL;
+	}
+
+	return accessor;
+}
+
+static int
+gltf_skinner_decodeJoints(gltf_skinner_t* self,
+                          gltf_file_t* file,
+                          gltf_accessor_t* accessor)
+{
+	ASSERT(self);
+	ASSERT(file);
+	ASSERT(accessor);
+
+	if((accessor->componentType !=
+	    GLTF_COMPONENT_TYPE_UNSIGNED_BYTE) &&
+	   (accessor->componentType !=
+	    GLTF_COMPONENT_TYPE_UNSIGNED_SHORT))
+	{
+		LOGE("invalid componentType=0x%X",
+		     (uint32_t) accessor->componentType);
+		return 0;
+	}
+
+	size_t    count = 4*((size_t) self->vertex_count);
+	uint32_t* data  = (uint32_t*)
+	                  MALLOC(count*sizeof(uint32_t));
+	if(data == NULL)
+	{
+		LOGE("MALLOC failed");
+		return 0;
+	}
+
+	if(gltf_decode_uint32(file, accessor, data) == 0)
+	{
+		FREE(data);
+		return 0;
+	}
+
+	uint32_t max = 0;
+	size_t   i;
+	for(i = 0; i < count; ++i)
+	{
+		self->joints[i] = (uint16_t) data[i];
+		max = (data[i] > max) ? data[i] : max;
+	}
+	self->joint_count = max + 1;
+	FREE(data);
+
+	return 1;
+}
+
+static int
+gltf_skinner_checkWeights(gltf_accessor_t* accessor)
+{
+	ASSERT(accessor);
+
+	gltf_componentType_e ct = accessor->componentType;
+	if((ct == GLTF_COMPONENT_TYPE_FLOAT) ||
+	   (accessor->normalized &&
+	    ((ct == GLTF_COMPONENT_TYPE_UNSIGNED_BYTE) ||
+	     (ct == GLTF_COMPONENT_TYPE_UNSIGNED_SHORT))))
+	{
+		return 1;
+	}
+
+	LOGE("invalid componentType=0x%X, normalized=%u",
+	     (uint32_t) ct, (uint32_t) accessor->normalized);
+	return 0;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_skinner_t*
+gltf_skinner_new(gltf_file_t* file,
+                 gltf_primitive_t* primitive,
+                 uint32_t thread_count)
+{
+	ASSERT(file);
+	ASSERT(primitive);
+
+	thread_count = gltf_file_threadCount(thread_count);
+
+	gltf_attribute_t* attribute;
+	attribute = gltf_primitive_getAttribute(primitive,
+	                                        GLTF_ATTRIBUTE_TYPE_POSITION,
+	                                        0);
+	if(attribute == NULL)
+	{
+		LOGE("invalid POSITION");
+		return NULL;
+	}
+
+	gltf_accessor_t* position;
+	position = gltf_file_getAccessor(file, attribute->accessor);
+	if(position == NULL)
+	{
+		return NULL;
+	}
+
+	if(position->type != GLTF_ACCESSOR_TYPE_VEC3)
+	{
+		LOGE("invalid type=%u", (uint32_t) position->type);
+		return NULL;
+	}
+
+	uint32_t count = position->count;
+
+	gltf_accessor_t* joints;
+	gltf_accessor_t* weights;
+	joints  = gltf_skinner_accessor(file, primitive,
+	                                GLTF_ATTRIBUTE_TYPE_JOINTS,
+	                                GLTF_ACCESSOR_TYPE_VEC4, count);
+	weights = gltf_skinner_accessor(file, primitive,
+	                                GLTF_ATTRIBUTE_TYPE_WEIGHTS,
+	                                GLTF_ACCESSOR_TYPE_VEC4, count);
+	if((joints == NULL) || (weights == NULL) ||
+	   (gltf_skinner_checkWeights(weights) == 0))
+	{
+		LOGE("invalid JOINTS_0/WEIGHTS_0");
+		return NULL;
+	}
+
+	// normals are optional
+	gltf_accessor_t* normal = NULL;
+	if(gltf_primitive_getAttribute(primitive,
+	                               GLTF_ATTRIBUTE_TYPE_NORMAL, 0))
+	{
+		normal = gltf_skinner_accessor(file, primitive,
+		                               GLTF_ATTRIBUTE_TYPE_NORMAL,
+		                               GLTF_ACCESSOR_TYPE_VEC3,
+		                               count);
+		if(normal == NULL)
+		{
+			return NULL;
+		}
+	}
+
+	gltf_skinner_t* self;
+	self = (gltf_skinner_t*) CALLOC(1, sizeof(gltf_skinner_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->vertex_count = count;
+	self->thread_count = thread_count;
+
+	size_t n = (size_t) count + 1;
+	self->positions = (float*) MALLOC(3*n*sizeof(float));
+	self->joints    = (uint16_t*) MALLOC(4*n*sizeof(uint16_t));
+	self->weights   = (float*) MALLOC(4*n*sizeof(float));
+	if((self->positions == NULL) || (self->joints == NULL) ||
+	   (self->weights   == NULL))
+	{
+		LOGE("MALLOC failed");
+		goto fail_alloc;
+	}
+
+	if(normal)
+	{
+		self->normals = (float*) MALLOC(3*n*sizeof(float));
+		if(self->normals == NULL)
+		{
+			LOGE("MALLOC failed");
+			goto fail_alloc;
+		}
+
+		if(gltf_decode_float(file, normal, self->normals) == 0)
+		{
+			goto fail_decode;
+		}
+	}
+
+	if((gltf_decode_float(file, position,
+	                      self->positions) == 0) ||
+	   (gltf_decode_float(file, weights,
+	                      self->weights) == 0) ||
+	   (gltf_skinner_decodeJoints(self, file, joints) == 0))
+	{
+		goto fail_decode;
+	}
+
+	// success
+	return self;
+
+	// failure
+	fail_decode:
+	fail_alloc:
+		gltf_skinner_delete(&self);
+	return NULL;
+}
+
+void gltf_skinner_delete(gltf_skinner_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_skinner_t* self = *_self;
+	if(self)
+	{
+		FREE(self->normals);
+		FREE(self->weights);
+		FREE(self->joints);
+		FREE(self->positions);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+int gltf_skinner_skin(gltf_skinner_t* self,
+                      uint32_t palette_count,
+                      const cc_mat4f_t* palette,
+                      float* positions,
+                      float* normals)
+{
+	ASSERT(self);
+	ASSERT(palette);
+	ASSERT(positions);
+
+	if(self->joint_count > palette_count)
+	{
+		LOGE("invalid palette_count=%u, joint_count=%u",
+		     palette_count, self->joint_count);
+		return 0;
+	}
+
+	if(self->normals == NULL)
+	{
+		normals = NULL;
+	}
+
+	// split the vertices into contiguous chunks which are
+	// large enough to amortize the thread creation
+	uint32_t count  = self->vertex_count;
+	uint32_t chunks = count/GLTF_SKINNER_PARALLEL_SIZE;
+	if(chunks > self->thread_count)
+	{
+		chunks = self->thread_count;
+	}
+	else if(chunks == 0)
+	{
+		chunks = 1;
+	}
+
+	gltf_skinnerTask_t  task  = { .self = self };
+	gltf_skinnerTask_t* tasks = &task;
+	if(chunks > 1)
+	{
+		tasks = (gltf_skinnerTask_t*)
+		        CALLOC(chunks, sizeof(gltf_skinnerTask_t));
+		if(tasks == NULL)
+		{
+			// fall back to the calling thread
+			LOGW("CALLOC failed");
+			tasks  = &task;
+			chunks = 1;
+		}
+	}
+
+	uint32_t i;
+	for(i = 0; i < chunks; ++i)
+	{
+		gltf_skinnerTask_t* t = &tasks[i];
+		t->self      = self;
+		t->palette   = palette;
+		t->positions = positions;
+		t->normals   = normals;
+		t->start     = (uint32_t) (((uint64_t) count)*i/chunks);
+		t->end       = (uint32_t) (((uint64_t) count)*(i + 1)/chunks);
+	}
+
+	// the calling thread skins the first chunk and any
+	// chunks whose thread failed to start
+	for(i = 1; i < chunks; ++i)
+	{
+		if(pthread_create(&tasks[i].thread, NULL,
+		                  gltf_skinner_thread, &tasks[i]) == 0)
+		{
+			tasks[i].started = 1;
+		}
+	}
+
+	gltf_skinner_run(&tasks[0]);
+	for(i = 1; i < chunks; ++i)
+	{
+		if(tasks[i].started)
+		{
+			pthread_join(tasks[i].thread, NULL);
+		}
+		else
+		{
+			gltf_skinner_run(&tasks[i]);
+		}
+	}
+
+	if(tasks != &task)
+	{
+		FREE(tasks);
+	}
+
+	return 1;
+}
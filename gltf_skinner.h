@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_skinner_H
+#define gltf_skinner_H
+
+#include "gltf.h"
+
+// CPU linear blend skinning of a primitive where the
+// POSITION, NORMAL (optional), JOINTS_0 and WEIGHTS_0
+// attributes are decoded once from any valid component
+// type and the joints are narrowed to 16-bits
+typedef struct gltf_skinner_s
+{
+	uint32_t  vertex_count;
+	float*    positions; // 3 per vertex
+	float*    normals;   // 3 per vertex or NULL
+	uint16_t* joints;    // 4 per vertex
+	float*    weights;   // 4 per vertex
+
+	// palette size required by the joints
+	uint32_t joint_count;
+
+	uint32_t thread_count;
+} gltf_skinner_t;
+
+// vertices are skinned across thread_count threads (0 for
+// one per processor) when the primitive is large enough
+gltf_skinner_t* gltf_skinner_new(gltf_file_t* file,
+                                 gltf_primitive_t* primitive,
+                                 uint32_t thread_count);
+void            gltf_skinner_delete(gltf_skinner_t** _self);
+
+// skin the vertices by the palette (e.g. from
+// gltf_skins_getPalette) into caller provided arrays of
+// 3*vertex_count floats where normals may be NULL
+// normals are transformed by the blended matrix and
+// renormalized which assumes the joints have no shear
+int             gltf_skinner_skin(gltf_skinner_t* self,
+                                  uint32_t palette_count,
+                                  const cc_mat4f_t* palette,
+                                  float* positions,
+                                  float* normals);
+
+#endif
@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_decode.h"
+#include "gltf_skins.h"
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static float
+gltf_skins_world(const float* world, uint32_t stride,
+                 uint32_t slot, uint32_t e)
+{
+	ASSERT(world);
+
+	// joints outside of the transforms use the identity
+	if(slot == GLTF_TRANSFORMS_NONE)
+	{
+		return (e%5 == 0) ? 1.0f : 0.0f;
+	}
+
+	return world[e*stride + slot];
+}
+
+static void
+gltf_skins_mul1(gltf_skins_t* self,
+                gltf_transforms_t* transforms, uint32_t j)
+{
+	ASSERT(self);
+	ASSERT(transforms);
+
+	uint32_t     stride = transforms->stride;
+	uint32_t     slot   = self->slots[j];
+	const float* world  = transforms->world;
+	const float* ib     = &self->inverseBinds[64*(j/4) + j%4];
+	float*       m      = (float*) &self->palettes[j];
+
+	uint32_t c;
+	uint32_t r;
+	uint32_t k;
+	for(c = 0; c < 4; ++c)
+	{
+		for(r = 0; r < 4; ++r)
+		{
+			float sum = 0.0f;
+			for(k = 0; k < 4; ++k)
+			{
+				sum += gltf_skins_world(world, stride, slot,
+				                        4*k + r)*ib[4*(4*c + k)];
+			}
+			m[4*c + r] = sum;
+		}
+	}
+}
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+
+static void
+gltf_skins_mul4(gltf_skins_t* self,
+                gltf_transforms_t* transforms, uint32_t j)
+{
+	ASSERT(self);
+	ASSERT(transforms);
+
+	uint32_t        stride = transforms->stride;
+	const uint32_t* s      = &self->slots[j];
+	const float*    world  = transforms->world;
+	const float*    ib     = &self->inverseBinds[16*j];
+
+	// each lane computes the palette matrix of one joint
+	// where the world elements are gathered from the slots
+	// and the results are transposed into the palettes
+	#if defined(__SSE2__)
+	__m128 wm[16];
+	__m128 im[16];
+	#else
+	float32x4_t wm[16];
+	float32x4_t im[16];
+	#endif
+
+	uint32_t e;
+	for(e = 0; e < 16; ++e)
+	{
+		float w0 = gltf_skins_world(world, stride, s[0], e);
+		float w1 = gltf_skins_world(world, stride, s[1], e);
+		float w2 = gltf_skins_world(world, stride, s[2], e);
+		float w3 = gltf_skins_world(world, stride, s[3], e);
+		#if defined(__SSE2__)
+		wm[e] = _mm_set_ps(w3, w2, w1, w0);
+		im[e] = _mm_loadu_ps(&ib[4*e]);
+		#else
+		float t[4] = { w0, w1, w2, w3 };
+		wm[e] = vld1q_f32(t);
+		im[e] = vld1q_f32(&ib[4*e]);
+		#endif
+	}
+
+	float* m0 = (float*) &self->palettes[j];
+	float* m1 = (float*) &self->palettes[j + 1];
+	float* m2 = (float*) &self->palettes[j + 2];
+	float* m3 = (float*) &self->palettes[j + 3];
+
+	uint32_t c;
+	uint32_t r;
+	for(c = 0; c < 4; ++c)
+	{
+		#if defined(__SSE2__)
+		__m128 col[4];
+		for(r = 0; r < 4; ++r)
+		{
+			__m128 sum;
+			sum = _mm_mul_ps(wm[r], im[4*c]);
+			sum = _mm_add_ps(sum, _mm_mul_ps(wm[4 + r],  im[4*c + 1]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(wm[8 + r],  im[4*c + 2]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(wm[12 + r], im[4*c + 3]));
+			col[r] = sum;
+		}
+		_MM_TRANSPOSE4_PS(col[0], col[1], col[2], col[3]);
+		_mm_storeu_ps(&m0[4*c], col[0]);
+		_mm_storeu_ps(&m1[4*c], col[1]);
+		_mm_storeu_ps(&m2[4*c], col[2]);
+		_mm_storeu_ps(&m3[4*c], col[3]);
+		#else
+		float32x4_t col[4];
+		for(r = 0; r < 4; ++r)
+		{
+			float32x4_t sum;
+			sum = vmulq_f32(wm[r], im[4*c]);
+			sum = vmlaq_f32(sum, wm[4 + r],  im[4*c + 1]);
+			sum = vmlaq_f32(sum, wm[8 + r],  im[4*c + 2]);
+			sum = vmlaq_f32(sum, wm[12 + r], im[4*c + 3]);
+			col[r] = sum;
+		}
+		float32x4x2_t t0 = vtrnq_f32(col[0], col[1]);
+		float32x4x2_t t1 = vtrnq_f32(col[2], col[3]);
+		vst1q_f32(&m0[4*c], vcombine_f32(vget_low_f32(t0.val[0]),
+		                                 vget_low_f32(t1.val[0])));
+		vst1q_f32(&m1[4*c], vcombine_f32(vget_low_f32(t0.val[1]),
+		                                 vget_low_f32(t1.val[1])));
+		vst1q_f32(&m2[4*c], vcombine_f32(vget_high_f32(t0.val[0]),
+		                                 vget_high_f32(t1.val[0])));
+		vst1q_f32(&m3[4*c], vcombine_f32(vget_high_f32(t0.val[1]),
+		                                 vget_high_f32(t1.val[1])));
+		#endif
+	}
+}
+
+#endif
+
+static int
+gltf_skins_inverseBinds(gltf_skins_t* self,
+                        gltf_file_t* file,
+                        gltf_skin_t* skin,
+                        uint32_t offset)
+{
+	ASSERT(self);
+	ASSERT(file);
+	ASSERT(skin);
+
+	uint32_t count = skin->joint_count;
+	uint32_t j;
+	uint32_t e;
+	if(skin->has_inverseBindMatrices == 0)
+	{
+		for(j = offset; j < offset + count; ++j)
+		{
+			for(e = 0; e < 16; e += 5)
+			{
+				self->inverseBinds[64*(j/4) + 4*e + j%4] = 1.0f;
+			}
+		}
+		return 1;
+	}
+
+	gltf_accessor_t* accessor;
+	accessor = gltf_file_getAccessor(file,
+	                                 skin->inverseBindMatrices);
+	if(accessor == NULL)
+	{
+		return 0;
+	}
+
+	if((accessor->type != GLTF_ACCESSOR_TYPE_MAT4) ||
+	   (accessor->count < count))
+	{
+		LOGE("invalid type=%u, count=%u, joint_count=%u",
+		     (uint32_t) accessor->type, accessor->count, count);
+		return 0;
+	}
+
+	float* m = (float*)
+	           MALLOC(16*((size_t) accessor->count)*sizeof(float));
+	if(m == NULL)
+	{
+		LOGE("MALLOC failed");
+		return 0;
+	}
+
+	if(gltf_decode_float(file, accessor, m) == 0)
+	{
+		FREE(m);
+		return 0;
+	}
+
+	// scatter the matrices into the joint groups
+	for(j = 0; j < count; ++j)
+	{
+		uint32_t k = offset + j;
+		for(e = 0; e < 16; ++e)
+		{
+			self->inverseBinds[64*(k/4) + 4*e + k%4] = m[16*j + e];
+		}
+	}
+	FREE(m);
+
+	return 1;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_skins_t* gltf_skins_new(gltf_file_t* file)
+{
+	ASSERT(file);
+
+	gltf_skins_t* self;
+	self = (gltf_skins_t*) CALLOC(1, sizeof(gltf_skins_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->skin_count    = file->skin_count;
+	self->joint_offsets = (uint32_t*)
+	                      CALLOC(self->skin_count + 1,
+	                             sizeof(uint32_t));
+	if(self->joint_offsets == NULL)
+	{
+		LOGE("CALLOC failed");
+		goto fail_offsets;
+	}
+
+	uint32_t i;
+	for(i = 0; i < self->skin_count; ++i)
+	{
+		gltf_skin_t* skin = gltf_file_getSkin(file, i);
+		if(skin == NULL)
+		{
+			goto fail_skin;
+		}
+
+		self->joint_offsets[i] = self->joint_count;
+		self->joint_count     += skin->joint_count;
+	}
+	self->joint_offsets[self->skin_count] = self->joint_count;
+
+	// the inverse bind matrices are padded to whole groups
+	size_t count  = self->joint_count;
+	size_t groups = (count + 3)/4;
+	self->joints       = (uint32_t*)
+	                     CALLOC(count + 1, sizeof(uint32_t));
+	self->slots        = (uint32_t*)
+	                     CALLOC(count + 1, sizeof(uint32_t));
+	self->inverseBinds = (float*)
+	                     CALLOC(64*(groups + 1), sizeof(float));
+	self->palettes     = (cc_mat4f_t*)
+	                     CALLOC(count + 1, sizeof(cc_mat4f_t));
+	if((self->joints       == NULL) || (self->slots    == NULL) ||
+	   (self->inverseBinds == NULL) || (self->palettes == NULL))
+	{
+		LOGE("CALLOC failed");
+		goto fail_alloc;
+	}
+
+	for(i = 0; i < self->skin_count; ++i)
+	{
+		gltf_skin_t*    skin   = gltf_file_getSkin(file, i);
+		uint32_t        offset = self->joint_offsets[i];
+		const uint32_t* joints = gltf_file_getSkinJoints(file, skin);
+
+		uint32_t j;
+		for(j = 0; j < skin->joint_count; ++j)
+		{
+			if(joints[j] >= file->node_count)
+			{
+				LOGE("invalid joint=%u", joints[j]);
+				goto fail_joints;
+			}
+			self->joints[offset + j] = joints[j];
+		}
+
+		if(gltf_skins_inverseBinds(self, file, skin,
+		                           offset) == 0)
+		{
+			goto fail_joints;
+		}
+	}
+
+	// every node is reachable from the non-child nodes
+	gltf_transforms_t* transforms;
+	transforms = gltf_transforms_new(file, NULL);
+	if(transforms == NULL)
+	{
+		goto fail_transforms;
+	}
+
+	gltf_skins_update(self, transforms);
+	gltf_transforms_delete(&transforms);
+
+	// success
+	return self;
+
+	// failure
+	fail_transforms:
+	fail_joints:
+	fail_alloc:
+	fail_skin:
+	fail_offsets:
+		gltf_skins_delete(&self);
+	return NULL;
+}
+
+void gltf_skins_delete(gltf_skins_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_skins_t* self = *_self;
+	if(self)
+	{
+		FREE(self->palettes);
+		FREE(self->inverseBinds);
+		FREE(self->slots);
+		FREE(self->joints);
+		FREE(self->joint_offsets);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+void gltf_skins_update(gltf_skins_t* self,
+                       gltf_transforms_t* transforms)
+{
+	ASSERT(self);
+	ASSERT(transforms);
+
+	uint32_t count = self->joint_count;
+	uint32_t j;
+	for(j = 0; j < count; ++j)
+	{
+		uint32_t node = self->joints[j];
+		if(node < transforms->node_count)
+		{
+			self->slots[j] = transforms->slots[node];
+		}
+		else
+		{
+			self->slots[j] = GLTF_TRANSFORMS_NONE;
+		}
+	}
+
+	j = 0;
+	#if defined(__SSE2__) || defined(__ARM_NEON)
+	for(; j + 4 <= count; j += 4)
+	{
+		gltf_skins_mul4(self, transforms, j);
+	}
+	#endif
+
+	for(; j < count; ++j)
+	{
+		gltf_skins_mul1(self, transforms, j);
+	}
+}
+
+const cc_mat4f_t*
+gltf_skins_getPalette(gltf_skins_t* self, uint32_t skin,
+                      uint32_t* _count)
+{
+	ASSERT(self);
+	ASSERT(_count);
+
+	if(skin >= self->skin_count)
+	{
+		LOGE("invalid skin=%u", skin);
+		return NULL;
+	}
+
+	uint32_t offset = self->joint_offsets[skin];
+	*_count = self->joint_offsets[skin + 1] - offset;
+
+	return &self->palettes[offset];
+}
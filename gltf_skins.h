@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_skins_H
+#define gltf_skins_H
+
+#include "gltf.h"
+#include "gltf_transforms.h"
+
+// joint palettes of every skin in a file where the palette
+// matrix of a joint is world*inverseBind such that the
+// joints of all skins are computed in one batched pass
+// the joints of skin i are stored at palettes[joint_offsets[i]]
+// where the inverse bind matrices are stored in groups of
+// 4 joints such that element e (column-major) of joint j is
+// stored at inverseBinds[64*(j/4) + 4*e + j%4]
+typedef struct gltf_skins_s
+{
+	uint32_t  skin_count;
+	uint32_t* joint_offsets;
+
+	// joint node of each joint
+	uint32_t  joint_count;
+	uint32_t* joints;
+
+	// transforms slot of each joint for the last update
+	uint32_t* slots;
+
+	float*      inverseBinds;
+	cc_mat4f_t* palettes;
+} gltf_skins_t;
+
+gltf_skins_t*     gltf_skins_new(gltf_file_t* file);
+void              gltf_skins_delete(gltf_skins_t** _self);
+
+// compute the palettes from the world matrices of the
+// transforms (e.g. after an animation) where joints outside
+// of the transforms use the identity world matrix
+void              gltf_skins_update(gltf_skins_t* self,
+                                    gltf_transforms_t* transforms);
+const cc_mat4f_t* gltf_skins_getPalette(gltf_skins_t* self,
+                                        uint32_t skin,
+                                        uint32_t* _count);
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_strings.h"
+
+// initial hash table size (power of two)
+#define GLTF_STRINGS_SIZE 256
+
+// the empty string is shared by all pools
+static const char GLTF_STRINGS_EMPTY[] = "";
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static uint32_t gltf_strings_hash(const char* str, uint32_t len)
+{
+	ASSERT(str);
+
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	uint32_t i;
+	for(i = 0; i < len; ++i)
+	{
+		hash ^= (uint8_t) str[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static gltf_stringsEntry_t*
+gltf_strings_lookup(gltf_strings_t* self, const char* str,
+                    uint32_t len, uint32_t hash)
+{
+	ASSERT(self);
+	ASSERT(str);
+
+	// linear probing terminates since the table is never
+	// full and returns the matching or the empty entry
+	uint32_t mask = self->size - 1;
+	uint32_t idx  = hash & mask;
+	while(1)
+	{
+		gltf_stringsEntry_t* e = &self->table[idx];
+		if(e->str == NULL)
+		{
+			return e;
+		}
+		else if((e->hash == hash) && (e->len == len) &&
+		        (memcmp(e->str, str, len) == 0))
+		{
+			return e;
+		}
+
+		idx = (idx + 1) & mask;
+	}
+}
+
+static int gltf_strings_grow(gltf_strings_t* self)
+{
+	ASSERT(self);
+
+	uint32_t             size = 2*self->size;
+	gltf_stringsEntry_t* table;
+	table = (gltf_stringsEntry_t*)
+	        CALLOC(size, sizeof(gltf_stringsEntry_t));
+	if(table == NULL)
+	{
+		LOGE("CALLOC failed");
+		return 0;
+	}
+
+	gltf_stringsEntry_t* old      = self->table;
+	uint32_t             old_size = self->size;
+
+	self->table = table;
+	self->size  = size;
+
+	// rehash the existing entries
+	uint32_t i;
+	for(i = 0; i < old_size; ++i)
+	{
+		gltf_stringsEntry_t* e = &old[i];
+		if(e->str)
+		{
+			*gltf_strings_lookup(self, e->str, e->len,
+			                     e->hash) = *e;
+		}
+	}
+
+	FREE(old);
+
+	return 1;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_strings_t* gltf_strings_new(gltf_arena_t* arena)
+{
+	ASSERT(arena);
+
+	gltf_strings_t* self;
+	self = (gltf_strings_t*)
+	       CALLOC(1, sizeof(gltf_strings_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	self->table = (gltf_stringsEntry_t*)
+	              CALLOC(GLTF_STRINGS_SIZE,
+	                     sizeof(gltf_stringsEntry_t));
+	if(self->table == NULL)
+	{
+		LOGE("CALLOC failed");
+		goto fail_table;
+	}
+
+	self->arena = arena;
+	self->size  = GLTF_STRINGS_SIZE;
+
+	// success
+	return self;
+
+	// failure
+	fail_table:
+		FREE(self);
+	return NULL;
+}
+
+void gltf_strings_delete(gltf_strings_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_strings_t* self = *_self;
+	if(self)
+	{
+		FREE(self->table);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+const char*
+gltf_strings_intern(gltf_strings_t* self,
+                    const char* str, uint32_t len)
+{
+	ASSERT(self);
+	ASSERT(str);
+
+	if(len == 0)
+	{
+		return GLTF_STRINGS_EMPTY;
+	}
+
+	uint32_t             hash = gltf_strings_hash(str, len);
+	gltf_stringsEntry_t* e;
+	e = gltf_strings_lookup(self, str, len, hash);
+	if(e->str)
+	{
+		return e->str;
+	}
+
+	// maintain a load factor below 3/4
+	if(4*(self->count + 1) > 3*self->size)
+	{
+		if(gltf_strings_grow(self) == 0)
+		{
+			return NULL;
+		}
+		e = gltf_strings_lookup(self, str, len, hash);
+	}
+
+	// the arena zeroes the null terminator
+	char* copy = (char*) gltf_arena_alloc(self->arena, len + 1);
+	if(copy == NULL)
+	{
+		return NULL;
+	}
+	memcpy(copy, str, len);
+
+	e->hash = hash;
+	e->len  = len;
+	e->str  = copy;
+	++self->count;
+
+	return copy;
+}
+
+const char*
+gltf_strings_find(gltf_strings_t* self,
+                  const char* str, uint32_t len)
+{
+	ASSERT(self);
+	ASSERT(str);
+
+	if(len == 0)
+	{
+		return GLTF_STRINGS_EMPTY;
+	}
+
+	uint32_t             hash = gltf_strings_hash(str, len);
+	gltf_stringsEntry_t* e;
+	e = gltf_strings_lookup(self, str, len, hash);
+	return e->str;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_strings_H
+#define gltf_strings_H
+
+#include <inttypes.h>
+
+#include "gltf_arena.h"
+
+typedef struct gltf_stringsEntry_s
+{
+	uint32_t    hash;
+	uint32_t    len;
+	const char* str;
+} gltf_stringsEntry_t;
+
+// interned string pool where each unique string is stored
+// once (null terminated) in the arena so that strings from
+// the same pool may be compared by pointer
+typedef struct gltf_strings_s
+{
+	// arena is a reference
+	gltf_arena_t* arena;
+
+	// open addressing hash table
+	uint32_t             count;
+	uint32_t             size;
+	gltf_stringsEntry_t* table;
+} gltf_strings_t;
+
+gltf_strings_t* gltf_strings_new(gltf_arena_t* arena);
+void            gltf_strings_delete(gltf_strings_t** _self);
+const char*     gltf_strings_intern(gltf_strings_t* self,
+                                    const char* str,
+                                    uint32_t len);
+const char*     gltf_strings_find(gltf_strings_t* self,
+                                  const char* str,
+                                  uint32_t len);
+
+#endif
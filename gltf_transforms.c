@@ -0,0 +1,672 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_transforms.h"
+
+/***********************************************************
+* private                                                  *
+***********************************************************/
+
+static int
+gltf_transforms_push(gltf_transforms_t* self,
+                     uint32_t node, uint32_t parent)
+{
+	ASSERT(self);
+
+	if(node >= self->node_count)
+	{
+		LOGE("invalid node=%u", node);
+		return 0;
+	}
+
+	// glTF nodes form a forest so each node may only be
+	// visited once (which also rejects cycles)
+	if(self->slots[node] != GLTF_TRANSFORMS_NONE)
+	{
+		LOGE("invalid node=%u", node);
+		return 0;
+	}
+
+	uint32_t slot = self->count++;
+	self->nodes[slot]   = node;
+	self->parents[slot] = parent;
+	self->slots[node]   = slot;
+
+	return 1;
+}
+
+static int
+gltf_transforms_pushRoots(gltf_transforms_t* self,
+                          gltf_file_t* file,
+                          gltf_scene_t* scene)
+{
+	ASSERT(self);
+	ASSERT(file);
+
+	uint32_t i;
+	if(scene)
+	{
+		const uint32_t* roots;
+		roots = gltf_file_getSceneNodes(file, scene);
+		for(i = 0; i < scene->node_count; ++i)
+		{
+			if(gltf_transforms_push(self, roots[i],
+			                        GLTF_TRANSFORMS_NONE) == 0)
+			{
+				return 0;
+			}
+		}
+		return 1;
+	}
+
+	// mark the children to find the roots where the nodes
+	// array is used as scratch space
+	uint32_t* is_child = self->nodes;
+	memset(is_child, 0, self->node_count*sizeof(uint32_t));
+	for(i = 0; i < self->node_count; ++i)
+	{
+		gltf_node_t* node = gltf_file_getNode(file, i);
+		if(node == NULL)
+		{
+			return 0;
+		}
+
+		uint32_t        j;
+		const uint32_t* children;
+		children = gltf_file_getNodeChildren(file, node);
+		for(j = 0; j < node->child_count; ++j)
+		{
+			if(children[j] >= self->node_count)
+			{
+				LOGE("invalid child=%u", children[j]);
+				return 0;
+			}
+			is_child[children[j]] = 1;
+		}
+	}
+
+	// roots are pushed in index order so the slot is never
+	// ahead of the scratch index
+	for(i = 0; i < self->node_count; ++i)
+	{
+		if(is_child[i] == 0)
+		{
+			if(gltf_transforms_push(self, i,
+			                        GLTF_TRANSFORMS_NONE) == 0)
+			{
+				return 0;
+			}
+		}
+	}
+
+	return 1;
+}
+
+static int
+gltf_transforms_flatten(gltf_transforms_t* self,
+                        gltf_file_t* file,
+                        gltf_scene_t* scene)
+{
+	ASSERT(self);
+	ASSERT(file);
+
+	if(gltf_transforms_pushRoots(self, file, scene) == 0)
+	{
+		return 0;
+	}
+
+	// breadth first traversal where the nodes array is the
+	// queue and each level is a contiguous range of slots
+	self->levels[0] = 0;
+	uint32_t start  = 0;
+	uint32_t end    = self->count;
+	while(start < end)
+	{
+		self->levels[++self->level_count] = end;
+
+		uint32_t slot;
+		for(slot = start; slot < end; ++slot)
+		{
+			gltf_node_t* node;
+			node = gltf_file_getNode(file, self->nodes[slot]);
+			if(node == NULL)
+			{
+				return 0;
+			}
+
+			self->child_starts[slot] = self->count;
+			self->child_counts[slot] = node->child_count;
+
+			uint32_t        j;
+			const uint32_t* children;
+			children = gltf_file_getNodeChildren(file, node);
+			for(j = 0; j < node->child_count; ++j)
+			{
+				if(gltf_transforms_push(self, children[j],
+				                        slot) == 0)
+				{
+					return 0;
+				}
+			}
+		}
+
+		start = end;
+		end   = self->count;
+	}
+
+	// store the local matrices
+	uint32_t i;
+	uint32_t e;
+	for(i = 0; i < self->count; ++i)
+	{
+		gltf_node_t* node  = gltf_file_getNode(file, self->nodes[i]);
+		float*       local = (float*) &node->matrix;
+		for(e = 0; e < 16; ++e)
+		{
+			self->local[e*self->stride + i] = local[e];
+		}
+	}
+
+	return 1;
+}
+
+static void
+gltf_transforms_copy1(gltf_transforms_t* self, uint32_t i)
+{
+	ASSERT(self);
+
+	uint32_t stride = self->stride;
+	uint32_t e;
+	for(e = 0; e < 16; ++e)
+	{
+		self->world[e*stride + i] = self->local[e*stride + i];
+	}
+}
+
+static void
+gltf_transforms_mul1(gltf_transforms_t* self, uint32_t i)
+{
+	ASSERT(self);
+
+	uint32_t     stride = self->stride;
+	uint32_t     p      = self->parents[i];
+	const float* local  = self->local;
+	float*       world  = self->world;
+
+	uint32_t c;
+	uint32_t r;
+	uint32_t k;
+	for(c = 0; c < 4; ++c)
+	{
+		for(r = 0; r < 4; ++r)
+		{
+			float sum = 0.0f;
+			for(k = 0; k < 4; ++k)
+			{
+				sum += world[(4*k + r)*stride + p]*
+				       local[(4*c + k)*stride + i];
+			}
+			world[(4*c + r)*stride + i] = sum;
+		}
+	}
+}
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+
+static void
+gltf_transforms_mul4(gltf_transforms_t* self, uint32_t i)
+{
+	ASSERT(self);
+
+	uint32_t        stride = self->stride;
+	const uint32_t* p      = &self->parents[i];
+	const float*    local  = self->local;
+	float*          world  = self->world;
+
+	// each lane computes the world matrix of one slot where
+	// the parent elements are gathered unless the slots are
+	// siblings in which case they are broadcast
+	int siblings = (p[0] == p[1]) && (p[0] == p[2]) &&
+	               (p[0] == p[3]);
+
+	#if defined(__SSE2__)
+	__m128 pm[16];
+	__m128 lm[16];
+	#else
+	float32x4_t pm[16];
+	float32x4_t lm[16];
+	#endif
+
+	uint32_t e;
+	for(e = 0; e < 16; ++e)
+	{
+		const float* pw = &world[e*stride];
+		#if defined(__SSE2__)
+		if(siblings)
+		{
+			pm[e] = _mm_set1_ps(pw[p[0]]);
+		}
+		else
+		{
+			pm[e] = _mm_set_ps(pw[p[3]], pw[p[2]],
+			                   pw[p[1]], pw[p[0]]);
+		}
+		lm[e] = _mm_loadu_ps(&local[e*stride + i]);
+		#else
+		if(siblings)
+		{
+			pm[e] = vdupq_n_f32(pw[p[0]]);
+		}
+		else
+		{
+			float t[4] = { pw[p[0]], pw[p[1]], pw[p[2]], pw[p[3]] };
+			pm[e] = vld1q_f32(t);
+		}
+		lm[e] = vld1q_f32(&local[e*stride + i]);
+		#endif
+	}
+
+	uint32_t c;
+	uint32_t r;
+	for(c = 0; c < 4; ++c)
+	{
+		for(r = 0; r < 4; ++r)
+		{
+			#if defined(__SSE2__)
+			__m128 sum;
+			sum = _mm_mul_ps(pm[r], lm[4*c]);
+			sum = _mm_add_ps(sum, _mm_mul_ps(pm[4 + r],  lm[4*c + 1]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(pm[8 + r],  lm[4*c + 2]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(pm[12 + r], lm[4*c + 3]));
+			_mm_storeu_ps(&world[(4*c + r)*stride + i], sum);
+			#else
+			float32x4_t sum;
+			sum = vmulq_f32(pm[r], lm[4*c]);
+			sum = vmlaq_f32(sum, pm[4 + r],  lm[4*c + 1]);
+			sum = vmlaq_f32(sum, pm[8 + r],  lm[4*c + 2]);
+			sum = vmlaq_f32(sum, pm[12 + r], lm[4*c + 3]);
+			vst1q_f32(&world[(4*c + r)*stride + i], sum);
+			#endif
+		}
+	}
+}
+
+#endif
+
+static void
+gltf_transforms_mulRange(gltf_transforms_t* self,
+                         uint32_t i, uint32_t end)
+{
+	ASSERT(self);
+
+	#if defined(__SSE2__) || defined(__ARM_NEON)
+	for(; i + 4 <= end; i += 4)
+	{
+		gltf_transforms_mul4(self, i);
+	}
+	#endif
+
+	for(; i < end; ++i)
+	{
+		gltf_transforms_mul1(self, i);
+	}
+}
+
+static int gltf_transforms_compare(const void* a, const void* b)
+{
+	ASSERT(a);
+	ASSERT(b);
+
+	uint32_t sa = *((const uint32_t*) a);
+	uint32_t sb = *((const uint32_t*) b);
+	if(sa < sb)
+	{
+		return -1;
+	}
+	else if(sa > sb)
+	{
+		return 1;
+	}
+	return 0;
+}
+
+static void
+gltf_transforms_updateDirty(gltf_transforms_t* self)
+{
+	ASSERT(self);
+
+	// parents precede their children in level order so
+	// sorting ensures that a dirty slot is reached by the
+	// subtree of a dirty ancestor before it is processed
+	qsort(self->dirty_slots, self->dirty_count,
+	      sizeof(uint32_t), gltf_transforms_compare);
+
+	uint32_t  d;
+	uint32_t* queue = self->queue;
+	for(d = 0; d < self->dirty_count; ++d)
+	{
+		uint32_t slot = self->dirty_slots[d];
+		if(self->dirty[slot] == 0)
+		{
+			continue;
+		}
+
+		if(self->parents[slot] == GLTF_TRANSFORMS_NONE)
+		{
+			gltf_transforms_copy1(self, slot);
+		}
+		else
+		{
+			gltf_transforms_mul1(self, slot);
+		}
+		self->dirty[slot] = 0;
+
+		// traverse the subtree by child ranges where the
+		// children of adjacent slots are merged into a
+		// single range for the SIMD path
+		uint32_t head = 0;
+		uint32_t tail = 0;
+		if(self->child_counts[slot])
+		{
+			queue[tail++] = self->child_starts[slot];
+			queue[tail++] = self->child_starts[slot] +
+			                self->child_counts[slot];
+		}
+
+		while(head < tail)
+		{
+			uint32_t i   = queue[head++];
+			uint32_t end = queue[head++];
+			gltf_transforms_mulRange(self, i, end);
+
+			for(; i < end; ++i)
+			{
+				self->dirty[i] = 0;
+
+				uint32_t count = self->child_counts[i];
+				if(count == 0)
+				{
+					continue;
+				}
+
+				uint32_t start = self->child_starts[i];
+				if((tail > head) && (queue[tail - 1] == start))
+				{
+					queue[tail - 1] += count;
+				}
+				else
+				{
+					queue[tail++] = start;
+					queue[tail++] = start + count;
+				}
+			}
+		}
+	}
+
+	self->dirty_count = 0;
+}
+
+static int
+gltf_transforms_markDirty(gltf_transforms_t* self,
+                          uint32_t node, uint32_t* _slot)
+{
+	ASSERT(self);
+	ASSERT(_slot);
+
+	if((node >= self->node_count) ||
+	   (self->slots[node] == GLTF_TRANSFORMS_NONE))
+	{
+		LOGE("invalid node=%u", node);
+		return 0;
+	}
+
+	uint32_t slot = self->slots[node];
+	if(self->dirty[slot] == 0)
+	{
+		self->dirty[slot] = 1;
+		self->dirty_slots[self->dirty_count++] = slot;
+	}
+
+	*_slot = slot;
+	return 1;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_transforms_t*
+gltf_transforms_new(gltf_file_t* file, gltf_scene_t* scene)
+{
+	ASSERT(file);
+
+	gltf_transforms_t* self;
+	self = (gltf_transforms_t*)
+	       CALLOC(1, sizeof(gltf_transforms_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	// the count is bounded by the node count and the stride
+	// is padded so the SIMD path may load 4 slots at once
+	uint32_t n = file->node_count;
+	self->node_count = n;
+	self->stride     = (n + 3) & ~3u;
+
+	self->levels  = (uint32_t*) CALLOC(n + 1, sizeof(uint32_t));
+	self->nodes   = (uint32_t*) CALLOC(n + 1, sizeof(uint32_t));
+	self->parents = (uint32_t*) CALLOC(n + 1, sizeof(uint32_t));
+	self->slots   = (uint32_t*) CALLOC(n + 1, sizeof(uint32_t));
+	self->local   = (float*)
+	                CALLOC(16*self->stride + 1, sizeof(float));
+	self->world   = (float*)
+	                CALLOC(16*self->stride + 1, sizeof(float));
+	self->child_starts = (uint32_t*) CALLOC(n + 1, sizeof(uint32_t));
+	self->child_counts = (uint32_t*) CALLOC(n + 1, sizeof(uint32_t));
+	self->dirty_slots  = (uint32_t*) CALLOC(n + 1, sizeof(uint32_t));
+	self->dirty        = (uint8_t*)  CALLOC(n + 1, sizeof(uint8_t));
+	self->queue        = (uint32_t*) CALLOC(2*n + 2, sizeof(uint32_t));
+	if((self->levels  == NULL) || (self->nodes == NULL) ||
+	   (self->parents == NULL) || (self->slots == NULL) ||
+	   (self->local   == NULL) || (self->world == NULL) ||
+	   (self->child_starts == NULL) ||
+	   (self->child_counts == NULL) ||
+	   (self->dirty_slots  == NULL) ||
+	   (self->dirty        == NULL) ||
+	   (self->queue        == NULL))
+	{
+		LOGE("CALLOC failed");
+		goto fail_alloc;
+	}
+	memset(self->slots, 0xFF, (n + 1)*sizeof(uint32_t));
+
+	if(gltf_transforms_flatten(self, file, scene) == 0)
+	{
+		goto fail_flatten;
+	}
+
+	gltf_transforms_updateAll(self);
+
+	// success
+	return self;
+
+	// failure
+	fail_flatten:
+	fail_alloc:
+		gltf_transforms_delete(&self);
+	return NULL;
+}
+
+void gltf_transforms_delete(gltf_transforms_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_transforms_t* self = *_self;
+	if(self)
+	{
+		FREE(self->queue);
+		FREE(self->dirty);
+		FREE(self->dirty_slots);
+		FREE(self->child_counts);
+		FREE(self->child_starts);
+		FREE(self->world);
+		FREE(self->local);
+		FREE(self->slots);
+		FREE(self->parents);
+		FREE(self->nodes);
+		FREE(self->levels);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+int gltf_transforms_setLocal(gltf_transforms_t* self,
+                             uint32_t node,
+                             const cc_mat4f_t* local)
+{
+	ASSERT(self);
+	ASSERT(local);
+
+	uint32_t slot;
+	if(gltf_transforms_markDirty(self, node, &slot) == 0)
+	{
+		return 0;
+	}
+
+	const float* m = (const float*) local;
+	uint32_t     e;
+	for(e = 0; e < 16; ++e)
+	{
+		self->local[e*self->stride + slot] = m[e];
+	}
+
+	return 1;
+}
+
+int gltf_transforms_setTRS(gltf_transforms_t* self,
+                           uint32_t node,
+                           const cc_vec3f_t* t,
+                           const cc_vec4f_t* r,
+                           const cc_vec3f_t* s)
+{
+	ASSERT(self);
+	ASSERT(t);
+	ASSERT(r);
+	ASSERT(s);
+
+	cc_mat4f_t local;
+	gltf_mat4f_composeTRS(&local, t, r, s);
+	return gltf_transforms_setLocal(self, node, &local);
+}
+
+void gltf_transforms_update(gltf_transforms_t* self)
+{
+	ASSERT(self);
+
+	if(self->dirty_count == 0)
+	{
+		return;
+	}
+
+	// the size of the dirty subtrees is unknown so fall back
+	// to the full update once a fraction of slots are dirty
+	if(self->dirty_count > self->count/8)
+	{
+		gltf_transforms_updateAll(self);
+	}
+	else
+	{
+		gltf_transforms_updateDirty(self);
+	}
+}
+
+void gltf_transforms_updateAll(gltf_transforms_t* self)
+{
+	ASSERT(self);
+
+	memset(self->dirty, 0, self->count*sizeof(uint8_t));
+	self->dirty_count = 0;
+
+	if(self->level_count == 0)
+	{
+		return;
+	}
+
+	// the world matrix of the roots is the local matrix
+	uint32_t stride = self->stride;
+	uint32_t roots  = self->levels[1];
+	uint32_t e;
+	for(e = 0; e < 16; ++e)
+	{
+		memcpy(&self->world[e*stride], &self->local[e*stride],
+		       roots*sizeof(float));
+	}
+
+	// the parents of each level are complete before the
+	// level is processed
+	uint32_t l;
+	for(l = 1; l < self->level_count; ++l)
+	{
+		gltf_transforms_mulRange(self, self->levels[l],
+		                         self->levels[l + 1]);
+	}
+}
+
+int gltf_transforms_getWorld(gltf_transforms_t* self,
+                             uint32_t node,
+                             cc_mat4f_t* world)
+{
+	ASSERT(self);
+	ASSERT(world);
+
+	if((node >= self->node_count) ||
+	   (self->slots[node] == GLTF_TRANSFORMS_NONE))
+	{
+		LOGE("invalid node=%u", node);
+		return 0;
+	}
+
+	uint32_t slot = self->slots[node];
+	float*   m    = (float*) world;
+	uint32_t e;
+	for(e = 0; e < 16; ++e)
+	{
+		m[e] = self->world[e*self->stride + slot];
+	}
+
+	return 1;
+}
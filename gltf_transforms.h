@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_transforms_H
+#define gltf_transforms_H
+
+#include "gltf.h"
+
+#define GLTF_TRANSFORMS_NONE 0xFFFFFFFF
+
+// the nodes of a scene flattened parent-first in level
+// order where the local and world matrices are stored as
+// structure-of-arrays such that element e (column-major)
+// of slot i is stored at local[e*stride + i]
+typedef struct gltf_transforms_s
+{
+	uint32_t count;
+	uint32_t stride;
+
+	// slot ranges of each level (level_count + 1 offsets)
+	uint32_t  level_count;
+	uint32_t* levels;
+
+	// node index and parent slot of each slot where roots
+	// have the parent GLTF_TRANSFORMS_NONE
+	uint32_t* nodes;
+	uint32_t* parents;
+
+	// slot of each node in the file where nodes outside of
+	// the scene have the slot GLTF_TRANSFORMS_NONE
+	uint32_t  node_count;
+	uint32_t* slots;
+
+	// the children of each slot are a contiguous range of
+	// slots in the following level
+	uint32_t* child_starts;
+	uint32_t* child_counts;
+
+	// slots whose local matrix changed since the last update
+	// where the dirty flags are also cleared for the subtree
+	// slots as they are recomputed
+	uint32_t  dirty_count;
+	uint32_t* dirty_slots;
+	uint8_t*  dirty;
+
+	// queue of slot ranges for incremental updates
+	uint32_t* queue;
+
+	float* local;
+	float* world;
+} gltf_transforms_t;
+
+// scene may be NULL to flatten every node which is not
+// the child of another node
+gltf_transforms_t* gltf_transforms_new(gltf_file_t* file,
+                                       gltf_scene_t* scene);
+void               gltf_transforms_delete(gltf_transforms_t** _self);
+
+// setting the local matrix of a node marks it dirty such
+// that gltf_transforms_update only recomputes the world
+// matrices of the dirty subtrees (the full update is used
+// when many slots are dirty)
+int                gltf_transforms_setLocal(gltf_transforms_t* self,
+                                            uint32_t node,
+                                            const cc_mat4f_t* local);
+int                gltf_transforms_setTRS(gltf_transforms_t* self,
+                                          uint32_t node,
+                                          const cc_vec3f_t* t,
+                                          const cc_vec4f_t* r,
+                                          const cc_vec3f_t* s);
+void               gltf_transforms_update(gltf_transforms_t* self);
+void               gltf_transforms_updateAll(gltf_transforms_t* self);
+int                gltf_transforms_getWorld(gltf_transforms_t* self,
+                                            uint32_t node,
+                                            cc_mat4f_t* world);
+
+#endif
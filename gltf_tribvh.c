@@ -0,0 +1,596 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_TAG "gltf"
+#include "../libcc/cc_log.h"
+#include "../libcc/cc_memory.h"
+#include "gltf_decode.h"
+#include "gltf_tribvh.h"
+
+/***********************************************************
+* private - build                                          *
+***********************************************************/
+
+static uint32_t
+gltf_tribvh_triangleCount(gltf_primitiveMode_e mode,
+                          uint32_t count)
+{
+	if(mode == GLTF_PRIMITIVE_MODE_TRIANGLES)
+	{
+		return count/3;
+	}
+	else if((mode == GLTF_PRIMITIVE_MODE_TRIANGLE_STRIP) ||
+	        (mode == GLTF_PRIMITIVE_MODE_TRIANGLE_FAN))
+	{
+		return (count >= 3) ? count - 2 : 0;
+	}
+
+	// points and lines
+	return 0;
+}
+
+static int
+gltf_tribvh_primitive(gltf_tribvh_t* self,
+                      gltf_file_t* file,
+                      gltf_primitive_t* primitive,
+                      uint32_t primitive_idx)
+{
+	ASSERT(self);
+	ASSERT(file);
+	ASSERT(primitive);
+
+	gltf_attribute_t* attribute;
+	attribute = gltf_primitive_getAttribute(primitive,
+	                                        GLTF_ATTRIBUTE_TYPE_POSITION,
+	                                        0);
+	if(attribute == NULL)
+	{
+		return 1;
+	}
+
+	gltf_accessor_t* accessor;
+	accessor = gltf_file_getAccessor(file, attribute->accessor);
+	if(accessor == NULL)
+	{
+		return 0;
+	}
+
+	if(accessor->type != GLTF_ACCESSOR_TYPE_VEC3)
+	{
+		LOGE("invalid type=%u", (uint32_t) accessor->type);
+		return 0;
+	}
+
+	uint32_t base = self->vertex_count;
+	if(gltf_decode_float(file, accessor,
+	                     &self->positions[3*base]) == 0)
+	{
+		return 0;
+	}
+	self->vertex_count += accessor->count;
+
+	// decode the indices or generate the implicit indices
+	uint32_t  count = accessor->count;
+	uint32_t* idx   = NULL;
+	if(primitive->has_indices)
+	{
+		gltf_accessor_t* ia;
+		ia = gltf_file_getAccessor(file, primitive->indices);
+		if(ia == NULL)
+		{
+			return 0;
+		}
+
+		count = ia->count;
+		idx   = (uint32_t*) MALLOC((count + 1)*sizeof(uint32_t));
+		if(idx == NULL)
+		{
+			LOGE("MALLOC failed");
+			return 0;
+		}
+
+		uint32_t min = 0;
+		uint32_t max = 0;
+		if(gltf_decode_indices32(file, ia, idx, &min, &max) == 0)
+		{
+			goto fail_indices;
+		}
+
+		if(count && (max >= accessor->count))
+		{
+			LOGE("invalid max=%u, count=%u", max, accessor->count);
+			goto fail_indices;
+		}
+	}
+
+	uint32_t n = gltf_tribvh_triangleCount(primitive->mode, count);
+	uint32_t i;
+	for(i = 0; i < n; ++i)
+	{
+		uint32_t v[3];
+		if(primitive->mode == GLTF_PRIMITIVE_MODE_TRIANGLES)
+		{
+			v[0] = 3*i;
+			v[1] = 3*i + 1;
+			v[2] = 3*i + 2;
+		}
+		else if(primitive->mode == GLTF_PRIMITIVE_MODE_TRIANGLE_STRIP)
+		{
+			// odd triangles are flipped to keep the winding
+			v[0] = i + (i & 1);
+			v[1] = i + 1 - (i & 1);
+			v[2] = i + 2;
+		}
+		else
+		{
+			v[0] = 0;
+			v[1] = i + 1;
+			v[2] = i + 2;
+		}
+
+		uint32_t  t   = self->triangle_count++;
+		uint32_t* dst = &self->indices[3*t];
+		uint32_t  k;
+		for(k = 0; k < 3; ++k)
+		{
+			dst[k] = base + (idx ? idx[v[k]] : v[k]);
+		}
+		self->primitives[t] = primitive_idx;
+		self->triangles[t]  = i;
+	}
+
+	FREE(idx);
+
+	// success
+	return 1;
+
+	// failure
+	fail_indices:
+		FREE(idx);
+	return 0;
+}
+
+static int gltf_tribvh_reorder(gltf_tribvh_t* self)
+{
+	ASSERT(self);
+
+	// store the triangles in the order of the bvh leaves
+	// so the leaves reference contiguous triangles
+	uint32_t  n          = self->triangle_count;
+	uint32_t* indices    = (uint32_t*)
+	                       CALLOC(3*n + 1, sizeof(uint32_t));
+	uint32_t* primitives = (uint32_t*)
+	                       CALLOC(n + 1, sizeof(uint32_t));
+	uint32_t* triangles  = (uint32_t*)
+	                       CALLOC(n + 1, sizeof(uint32_t));
+	if((indices == NULL) || (primitives == NULL) ||
+	   (triangles == NULL))
+	{
+		LOGE("CALLOC failed");
+		FREE(triangles);
+		FREE(primitives);
+		FREE(indices);
+		return 0;
+	}
+
+	uint32_t i;
+	for(i = 0; i < n; ++i)
+	{
+		uint32_t t = self->bvh->items[i];
+		indices[3*i]     = self->indices[3*t];
+		indices[3*i + 1] = self->indices[3*t + 1];
+		indices[3*i + 2] = self->indices[3*t + 2];
+		primitives[i]    = self->primitives[t];
+		triangles[i]     = self->triangles[t];
+		self->bvh->items[i] = i;
+	}
+
+	FREE(self->triangles);
+	FREE(self->primitives);
+	FREE(self->indices);
+	self->indices    = indices;
+	self->primitives = primitives;
+	self->triangles  = triangles;
+
+	return 1;
+}
+
+/***********************************************************
+* private - query                                          *
+***********************************************************/
+
+static int
+gltf_tribvh_triangle(gltf_tribvh_t* self, uint32_t tri,
+                     const float* o, const float* d,
+                     gltf_tribvhHit_t* hit)
+{
+	ASSERT(self);
+	ASSERT(o);
+	ASSERT(d);
+	ASSERT(hit);
+
+	// Moller-Trumbore for double sided triangles
+	const uint32_t* idx = &self->indices[3*tri];
+	const float*    p0  = &self->positions[3*idx[0]];
+	const float*    p1  = &self->positions[3*idx[1]];
+	const float*    p2  = &self->positions[3*idx[2]];
+
+	float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+	float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+	float pv[3] =
+	{
+		d[1]*e2[2] - d[2]*e2[1],
+		d[2]*e2[0] - d[0]*e2[2],
+		d[0]*e2[1] - d[1]*e2[0],
+	};
+
+	float det = e1[0]*pv[0] + e1[1]*pv[1] + e1[2]*pv[2];
+	if(fabsf(det) < FLT_MIN)
+	{
+		return 0;
+	}
+
+	float inv   = 1.0f/det;
+	float tv[3] = { o[0] - p0[0], o[1] - p0[1], o[2] - p0[2] };
+	float u     = (tv[0]*pv[0] + tv[1]*pv[1] + tv[2]*pv[2])*inv;
+	if((u < 0.0f) || (u > 1.0f))
+	{
+		return 0;
+	}
+
+	float qv[3] =
+	{
+		tv[1]*e1[2] - tv[2]*e1[1],
+		tv[2]*e1[0] - tv[0]*e1[2],
+		tv[0]*e1[1] - tv[1]*e1[0],
+	};
+
+	float v = (d[0]*qv[0] + d[1]*qv[1] + d[2]*qv[2])*inv;
+	if((v < 0.0f) || (u + v > 1.0f))
+	{
+		return 0;
+	}
+
+	float t = (e2[0]*qv[0] + e2[1]*qv[1] + e2[2]*qv[2])*inv;
+	if((t < 0.0f) || (t > hit->t))
+	{
+		return 0;
+	}
+
+	hit->primitive = self->primitives[tri];
+	hit->triangle  = self->triangles[tri];
+	hit->t         = t;
+	hit->u         = u;
+	hit->v         = v;
+	return 1;
+}
+
+static int
+gltf_tribvh_intersect(gltf_tribvh_t* self,
+                      const cc_vec3f_t* origin,
+                      const cc_vec3f_t* dir,
+                      float tmax, gltf_tribvhHit_t* hit)
+{
+	ASSERT(self);
+	ASSERT(origin);
+	ASSERT(dir);
+	ASSERT(hit);
+
+	hit->primitive = GLTF_TRIBVH_NONE;
+	hit->triangle  = GLTF_TRIBVH_NONE;
+	hit->t         = tmax;
+	hit->u         = 0.0f;
+	hit->v         = 0.0f;
+
+	gltf_bvh_t* bvh = self->bvh;
+	if(bvh->node_count == 0)
+	{
+		return 0;
+	}
+
+	const float* o      = (const float*) origin;
+	const float* d      = (const float*) dir;
+	float        inv[3] = { 1.0f/d[0], 1.0f/d[1], 1.0f/d[2] };
+
+	// closest hit traversal which visits the nearer child
+	// first and skips nodes beyond the current hit
+	float    t;
+	uint32_t stack[GLTF_BVH_MAX_DEPTH + 1];
+	float    stack_t[GLTF_BVH_MAX_DEPTH + 1];
+	uint32_t depth = 0;
+	if(gltf_bvhBox_intersectRay(&bvh->nodes[0].box, o, inv,
+	                            hit->t, &t) == 0)
+	{
+		return 0;
+	}
+	stack[depth]     = 0;
+	stack_t[depth++] = t;
+
+	int found = 0;
+	while(depth)
+	{
+		--depth;
+		if(stack_t[depth] > hit->t)
+		{
+			continue;
+		}
+
+		gltf_bvhNode_t* node = &bvh->nodes[stack[depth]];
+		if(node->count)
+		{
+			uint32_t i;
+			for(i = node->offset; i < node->offset + node->count; ++i)
+			{
+				found |= gltf_tribvh_triangle(self, i, o, d, hit);
+			}
+			continue;
+		}
+
+		uint32_t a = stack[depth] + 1;
+		uint32_t b = node->offset;
+		float    ta;
+		float    tb;
+		int      ha;
+		int      hb;
+		ha = gltf_bvhBox_intersectRay(&bvh->nodes[a].box, o, inv,
+		                              hit->t, &ta);
+		hb = gltf_bvhBox_intersectRay(&bvh->nodes[b].box, o, inv,
+		                              hit->t, &tb);
+		if(ha && hb)
+		{
+			// push the far child first
+			if(ta > tb)
+			{
+				stack[depth]     = a;
+				stack_t[depth++] = ta;
+				stack[depth]     = b;
+				stack_t[depth++] = tb;
+			}
+			else
+			{
+				stack[depth]     = b;
+				stack_t[depth++] = tb;
+				stack[depth]     = a;
+				stack_t[depth++] = ta;
+			}
+		}
+		else if(ha)
+		{
+			stack[depth]     = a;
+			stack_t[depth++] = ta;
+		}
+		else if(hb)
+		{
+			stack[depth]     = b;
+			stack_t[depth++] = tb;
+		}
+	}
+
+	return found;
+}
+
+/***********************************************************
+* public                                                   *
+***********************************************************/
+
+gltf_tribvh_t*
+gltf_tribvh_new(gltf_file_t* file, gltf_mesh_t* mesh,
+                uint32_t thread_count)
+{
+	ASSERT(file);
+	ASSERT(mesh);
+
+	gltf_tribvh_t* self;
+	self = (gltf_tribvh_t*) CALLOC(1, sizeof(gltf_tribvh_t));
+	if(self == NULL)
+	{
+		LOGE("CALLOC failed");
+		return NULL;
+	}
+
+	// count the vertices and triangles
+	uint32_t i;
+	uint32_t vertex_count   = 0;
+	uint32_t triangle_count = 0;
+	for(i = 0; i < mesh->primitive_count; ++i)
+	{
+		gltf_primitive_t* primitive = &mesh->primitives[i];
+
+		gltf_attribute_t* attribute;
+		attribute = gltf_primitive_getAttribute(primitive,
+		                                        GLTF_ATTRIBUTE_TYPE_POSITION,
+		                                        0);
+		if(attribute == NULL)
+		{
+			continue;
+		}
+
+		gltf_accessor_t* accessor;
+		accessor = gltf_file_getAccessor(file, attribute->accessor);
+		if(accessor == NULL)
+		{
+			goto fail_count;
+		}
+
+		uint32_t count = accessor->count;
+		if(primitive->has_indices)
+		{
+			gltf_accessor_t* ia;
+			ia = gltf_file_getAccessor(file, primitive->indices);
+			if(ia == NULL)
+			{
+				goto fail_count;
+			}
+			count = ia->count;
+		}
+
+		vertex_count   += accessor->count;
+		triangle_count += gltf_tribvh_triangleCount(primitive->mode,
+		                                            count);
+	}
+
+	self->positions  = (float*)
+	                   CALLOC(3*vertex_count + 1, sizeof(float));
+	self->indices    = (uint32_t*)
+	                   CALLOC(3*triangle_count + 1, sizeof(uint32_t));
+	self->primitives = (uint32_t*)
+	                   CALLOC(triangle_count + 1, sizeof(uint32_t));
+	self->triangles  = (uint32_t*)
+	                   CALLOC(triangle_count + 1, sizeof(uint32_t));
+	if((self->positions  == NULL) || (self->indices   == NULL) ||
+	   (self->primitives == NULL) || (self->triangles == NULL))
+	{
+		LOGE("CALLOC failed");
+		goto fail_alloc;
+	}
+
+	for(i = 0; i < mesh->primitive_count; ++i)
+	{
+		if(gltf_tribvh_primitive(self, file, &mesh->primitives[i],
+		                         i) == 0)
+		{
+			goto fail_primitive;
+		}
+	}
+
+	gltf_bvhBox_t* boxes;
+	boxes = (gltf_bvhBox_t*)
+	        CALLOC(self->triangle_count + 1, sizeof(gltf_bvhBox_t));
+	if(boxes == NULL)
+	{
+		LOGE("CALLOC failed");
+		goto fail_boxes;
+	}
+
+	for(i = 0; i < self->triangle_count; ++i)
+	{
+		const uint32_t* idx = &self->indices[3*i];
+		const float*    p0  = &self->positions[3*idx[0]];
+		const float*    p1  = &self->positions[3*idx[1]];
+		const float*    p2  = &self->positions[3*idx[2]];
+		float*          mn  = (float*) &boxes[i].min;
+		float*          mx  = (float*) &boxes[i].max;
+
+		uint32_t k;
+		for(k = 0; k < 3; ++k)
+		{
+			mn[k] = fminf(p0[k], fminf(p1[k], p2[k]));
+			mx[k] = fmaxf(p0[k], fmaxf(p1[k], p2[k]));
+		}
+	}
+
+	self->bvh = gltf_bvh_newBoxes(self->triangle_count, boxes,
+	                              thread_count);
+	FREE(boxes);
+	if(self->bvh == NULL)
+	{
+		goto fail_bvh;
+	}
+
+	if(gltf_tribvh_reorder(self) == 0)
+	{
+		goto fail_reorder;
+	}
+
+	// success
+	return self;
+
+	// failure
+	fail_reorder:
+	fail_bvh:
+	fail_boxes:
+	fail_primitive:
+	fail_alloc:
+	fail_count:
+		gltf_tribvh_delete(&self);
+	return NULL;
+}
+
+void gltf_tribvh_delete(gltf_tribvh_t** _self)
+{
+	ASSERT(_self);
+
+	gltf_tribvh_t* self = *_self;
+	if(self)
+	{
+		gltf_bvh_delete(&self->bvh);
+		FREE(self->triangles);
+		FREE(self->primitives);
+		FREE(self->indices);
+		FREE(self->positions);
+		FREE(self);
+		*_self = NULL;
+	}
+}
+
+uint32_t gltf_tribvh_raycast(gltf_tribvh_t* self,
+                             uint32_t count,
+                             const gltf_tribvhRay_t* rays,
+                             gltf_tribvhHit_t* hits)
+{
+	ASSERT(self);
+	ASSERT(rays);
+	ASSERT(hits);
+
+	uint32_t i;
+	uint32_t n = 0;
+	for(i = 0; i < count; ++i)
+	{
+		const gltf_tribvhRay_t* ray = &rays[i];
+		n += gltf_tribvh_intersect(self, &ray->origin, &ray->dir,
+		                           ray->tmax, &hits[i]);
+	}
+
+	return n;
+}
+
+uint32_t gltf_tribvh_segments(gltf_tribvh_t* self,
+                              uint32_t count,
+                              const gltf_tribvhSegment_t* segments,
+                              gltf_tribvhHit_t* hits)
+{
+	ASSERT(self);
+	ASSERT(segments);
+	ASSERT(hits);
+
+	uint32_t i;
+	uint32_t n = 0;
+	for(i = 0; i < count; ++i)
+	{
+		const gltf_tribvhSegment_t* seg = &segments[i];
+
+		cc_vec3f_t dir;
+		cc_vec3f_load(&dir, seg->p1.x - seg->p0.x,
+		              seg->p1.y - seg->p0.y,
+		              seg->p1.z - seg->p0.z);
+		n += gltf_tribvh_intersect(self, &seg->p0, &dir, 1.0f,
+		                           &hits[i]);
+	}
+
+	return n;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2022 Jeff Boody
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef gltf_tribvh_H
+#define gltf_tribvh_H
+
+#include "gltf.h"
+#include "gltf_bvh.h"
+
+#define GLTF_TRIBVH_NONE 0xFFFFFFFF
+
+typedef struct gltf_tribvhRay_s
+{
+	cc_vec3f_t origin;
+	cc_vec3f_t dir;
+	float      tmax;
+} gltf_tribvhRay_t;
+
+typedef struct gltf_tribvhSegment_s
+{
+	cc_vec3f_t p0;
+	cc_vec3f_t p1;
+} gltf_tribvhSegment_t;
+
+// the closest hit where t is the distance along the ray in
+// units of dir (or the fraction along the segment) and u,v
+// are the barycentric coordinates of the 2nd/3rd vertex
+// misses have the primitive/triangle GLTF_TRIBVH_NONE
+typedef struct gltf_tribvhHit_s
+{
+	uint32_t primitive;
+	uint32_t triangle;
+	float    t;
+	float    u;
+	float    v;
+} gltf_tribvhHit_t;
+
+// triangle hierarchy over the triangle, strip and fan
+// primitives of a mesh in mesh local space where the
+// triangles are stored in the order of the bvh leaves
+// and reference the decoded positions of every primitive
+typedef struct gltf_tribvh_s
+{
+	uint32_t vertex_count;
+	float*   positions;
+
+	// vertex indices (3 per triangle), the index of the
+	// mesh primitive and the triangle index within the
+	// primitive of each triangle
+	uint32_t  triangle_count;
+	uint32_t* indices;
+	uint32_t* primitives;
+	uint32_t* triangles;
+
+	gltf_bvh_t* bvh;
+} gltf_tribvh_t;
+
+// the hierarchy is built across thread_count threads (0
+// for one per processor)
+gltf_tribvh_t* gltf_tribvh_new(gltf_file_t* file,
+                               gltf_mesh_t* mesh,
+                               uint32_t thread_count);
+void           gltf_tribvh_delete(gltf_tribvh_t** _self);
+
+// find the closest hit of each ray/segment where the
+// number of hits is returned
+uint32_t       gltf_tribvh_raycast(gltf_tribvh_t* self,
+                                   uint32_t count,
+                                   const gltf_tribvhRay_t* rays,
+                                   gltf_tribvhHit_t* hits);
+uint32_t       gltf_tribvh_segments(gltf_tribvh_t* self,
+                                    uint32_t count,
+                                    const gltf_tribvhSegment_t* segments,
+                                    gltf_tribvhHit_t* hits);
+
+#endif